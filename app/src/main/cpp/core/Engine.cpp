@@ -9,12 +9,44 @@
 
 namespace videoeditor {
 
+namespace {
+constexpr const char *kDefaultTrackId = "default_track";
+// Clips starting this far ahead of the playhead get frames decoded before
+// the cut reaches them.
+constexpr long kPrefetchMs = 1000;
+// Longest the decode thread waits on one decoder before serving the next.
+constexpr int64_t kDecodeWaitUs = 4000;
+// Idle poll when no decoder has work and no wake-up arrives.
+constexpr auto kDecodeIdle = std::chrono::milliseconds(10);
+
+// Opening a codec can take tens of milliseconds, so callers do it without
+// holding clipsMutex_. Null if the file cannot be decoded; such clips keep
+// their place on the timeline and draw without a picture.
+std::shared_ptr<cineforge::media::FramePrefetcher>
+openFrames(const std::string &path) {
+  auto decoder = createDecoder(path);
+  if (!decoder->open()) {
+    LOGE("Failed to open decoder for %s", path.c_str());
+    return nullptr;
+  }
+  return std::make_shared<cineforge::media::FramePrefetcher>(
+      std::move(decoder));
+}
+} // namespace
+
 Engine &Engine::getInstance() {
   static Engine instance;
   return instance;
 }
 
-Engine::Engine() : initialized_(false), window_(nullptr), isRunning_(false) {}
+Engine::Engine() : initialized_(false), window_(nullptr), isRunning_(false) {
+  defaultTrackId_ = cineforge::intern(kDefaultTrackId);
+
+  cineforge::timeline::Track track;
+  track.id = defaultTrackId_;
+  track.type = cineforge::timeline::TrackType::Video;
+  timeline_.addTrack(track);
+}
 
 Engine::~Engine() { shutdown(); }
 
@@ -25,6 +57,7 @@ void Engine::initialize() {
   LOGI("Initializing Engine");
   isRunning_ = true;
   renderThread_ = std::thread(&Engine::renderLoop, this);
+  decodeThread_ = std::thread(&Engine::decodeLoop, this);
 
   initialized_ = true;
 }
@@ -35,9 +68,13 @@ void Engine::shutdown() {
 
   LOGI("Shutting down Engine");
   isRunning_ = false;
+  decodeWake_.notify_all();
   if (renderThread_.joinable()) {
     renderThread_.join();
   }
+  if (decodeThread_.joinable()) {
+    decodeThread_.join();
+  }
 
   initialized_ = false;
 }
@@ -64,6 +101,8 @@ void Engine::setPlayheadMs(long timeMs) { playheadMs_.store(timeMs); }
 
 void Engine::addMediaClip(const std::string &id, const std::string &path,
                           long startTime, long duration) {
+  auto frames = openFrames(path);
+
   std::lock_guard<std::mutex> lock(clipsMutex_);
   MediaClip clip;
   clip.id = id;
@@ -71,79 +110,155 @@ void Engine::addMediaClip(const std::string &id, const std::string &path,
   clip.startTime = startTime;
   clip.duration = duration;
   clip.textureId = 0;
-  clip.decoder = std::make_unique<VideoDecoder>(path);
-  clip.decoder->initialize();
-  clips_.push_back(std::move(clip));
+  clip.frames = std::move(frames);
+
+  const cineforge::Symbol key = cineforge::intern(id);
+  clips_[key] = std::move(clip);
 
   // Sync with cineforge timeline
   cineforge::timeline::Clip c;
-  c.id = id;
-  c.sourceId = path;
+  c.id = key;
+  c.sourceId = cineforge::intern(path);
   c.start = static_cast<double>(startTime);
   c.end = static_cast<double>(startTime + duration);
-  timeline_.addClip("default_track", c); // Assuming a default track for now
+  timeline_.addClip(defaultTrackId_, c); // Single video track for now
 
   LOGI("Added native clip: ID=%s, Path=%s", id.c_str(), path.c_str());
 }
 
 void Engine::removeMediaClip(const std::string &id) {
   std::lock_guard<std::mutex> lock(clipsMutex_);
-  clips_.erase(std::remove_if(clips_.begin(), clips_.end(),
-                              [&id](const MediaClip &c) { return c.id == id; }),
-               clips_.end());
-
-  // cineforge::timeline doesn't have removeClip yet in the shown header,
-  // but we should ideally sync it if we add it there.
+  const cineforge::Symbol key = cineforge::SymbolTable::global().find(id);
+  clips_.erase(key);
+  timeline_.removeClip(key);
 
   LOGI("Removed native clip: ID=%s", id.c_str());
 }
 
 void Engine::splitClip(const std::string &clipId, long timeMs) {
-  std::lock_guard<std::mutex> lock(clipsMutex_);
-
-  // Sync with cineforge timeline
-  timeline_.splitClip(clipId, static_cast<double>(timeMs));
+  std::string path;
+  cineforge::Symbol secondKey;
+  {
+    std::lock_guard<std::mutex> lock(clipsMutex_);
+    const cineforge::Symbol key =
+        cineforge::SymbolTable::global().find(clipId);
+
+    // Sync with cineforge timeline
+    timeline_.splitClip(key, static_cast<double>(timeMs));
+
+    // Update local clips_ to match the split (simplified update)
+    auto it = clips_.find(key);
+    if (it == clips_.end())
+      return;
 
-  // Update local clips_ to match the split (simplified update)
-  auto it =
-      std::find_if(clips_.begin(), clips_.end(),
-                   [&clipId](const MediaClip &c) { return c.id == clipId; });
+    MediaClip &first = it->second;
+    if (timeMs <= first.startTime ||
+        timeMs >= (first.startTime + first.duration))
+      return;
 
-  if (it != clips_.end() && timeMs > it->startTime &&
-      timeMs < (it->startTime + it->duration)) {
-    long firstPartDuration = timeMs - it->startTime;
-    long secondPartDuration = it->duration - firstPartDuration;
+    long firstPartDuration = timeMs - first.startTime;
+    long secondPartDuration = first.duration - firstPartDuration;
 
     MediaClip secondPart;
-    secondPart.id = it->id + "_b";
-    secondPart.path = it->path;
+    secondPart.id = first.id + "_b";
+    secondPart.path = first.path;
     secondPart.startTime = timeMs;
     secondPart.duration = secondPartDuration;
     secondPart.textureId = 0; // Will be generated on first render
-    secondPart.decoder = std::make_unique<VideoDecoder>(it->path);
-    secondPart.decoder->initialize();
 
-    it->duration = firstPartDuration;
-    clips_.insert(it + 1, std::move(secondPart));
+    first.duration = firstPartDuration;
+    path = first.path;
+    secondKey = cineforge::intern(secondPart.id);
+    clips_[secondKey] = std::move(secondPart);
 
     LOGI("Split native clip: ID=%s at %ldms", clipId.c_str(), timeMs);
   }
+
+  // The second part needs a decoder of its own. It is attached once open,
+  // unless the part was removed or replaced in the meantime.
+  auto frames = openFrames(path);
+  if (!frames)
+    return;
+  std::lock_guard<std::mutex> lock(clipsMutex_);
+  auto second = clips_.find(secondKey);
+  if (second != clips_.end() && second->second.path == path &&
+      !second->second.frames)
+    second->second.frames = std::move(frames);
 }
 
 void Engine::moveClip(const std::string &clipId, long newStartTimeMs) {
   std::lock_guard<std::mutex> lock(clipsMutex_);
+  const cineforge::Symbol key = cineforge::SymbolTable::global().find(clipId);
 
   // Sync with cineforge timeline
-  timeline_.moveClip(clipId, static_cast<double>(newStartTimeMs));
+  timeline_.moveClip(key, static_cast<double>(newStartTimeMs));
 
   // Update local clips_
-  for (auto &c : clips_) {
-    if (c.id == clipId) {
-      c.startTime = newStartTimeMs;
-      LOGI("Moved native clip: ID=%s to %ldms", clipId.c_str(), newStartTimeMs);
-      return;
+  auto it = clips_.find(key);
+  if (it != clips_.end()) {
+    it->second.startTime = newStartTimeMs;
+    LOGI("Moved native clip: ID=%s to %ldms", clipId.c_str(), newStartTimeMs);
+  }
+}
+
+void Engine::planPrefetch(long currentTime) {
+  // Called with clipsMutex_ held. The range includes the clips on screen,
+  // which want frames from the playhead on; the ones after the next cut
+  // want theirs from their first frame.
+  upcomingClips_.clear();
+  timeline_.clipsInRange(static_cast<double>(currentTime),
+                         static_cast<double>(currentTime + kPrefetchMs),
+                         upcomingClips_);
+
+  std::vector<cineforge::Symbol> warm;
+  warm.reserve(upcomingClips_.size());
+  for (const auto *upcoming : upcomingClips_) {
+    auto found = clips_.find(upcoming->id);
+    if (found == clips_.end() || !found->second.frames)
+      continue;
+    const long localMs = std::max(0L, currentTime - found->second.startTime);
+    found->second.frames->prime(static_cast<int64_t>(localMs) * 1000);
+    warm.push_back(upcoming->id);
+  }
+
+  // Clips the playhead left behind give their frame memory back.
+  for (const cineforge::Symbol id : warmClips_) {
+    if (std::find(warm.begin(), warm.end(), id) != warm.end())
+      continue;
+    auto found = clips_.find(id);
+    if (found != clips_.end() && found->second.frames)
+      found->second.frames->trim();
+  }
+  warmClips_.swap(warm);
+}
+
+void Engine::decodeLoop() {
+  LOGI("Decode loop started");
+
+  std::vector<std::shared_ptr<cineforge::media::FramePrefetcher>> work;
+  while (isRunning_) {
+    work.clear();
+    {
+      std::lock_guard<std::mutex> lock(clipsMutex_);
+      for (auto &entry : clips_) {
+        if (entry.second.frames && entry.second.frames->wantsDecode())
+          work.push_back(entry.second.frames);
+      }
+    }
+
+    // One frame per clip per pass, outside clipsMutex_, so that neither
+    // the render thread nor edits wait on a codec.
+    bool progressed = false;
+    for (auto &frames : work)
+      progressed |= frames->decodeStep(kDecodeWaitUs);
+
+    if (!progressed) {
+      std::unique_lock<std::mutex> lock(decodeWakeMutex_);
+      decodeWake_.wait_for(lock, kDecodeIdle);
     }
   }
+
+  LOGI("Decode loop stopped");
 }
 
 void Engine::renderLoop() {
@@ -223,20 +338,34 @@ void Engine::renderLoop() {
           // If no clips, draw a debug quad (placeholder)
           renderer.render(0, 0, 0, 1.0f, 1.0f, 0.0f);
         } else {
-          const long currentTime = playheadMs_.load();
-
-          for (auto &clip : clips_) {
-            const long clipStart = clip.startTime;
-            const long clipEnd = clip.startTime + clip.duration;
-            if (currentTime >= clipStart && currentTime <= clipEnd) {
-              if (clip.decoder) {
+          long currentTime = playheadMs_.load();
+
+          activeClips_.clear();
+          timeline_.clipsAt(static_cast<double>(currentTime), activeClips_);
+          if (activeClips_.empty() && currentTime > 0) {
+            // Clips cover [start, end), so a playhead parked on the end of
+            // a clip (usually the end of the timeline) would show nothing;
+            // it shows the clip's last millisecond instead.
+            timeline_.clipsAt(static_cast<double>(currentTime - 1),
+                              activeClips_);
+            if (!activeClips_.empty())
+              --currentTime;
+          }
+          planPrefetch(currentTime);
+
+          for (const auto *active : activeClips_) {
+            auto found = clips_.find(active->id);
+            if (found != clips_.end()) {
+              MediaClip &clip = found->second;
+              const long clipStart = clip.startTime;
+              if (clip.frames) {
                 const int64_t localUs =
                     static_cast<int64_t>(currentTime - clipStart) * 1000;
-                clip.decoder->seekToUs(localUs);
-                clip.decoder->decodeNext();
-
-                const auto *rgba = clip.decoder->lastFrameRgba();
-                if (rgba) {
+                // Only picks among frames already decoded; the decode
+                // thread keeps them coming.
+                const auto *frame = clip.frames->frameAt(localUs);
+                if (frame && frame->ptsUs != clip.uploadedPtsUs) {
+                  clip.uploadedPtsUs = frame->ptsUs;
                   if (clip.textureId == 0) {
                     glGenTextures(1, &clip.textureId);
                     glBindTexture(GL_TEXTURE_2D, clip.textureId);
@@ -252,9 +381,9 @@ void Engine::renderLoop() {
                     glBindTexture(GL_TEXTURE_2D, clip.textureId);
                   }
 
-                  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, clip.decoder->width(),
-                               clip.decoder->height(), 0, GL_RGBA,
-                               GL_UNSIGNED_BYTE, rgba);
+                  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, frame->width,
+                               frame->height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                               frame->rgba.data());
                 }
               }
 
@@ -265,6 +394,7 @@ void Engine::renderLoop() {
         }
       }
 
+      decodeWake_.notify_one();
       eglSwapBuffers(display, surface);
     } else {
       // Sleep to avoid burning CPU when no surface
@@ -6,12 +6,15 @@
 #include <algorithm>
 #include <android/native_window.h>
 #include <atomic>
+#include <cineforge/media/FramePrefetcher.h>
 #include <cineforge/timeline/Timeline.h>
+#include <condition_variable>
 #include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace videoeditor {
@@ -33,7 +36,10 @@ public:
     long startTime;
     long duration;
     uint32_t textureId = 0;
-    std::unique_ptr<VideoDecoder> decoder;
+    // Decoder and the frames it decoded ahead; filled by the decode
+    // thread, which holds its own reference while it works.
+    std::shared_ptr<cineforge::media::FramePrefetcher> frames;
+    int64_t uploadedPtsUs = -1; // frame currently in the texture
   };
 
   void addMediaClip(const std::string &id, const std::string &path,
@@ -49,20 +55,36 @@ private:
   ~Engine();
 
   void renderLoop();
+  void decodeLoop();
+  // Tells clip decoders which frames the next display frames need.
+  void planPrefetch(long currentTime);
 
   bool initialized_;
   ANativeWindow *window_;
   std::mutex windowMutex_;
 
   std::thread renderThread_;
+  std::thread decodeThread_;
   std::atomic<bool> isRunning_;
 
+  // Wakes the decode thread after the render thread consumed frames or
+  // moved the playhead.
+  std::mutex decodeWakeMutex_;
+  std::condition_variable decodeWake_;
+
   std::atomic<long> playheadMs_{0};
 
-  std::vector<MediaClip> clips_;
+  // Decoder state keyed by clip id; placement and ordering live in
+  // timeline_, which answers the per-frame "what is on screen" query.
+  std::unordered_map<cineforge::Symbol, MediaClip> clips_;
   std::mutex clipsMutex_;
 
   cineforge::timeline::Timeline timeline_;
+  cineforge::Symbol defaultTrackId_;
+  std::vector<const cineforge::timeline::Clip *> activeClips_;
+  std::vector<const cineforge::timeline::Clip *> upcomingClips_;
+  // Clips with frames decoded ahead, as of the last planPrefetch().
+  std::vector<cineforge::Symbol> warmClips_;
 
   std::atomic<float> brightness_{1.0f};
   std::atomic<float> contrast_{1.0f};
@@ -2,20 +2,34 @@
 
 #include <android/log.h>
 
+#include "cineforge/media/Y4mDecoder.h"
+
 namespace {
 constexpr const char *TAG = "VideoDecoder";
 
 void loge(const char *msg) { __android_log_print(ANDROID_LOG_ERROR, TAG, "%s", msg); }
 void logi(const char *msg) { __android_log_print(ANDROID_LOG_INFO, TAG, "%s", msg); }
+
+// MediaCodecInfo.CodecCapabilities / MediaFormat constants.
+constexpr int32_t kColorFormatYUV420Planar = 19;
+constexpr int32_t kColorStandardBT601Pal = 2;
+constexpr int32_t kColorStandardBT601Ntsc = 4;
+constexpr int32_t kColorRangeFull = 1;
+
+// The NDK declares these keys only from API 28, but the platform has
+// understood the strings since API 21, well below minSdk.
+constexpr const char *kKeySliceHeight = "slice-height";
+constexpr const char *kKeyColorStandard = "color-standard";
+constexpr const char *kKeyColorRange = "color-range";
 } // namespace
 
 namespace videoeditor {
 
 VideoDecoder::VideoDecoder(const std::string &path) : path_(path) {}
 
-VideoDecoder::~VideoDecoder() { shutdown(); }
+VideoDecoder::~VideoDecoder() { close(); }
 
-bool VideoDecoder::initialize() {
+bool VideoDecoder::open() {
   std::lock_guard<std::mutex> lock(mutex_);
 
   extractor_ = AMediaExtractor_new();
@@ -43,6 +57,27 @@ bool VideoDecoder::initialize() {
       AMediaFormat_getInt32(format, AMEDIAFORMAT_KEY_WIDTH, &width_);
       AMediaFormat_getInt32(format, AMEDIAFORMAT_KEY_HEIGHT, &height_);
       AMediaFormat_getInt64(format, AMEDIAFORMAT_KEY_DURATION, &durationUs_);
+      // The frame rate is stored as an int or a float depending on the
+      // container; without either it is measured while decoding.
+      int32_t fpsInt = 0;
+      float fps = 0.0f;
+      if (AMediaFormat_getInt32(format, AMEDIAFORMAT_KEY_FRAME_RATE, &fpsInt))
+        fps = static_cast<float>(fpsInt);
+      else
+        AMediaFormat_getFloat(format, AMEDIAFORMAT_KEY_FRAME_RATE, &fps);
+      nominalFrameUs_ = fps > 0.0f ? static_cast<int64_t>(1e6f / fps) : 0;
+      updateOutputFormat(format);
+
+      // A second extractor answers sync-sample queries without disturbing
+      // the decode position; seeks fall back to always re-seeking without.
+      syncProbe_ = AMediaExtractor_new();
+      if (syncProbe_ &&
+          (AMediaExtractor_setDataSource(syncProbe_, path_.c_str()) !=
+               AMEDIA_OK ||
+           AMediaExtractor_selectTrack(syncProbe_, i) != AMEDIA_OK)) {
+        AMediaExtractor_delete(syncProbe_);
+        syncProbe_ = nullptr;
+      }
 
       codec_ = AMediaCodec_createDecoderByType(mime);
       if (!codec_) {
@@ -72,9 +107,12 @@ bool VideoDecoder::initialize() {
   return false;
 }
 
-void VideoDecoder::shutdown() {
+void VideoDecoder::close() {
   std::lock_guard<std::mutex> lock(mutex_);
 
+  releaseHeld();
+  inputDone_ = false;
+  outputDone_ = false;
   if (codec_) {
     AMediaCodec_stop(codec_);
     AMediaCodec_delete(codec_);
@@ -84,26 +122,47 @@ void VideoDecoder::shutdown() {
     AMediaExtractor_delete(extractor_);
     extractor_ = nullptr;
   }
+  if (syncProbe_) {
+    AMediaExtractor_delete(syncProbe_);
+    syncProbe_ = nullptr;
+  }
 }
 
 bool VideoDecoder::seekToUs(int64_t timeUs) {
   std::lock_guard<std::mutex> lock(mutex_);
-  if (!extractor_ || videoTrackIndex_ < 0)
+  if (!extractor_ || !codec_ || videoTrackIndex_ < 0)
     return false;
 
-  AMediaExtractor_seekTo(extractor_, timeUs, AMEDIAEXTRACTOR_SEEK_CLOSEST_SYNC);
+  // Frames still queued in the codec belong to the old position.
+  releaseHeld();
+  AMediaCodec_flush(codec_);
+  inputDone_ = false;
+  outputDone_ = false;
+  AMediaExtractor_seekTo(extractor_, timeUs,
+                         AMEDIAEXTRACTOR_SEEK_PREVIOUS_SYNC);
   return true;
 }
 
-bool VideoDecoder::decodeNext() {
+int64_t VideoDecoder::syncSampleUs(int64_t timeUs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!syncProbe_)
+    return -1;
+  AMediaExtractor_seekTo(syncProbe_, timeUs,
+                         AMEDIAEXTRACTOR_SEEK_PREVIOUS_SYNC);
+  return AMediaExtractor_getSampleTime(syncProbe_);
+}
+
+bool VideoDecoder::decodeNext(int64_t timeoutUs) {
   std::lock_guard<std::mutex> lock(mutex_);
-  if (!codec_ || !extractor_)
+  if (!codec_ || !extractor_ || outputDone_)
     return false;
 
-  // Input
-  ssize_t inIndex =
-      AMediaCodec_dequeueInputBuffer(codec_, /*timeoutUs*/ 0);
-  if (inIndex >= 0) {
+  // Input: fill every free buffer so the codec can pipeline while we wait
+  // on output.
+  while (!inputDone_) {
+    ssize_t inIndex = AMediaCodec_dequeueInputBuffer(codec_, /*timeoutUs*/ 0);
+    if (inIndex < 0)
+      break;
     size_t bufSize = 0;
     uint8_t *buf = AMediaCodec_getInputBuffer(codec_, inIndex, &bufSize);
     if (buf) {
@@ -111,6 +170,7 @@ bool VideoDecoder::decodeNext() {
       if (sampleSize < 0) {
         AMediaCodec_queueInputBuffer(codec_, inIndex, 0, 0, 0,
                                      AMEDIACODEC_BUFFER_FLAG_END_OF_STREAM);
+        inputDone_ = true;
       } else {
         int64_t ptsUs = AMediaExtractor_getSampleTime(extractor_);
         AMediaCodec_queueInputBuffer(codec_, inIndex, 0,
@@ -123,39 +183,143 @@ bool VideoDecoder::decodeNext() {
   // Output
   AMediaCodecBufferInfo info{};
   ssize_t outIndex =
-      AMediaCodec_dequeueOutputBuffer(codec_, &info, /*timeoutUs*/ 0);
+      AMediaCodec_dequeueOutputBuffer(codec_, &info, timeoutUs);
+  if (outIndex == AMEDIACODEC_INFO_OUTPUT_FORMAT_CHANGED) {
+    AMediaFormat *format = AMediaCodec_getOutputFormat(codec_);
+    if (format) {
+      updateOutputFormat(format);
+      AMediaFormat_delete(format);
+    }
+    return false;
+  }
   if (outIndex >= 0) {
+    if (info.flags & AMEDIACODEC_BUFFER_FLAG_END_OF_STREAM)
+      outputDone_ = true;
     size_t bufSize = 0;
     uint8_t *buf = AMediaCodec_getOutputBuffer(codec_, outIndex, &bufSize);
-    if (buf && width_ > 0 && height_ > 0) {
-      // Naive NV12/NV21 -> RGBA conversion (CPU). Real implementation
-      // should query format and handle all planes precisely.
-      const int w = width_;
-      const int h = height_;
-      const size_t ySize = static_cast<size_t>(w * h);
-      if (bufSize >= ySize) {
-        rgbaBuffer_.resize(static_cast<size_t>(w * h * 4));
-        const uint8_t *yPlane = buf;
-        // Assume a single chroma plane that we ignore for now; render
-        // luma as grayscale to keep it simple and robust.
-        for (int j = 0; j < h; ++j) {
-          for (int i = 0; i < w; ++i) {
-            uint8_t Y = yPlane[j * w + i];
-            std::size_t idx = static_cast<std::size_t>((j * w + i) * 4);
-            rgbaBuffer_[idx + 0] = Y;
-            rgbaBuffer_[idx + 1] = Y;
-            rgbaBuffer_[idx + 2] = Y;
-            rgbaBuffer_[idx + 3] = 255;
-          }
-        }
-      }
+    if (!buf || info.offset < 0 || info.size <= 0 ||
+        static_cast<size_t>(info.offset) + static_cast<size_t>(info.size) >
+            bufSize) {
+      // Empty end-of-stream marker; keep the current frame.
+      AMediaCodec_releaseOutputBuffer(codec_, outIndex, /*render*/ false);
+      return false;
     }
-    AMediaCodec_releaseOutputBuffer(codec_, outIndex, /*render*/ false);
+    if (ptsUs_ >= 0 && info.presentationTimeUs > ptsUs_)
+      measuredFrameUs_ = info.presentationTimeUs - ptsUs_;
+    releaseHeld();
+    held_ = outIndex;
+    heldData_ = buf + info.offset;
+    heldSize_ = static_cast<size_t>(info.size);
+    ptsUs_ = info.presentationTimeUs;
     return true;
   }
 
   return false;
 }
 
+void VideoDecoder::releaseHeld() {
+  if (held_ >= 0 && codec_)
+    AMediaCodec_releaseOutputBuffer(codec_, static_cast<size_t>(held_),
+                                    /*render*/ false);
+  held_ = -1;
+  heldData_ = nullptr;
+  heldSize_ = 0;
+  ptsUs_ = -1;
+}
+
+void VideoDecoder::updateOutputFormat(AMediaFormat *format) {
+  using namespace cineforge::render;
+  int32_t value = 0;
+  if (AMediaFormat_getInt32(format, AMEDIAFORMAT_KEY_WIDTH, &value) && value > 0)
+    width_ = value;
+  if (AMediaFormat_getInt32(format, AMEDIAFORMAT_KEY_HEIGHT, &value) && value > 0)
+    height_ = value;
+  stride_ = AMediaFormat_getInt32(format, AMEDIAFORMAT_KEY_STRIDE, &value) &&
+                    value >= width_
+                ? value
+                : width_;
+  sliceHeight_ =
+      AMediaFormat_getInt32(format, kKeySliceHeight, &value) &&
+              value >= height_
+          ? value
+          : height_;
+
+  // Anything but planar is treated as NV12, which is what flexible and
+  // vendor semi-planar formats hand out in ByteBuffer mode.
+  int32_t colorFormat = 0;
+  AMediaFormat_getInt32(format, AMEDIAFORMAT_KEY_COLOR_FORMAT, &colorFormat);
+  layout_ = colorFormat == kColorFormatYUV420Planar ? YuvLayout::I420
+                                                    : YuvLayout::NV12;
+
+  // Untagged streams follow the usual convention: BT.709 for HD, BT.601
+  // below. BT.2020 has no kernel of its own and gets BT.709.
+  int32_t standard = 0;
+  if (AMediaFormat_getInt32(format, kKeyColorStandard, &standard)) {
+    matrix_ = standard == kColorStandardBT601Pal ||
+                      standard == kColorStandardBT601Ntsc
+                  ? YuvMatrix::BT601
+                  : YuvMatrix::BT709;
+  } else {
+    matrix_ = height_ >= 720 ? YuvMatrix::BT709 : YuvMatrix::BT601;
+  }
+  int32_t range = 0;
+  range_ = AMediaFormat_getInt32(format, kKeyColorRange, &range) &&
+                   range == kColorRangeFull
+               ? YuvRange::Full
+               : YuvRange::Limited;
+}
+
+bool VideoDecoder::readRgba(uint8_t *dst, int stride) {
+  using namespace cineforge::render;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (held_ < 0 || !dst || width_ <= 0 || height_ <= 0 || stride < width_ * 4)
+    return false;
+
+  const uint8_t *data = heldData_;
+  const size_t size = heldSize_;
+  YuvImage image;
+  image.width = width_;
+  image.height = height_;
+  image.layout = layout_;
+  image.y = data;
+  image.yStride = stride_;
+  image.u = data + static_cast<size_t>(stride_) * sliceHeight_;
+  const size_t chromaRows = static_cast<size_t>(height_ + 1) / 2;
+  const size_t chromaWidth = static_cast<size_t>(width_ + 1) / 2;
+  if (layout_ == YuvLayout::I420) {
+    image.uvStride = (stride_ + 1) / 2;
+    image.v = image.u +
+              static_cast<size_t>(image.uvStride) * ((sliceHeight_ + 1) / 2);
+  } else {
+    image.uvStride = stride_;
+  }
+  // End of the last chroma row actually read.
+  const uint8_t *last = layout_ == YuvLayout::I420 ? image.v : image.u;
+  const size_t needed = static_cast<size_t>(last - data) +
+                        (chromaRows - 1) * image.uvStride +
+                        chromaWidth * (layout_ == YuvLayout::I420 ? 1 : 2);
+  if (size < needed)
+    return false;
+
+  Frame out;
+  out.width = width_;
+  out.height = height_;
+  out.format = PixelFormat::RGBA8;
+  out.cpuData = dst;
+  out.cpuStride = stride;
+  yuvToRgba(image, matrix_, range_, out, 0, height_);
+  return true;
+}
+
+std::unique_ptr<cineforge::media::Decoder>
+createDecoder(const std::string &path) {
+  constexpr const char kY4m[] = ".y4m";
+  constexpr size_t kY4mLen = sizeof(kY4m) - 1;
+  if (path.size() >= kY4mLen &&
+      path.compare(path.size() - kY4mLen, kY4mLen, kY4m) == 0)
+    return std::make_unique<cineforge::media::Y4mDecoder>(path);
+  return std::make_unique<VideoDecoder>(path);
+}
+
 } // namespace videoeditor
 
@@ -4,61 +4,97 @@
 #include <media/NdkMediaCodec.h>
 #include <media/NdkMediaExtractor.h>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
-#include <vector>
+
+#include "cineforge/media/Decoder.h"
+#include "cineforge/render/YuvConvert.h"
 
 namespace videoeditor {
 
 /**
- * Minimal MediaCodec-based video decoder skeleton.
+ * MediaCodec backend of cineforge::media::Decoder.
  *
  * This class is responsible for:
  *  - opening a media file via AMediaExtractor
  *  - configuring an AMediaCodec decoder
  *  - stepping decode to produce frames near a requested presentation time
+ *  - converting the current YUV output buffer to RGBA for texture upload
  *
- * For now, the implementation will focus on wiring and lifetime; the
- * actual YUV->texture upload path will be handled by the Engine /
- * TextureRenderer integration.
+ * The codec output buffer of the current frame is held until the next
+ * frame replaces it, so readRgba() converts straight out of it. The
+ * conversion follows the codec's output format (planar or
+ * semi-planar, stride, slice height, colour standard and range) and uses
+ * the engine's SIMD kernels (cineforge/render/YuvConvert.h).
  */
-class VideoDecoder {
+class VideoDecoder : public cineforge::media::Decoder {
 public:
   explicit VideoDecoder(const std::string &path);
-  ~VideoDecoder();
+  ~VideoDecoder() override;
 
-  bool initialize();
-  void shutdown();
+  bool open() override;
+  void close() override;
 
-  // Seek to a presentation time in microseconds.
-  bool seekToUs(int64_t timeUs);
+  // Seek to a presentation time in microseconds; flushes the codec.
+  bool seekToUs(int64_t timeUs) override;
 
-  // Decode one frame; returns true if a frame was produced.
-  bool decodeNext();
+  // Feeds every free input buffer, then waits up to timeoutUs for one
+  // frame; returns true if a frame was produced.
+  bool decodeNext(int64_t timeoutUs = 0) override;
+  bool endOfStream() const override { return outputDone_; }
 
-  // Pointer to last decoded RGBA frame data (width * height * 4 bytes).
-  const std::uint8_t *lastFrameRgba() const {
-    return rgbaBuffer_.empty() ? nullptr : rgbaBuffer_.data();
-  }
+  int64_t framePtsUs() const override { return held_ >= 0 ? ptsUs_ : -1; }
+  bool readRgba(std::uint8_t *dst, int stride) override;
+  int64_t syncSampleUs(int64_t timeUs) override;
 
-  int width() const { return width_; }
-  int height() const { return height_; }
-  int64_t durationUs() const { return durationUs_; }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+  int64_t durationUs() const override { return durationUs_; }
+  int64_t frameDurationUs() const override {
+    return nominalFrameUs_ > 0 ? nominalFrameUs_ : measuredFrameUs_;
+  }
 
 private:
   std::string path_;
   AMediaExtractor *extractor_ = nullptr;
   AMediaCodec *codec_ = nullptr;
+  AMediaExtractor *syncProbe_ = nullptr;
 
   int videoTrackIndex_ = -1;
   int width_ = 0;
   int height_ = 0;
   int64_t durationUs_ = 0;
+  int64_t nominalFrameUs_ = 0;  // from the track's frame rate
+  int64_t measuredFrameUs_ = 0; // last gap between output frames
+
+  // Output buffer layout; refreshed whenever the codec reports a new
+  // output format.
+  int stride_ = 0;
+  int sliceHeight_ = 0;
+  cineforge::render::YuvLayout layout_ = cineforge::render::YuvLayout::NV12;
+  cineforge::render::YuvMatrix matrix_ = cineforge::render::YuvMatrix::BT601;
+  cineforge::render::YuvRange range_ = cineforge::render::YuvRange::Limited;
+
+  // Output buffer of the current frame, or -1.
+  ssize_t held_ = -1;
+  const std::uint8_t *heldData_ = nullptr;
+  size_t heldSize_ = 0;
+  int64_t ptsUs_ = -1;
+  bool inputDone_ = false;
+  bool outputDone_ = false;
 
   std::mutex mutex_;
-  std::vector<std::uint8_t> rgbaBuffer_;
+
+  void updateOutputFormat(AMediaFormat *format);
+  void releaseHeld();
 };
 
+// Picks the backend for `path`: the software y4m reader for .y4m files,
+// MediaCodec for everything else. The decoder is not opened yet.
+std::unique_ptr<cineforge::media::Decoder>
+createDecoder(const std::string &path);
+
 } // namespace videoeditor
 
 #endif // VIDEOEDITOR_VIDEO_DECODER_H
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace cineforge {
+
+/**
+ * Blocking FIFO with a fixed capacity, for handing work between pipeline
+ * stages. push() waits while the queue is full and pop() while it is
+ * empty, which is what applies back-pressure to faster stages.
+ *
+ * close() wakes everyone: pushes fail from then on, and pops drain what
+ * is left before failing.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity) : capacity_(capacity ? capacity : 1) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // False if the queue was closed; `item` is left untouched then.
+    bool push(T& item) {
+        std::unique_lock<std::mutex> lock(mtx_);
+        notFull_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        items_.push_back(std::move(item));
+        lock.unlock();
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    // False once the queue is closed and drained.
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mtx_);
+        notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return false;
+        }
+        item = std::move(items_.front());
+        items_.pop_front();
+        lock.unlock();
+        notFull_.notify_one();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            closed_ = true;
+        }
+        notFull_.notify_all();
+        notEmpty_.notify_all();
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    const std::size_t capacity_;
+    std::mutex mtx_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    std::deque<T> items_;
+    bool closed_ = false;
+};
+
+} // namespace cineforge
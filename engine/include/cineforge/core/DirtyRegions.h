@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace cineforge {
+
+using Revision = std::uint64_t;
+
+// Next value of a process-wide, monotonically increasing counter. All
+// subsystems stamp their edits from it, so revisions are comparable
+// across the timeline, keyframes and any caches built on top of them.
+Revision nextRevision();
+
+/**
+ * Records which time ranges were touched by which revision.
+ *
+ * Each edit is stamped with a fresh revision and the half-open range
+ * [t0, t1) of timeline time it can affect (infinite bounds allowed).
+ * Consumers remember the revision they last saw and ask whether anything
+ * affecting a range changed since. Only the most recent `capacity` edits
+ * are kept; questions about older revisions are answered conservatively
+ * with "changed".
+ */
+class DirtyRegionTracker {
+public:
+    explicit DirtyRegionTracker(std::size_t capacity = 256);
+
+    // Revision of the latest edit, 0 if there has been none.
+    Revision revision() const { return revision_; }
+
+    // Records an edit affecting [t0, t1). An empty range still bumps the
+    // revision, for edits that change structure but no rendered output.
+    Revision markDirty(double t0, double t1);
+    Revision markAllDirty();
+
+    bool changedSince(Revision since) const { return revision_ > since; }
+    bool changedSince(Revision since, double t0, double t1) const;
+
+private:
+    struct Entry {
+        Revision revision;
+        double t0;
+        double t1;
+    };
+
+    std::deque<Entry> entries_;
+    std::size_t capacity_;
+    Revision revision_ = 0;
+    // Edits up to and including this revision have been discarded.
+    Revision horizon_ = 0;
+};
+
+} // namespace cineforge
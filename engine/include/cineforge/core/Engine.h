@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -15,6 +16,7 @@ class Renderer;
 } // namespace render
 
 namespace media {
+class MediaLibrary;
 class ProxyManager;
 } // namespace media
 
@@ -33,15 +35,32 @@ class Engine {
 public:
     static Engine& instance();
 
-    // Project lifecycle
+    // Project lifecycle. Files are written in the binary project format
+    // (see io/BinaryProject.h) unless the path ends in ".json" (see
+    // io/ProjectJson.h); loading detects the format from the contents.
+    // A file that fails to load leaves the current project untouched.
     bool loadProjectFromFile(const std::string& path);
+    bool saveProjectToFile(const std::string& path) const;
     bool loadProjectFromJson(const std::string& json);
     std::string saveProjectToJson() const;
 
+    // Autosave: journals every timeline and keyframe edit under `dir` and
+    // compacts the journal into snapshots in the background (see
+    // io/EditJournal.h). After a crash, recoverProject() restores the
+    // last journaled state; call it before startAutosave() on the same
+    // directory, which discards what was there.
+    bool startAutosave(const std::string& dir);
+    void stopAutosave();
+    bool recoverProject(const std::string& dir);
+
     // Playback / preview control
     void setPreviewTime(double timeSeconds);
     double previewTime() const;
 
+    // Latest edit revision across the timeline and keyframes; pass it as
+    // RenderContext::revision so the renderer can reuse cached frames.
+    std::uint64_t contentRevision() const;
+
     // Accessors to subsystems
     timeline::Timeline& timeline();
     const timeline::Timeline& timeline() const;
@@ -52,9 +71,14 @@ public:
     render::Renderer& renderer();
     const render::Renderer& renderer() const;
 
+    media::MediaLibrary& media();
+    const media::MediaLibrary& media() const;
+
     media::ProxyManager& proxyManager();
     const media::ProxyManager& proxyManager() const;
 
+    exporter::Exporter& exporter();
+
 private:
     Engine();
     ~Engine();
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace cineforge {
+
+/**
+ * Interned string handle.
+ *
+ * Engine subsystems identify tracks, clips, curves and media by Symbol
+ * rather than by std::string so that hot-path lookups hash and compare a
+ * single 32-bit integer and never allocate. Strings only appear at the
+ * API / serialization boundary, where they are interned once.
+ *
+ * The default-constructed Symbol is the empty string.
+ */
+struct Symbol {
+    std::uint32_t value = 0;
+
+    explicit operator bool() const { return value != 0; }
+
+    friend bool operator==(Symbol a, Symbol b) { return a.value == b.value; }
+    friend bool operator!=(Symbol a, Symbol b) { return a.value != b.value; }
+    friend bool operator<(Symbol a, Symbol b) { return a.value < b.value; }
+};
+
+/**
+ * Thread-safe, append-only string table handing out dense Symbol values.
+ *
+ * Interned strings live for the lifetime of the table, so references
+ * returned by name() stay valid. Ids are expected to be long-lived
+ * (tracks, clips, media), which keeps the table small in practice.
+ */
+class SymbolTable {
+public:
+    SymbolTable();
+
+    // Process-wide table used by the engine subsystems.
+    static SymbolTable& global();
+
+    Symbol intern(std::string_view text);
+    // out[i] = intern(texts[i]), under a single lock; for loaders that
+    // bring in many names at once.
+    void internAll(const std::string_view* texts, std::size_t count, Symbol* out);
+
+    // Lookup without inserting; returns the empty Symbol if `text` has
+    // never been interned.
+    Symbol find(std::string_view text) const;
+
+    const std::string& name(Symbol sym) const;
+
+    std::size_t size() const;
+
+private:
+    mutable std::shared_mutex mtx_;
+    std::deque<std::string> names_; // indexed by Symbol::value
+    std::unordered_map<std::string_view, std::uint32_t> lookup_;
+};
+
+inline Symbol intern(std::string_view text) {
+    return SymbolTable::global().intern(text);
+}
+
+inline const std::string& nameOf(Symbol sym) {
+    return SymbolTable::global().name(sym);
+}
+
+} // namespace cineforge
+
+namespace std {
+template <>
+struct hash<cineforge::Symbol> {
+    std::size_t operator()(cineforge::Symbol s) const noexcept {
+        return std::hash<std::uint32_t>{}(s.value);
+    }
+};
+} // namespace std
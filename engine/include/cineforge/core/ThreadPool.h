@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cineforge {
+
+/**
+ * Work-stealing thread pool.
+ *
+ * Every worker owns a deque. Tasks submitted from a worker go to its own
+ * deque and are popped LIFO (cache-warm); tasks from other threads are
+ * spread round-robin. An idle worker steals from the cold end of the
+ * other deques before going to sleep.
+ *
+ * parallelFor() lets the calling thread work alongside the pool, so it is
+ * safe to call from inside a task.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // 0 picks std::thread::hardware_concurrency() - 1 workers, leaving a
+    // core for the caller of parallelFor().
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    static ThreadPool& shared();
+
+    std::size_t size() const { return workers_.size(); }
+
+    void submit(Task task);
+
+    // Runs fn(i) for every i in [0, count) and returns once all calls are
+    // done. Indices are handed out dynamically, one at a time.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+private:
+    struct Queue {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex sleepMtx_;
+    std::condition_variable wake_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<std::size_t> nextQueue_{0};
+    bool stop_ = false;
+
+    bool tryPop(std::size_t self, Task& task);
+    void workerLoop(std::size_t self);
+};
+
+} // namespace cineforge
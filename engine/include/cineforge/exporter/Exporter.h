@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "cineforge/render/Frame.h"
+
+namespace cineforge::render {
+class EffectGraph;
+} // namespace cineforge::render
+
+namespace cineforge::exporter {
+
+struct ExportSettings {
+    int width = 1920;
+    int height = 1080;
+    render::PixelFormat format = render::PixelFormat::RGBA8;
+
+    // Frame rate as a rational, e.g. 30000/1001.
+    int fpsNum = 30;
+    int fpsDen = 1;
+
+    std::int64_t firstFrame = 0;
+    std::int64_t frameCount = 0;
+
+    // 0 picks one worker per hardware thread, minus the decode and encode
+    // threads.
+    std::size_t renderWorkers = 0;
+    // Capacity of each inter-stage queue.
+    std::size_t queueDepth = 4;
+    // Frames that may be between decode and encode at once, which bounds
+    // memory and the reorder buffer; 0 derives it from the above.
+    std::size_t maxFramesInFlight = 0;
+
+    double timeOf(std::int64_t frame) const {
+        return static_cast<double>(frame) * fpsDen / fpsNum;
+    }
+};
+
+struct StageStats {
+    std::size_t threads = 0;
+    std::uint64_t frames = 0;
+    double busySeconds = 0.0;
+    // busySeconds / (wall time * threads); the bottleneck stage is the one
+    // closest to 1.
+    double utilisation = 0.0;
+};
+
+struct ExportStats {
+    std::uint64_t framesEncoded = 0;
+    double wallSeconds = 0.0;
+    double fps = 0.0;
+    StageStats decode;
+    StageStats render;
+    StageStats encode;
+    std::size_t peakReorderDepth = 0; // frames held back waiting for order
+    bool cancelled = false;
+};
+
+// Produces source frames. Called from the decode thread only, with
+// strictly increasing frame numbers.
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+    virtual bool decode(std::int64_t frame, double time, render::Frame& out) = 0;
+};
+
+// Consumes finished frames in order. Called from the encode thread only.
+class FrameSink {
+public:
+    virtual ~FrameSink() = default;
+    virtual bool open(const ExportSettings& settings) = 0;
+    virtual bool write(std::int64_t frame, const render::Frame& image) = 0;
+    virtual bool close() = 0;
+};
+
+// Renders one frame; each render worker gets its own from the factory, so
+// implementations need not be thread-safe.
+using RenderFunction = std::function<bool(std::int64_t frame, double time,
+                                          const render::Frame& source,
+                                          render::Frame& out)>;
+using RenderFactory = std::function<RenderFunction()>;
+
+/**
+ * Frame-parallel export pipeline.
+ *
+ *   decode (1 thread) -> render (N workers) -> reorder -> encode (1 thread)
+ *
+ * Stages are joined by bounded queues and all frame memory comes from a
+ * private CPU buffer pool, so several frames are in flight while memory
+ * stays bounded. Workers finish out of order; the encode stage holds
+ * early frames back until their predecessors arrive.
+ */
+class Exporter {
+public:
+    Exporter();
+    ~Exporter();
+
+    Exporter(const Exporter&) = delete;
+    Exporter& operator=(const Exporter&) = delete;
+
+    void setSource(std::shared_ptr<FrameSource> source);
+    void setSink(std::shared_ptr<FrameSink> sink);
+    // Without a factory frames are copied from source to sink unchanged.
+    void setRenderFactory(RenderFactory factory);
+
+    // Factory giving every worker its own EffectGraph, filled in by `build`.
+    static RenderFactory effectGraphFactory(
+        std::function<void(render::EffectGraph&)> build);
+
+    // Blocks until the export finishes, fails or is cancelled. Returns
+    // true only if every frame was written and the sink closed cleanly.
+    bool run(const ExportSettings& settings, ExportStats* stats = nullptr);
+
+    // May be called from any thread. Stops the run in progress, or the
+    // next one if none is; the request ends when that run returns.
+    void cancel();
+
+private:
+    std::shared_ptr<FrameSource> source_;
+    std::shared_ptr<FrameSink> sink_;
+    RenderFactory factory_;
+    std::atomic<bool> cancel_{false};
+    std::mutex runMtx_;
+};
+
+} // namespace cineforge::exporter
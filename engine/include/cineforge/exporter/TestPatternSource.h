@@ -0,0 +1,20 @@
+#pragma once
+
+#include "cineforge/exporter/Exporter.h"
+
+namespace cineforge::exporter {
+
+/**
+ * Synthetic FrameSource: scrolling gradients with a frame-number stripe,
+ * deterministic per frame so exports can be checked byte for byte without
+ * any media on disk.
+ */
+class TestPatternSource : public FrameSource {
+public:
+    bool decode(std::int64_t frame, double time, render::Frame& out) override;
+
+    // The pixel decode() writes at (x, y) of `frame`, as RGBA.
+    static void pixel(std::int64_t frame, int x, int y, std::uint8_t rgba[4]);
+};
+
+} // namespace cineforge::exporter
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "cineforge/exporter/Exporter.h"
+
+namespace cineforge::exporter {
+
+/**
+ * Writes frames as a YUV4MPEG2 (.y4m) stream, the raw format ffmpeg, x264
+ * and most players read directly. It stands in for a hardware encoder in
+ * headless exports and tests.
+ *
+ * RGBA8/BGRA8 frames are converted to BT.601 limited-range YUV, either
+ * full-resolution 4:4:4 or 4:2:0 with each chroma sample averaged over a
+ * 2x2 block.
+ */
+class Y4mSink : public FrameSink {
+public:
+    enum class Chroma { C444, C420 };
+
+    explicit Y4mSink(std::string path, Chroma chroma = Chroma::C420);
+    ~Y4mSink() override;
+
+    bool open(const ExportSettings& settings) override;
+    bool write(std::int64_t frame, const render::Frame& image) override;
+    bool close() override;
+
+    std::uint64_t framesWritten() const { return frames_; }
+
+private:
+    std::string path_;
+    Chroma chroma_;
+    std::FILE* file_ = nullptr;
+    int width_ = 0;
+    int height_ = 0;
+    std::uint64_t frames_ = 0;
+    std::vector<std::uint8_t> planes_;
+};
+
+} // namespace cineforge::exporter
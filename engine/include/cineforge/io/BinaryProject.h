@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cineforge/io/ProjectData.h"
+
+namespace cineforge::io {
+
+/**
+ * Binary project format.
+ *
+ * A file is a fixed header, a section directory and the sections it
+ * points to, all little-endian with 8-byte aligned sections:
+ *
+ *   Header     magic "CFPROJ\r\n", version, directory size, preview time
+ *   Directory  {section id, record size, offset, record count} per section
+ *   Strings    {offset, length} into StringData; entry 0 is ""
+ *   StringData UTF-8 bytes of every distinct name, each stored once
+ *   Tracks     {name, type, first clip, clip count}
+ *   Clips      {name, source, start, end, in point, out point}
+ *   Curves     {name, target, first key, key count}
+ *   Keys       {time, value, interpolation, flags, bezier handles}
+ *   Media      {name, type, path, proxy path, duration}; paths are raw
+ *              StringData ranges, not Strings entries
+ *
+ * Every section is a flat array of fixed-size records, and records refer
+ * to each other by index. Loading is therefore one bounds-checked copy per
+ * record plus one intern per distinct string, with no tokenising or
+ * allocation per field. Readers skip unknown sections and read records only
+ * as far as they understand them, so later revisions can append sections
+ * and fields without a version bump; anything incompatible raises
+ * kBinaryProjectVersion, and newer files are rejected.
+ */
+inline constexpr std::uint32_t kBinaryProjectVersion = 1;
+
+// True if `data` starts with the binary project magic.
+bool isBinaryProject(const void* data, std::size_t size);
+
+std::vector<std::uint8_t> encodeBinaryProject(const ProjectData& project);
+// False on a truncated, corrupt or newer-version file; `out` is then
+// unspecified.
+bool decodeBinaryProject(const void* data, std::size_t size, ProjectData& out);
+
+// Writes through a temporary file and a rename, so a failed save never
+// clobbers the previous version.
+bool saveBinaryProject(const std::string& path, const ProjectData& project);
+// Maps the file rather than reading it.
+bool loadBinaryProject(const std::string& path, ProjectData& out);
+
+} // namespace cineforge::io
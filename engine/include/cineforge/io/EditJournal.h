@@ -0,0 +1,116 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cineforge/io/ProjectData.h"
+#include "cineforge/timeline/KeyframeManager.h"
+#include "cineforge/timeline/Timeline.h"
+
+namespace cineforge::io {
+
+/**
+ * Autosave as an append-only edit journal plus periodic snapshots.
+ *
+ * A directory holds numbered generations: snapshot-<g>.cfp is the whole
+ * project in the binary format, and journal-<g>.log the edits made after
+ * it, one small checksummed record per Timeline or KeyframeManager edit.
+ * Recording an edit costs one short append on the editing thread instead
+ * of a rewrite of the whole project.
+ *
+ * Once a journal grows past the compaction threshold it is closed and a
+ * new generation begins. The editing thread only copies the project (via
+ * the snapshot callback); encoding and writing the snapshot happen on a
+ * background thread, after which older generations are deleted. Until
+ * then they stay on disk, so a crash at any point leaves a snapshot and a
+ * chain of journals that together give the latest state. A record torn
+ * by a crash fails its checksum and ends the replay.
+ *
+ * Media sources and the preview time are not journaled; they are saved
+ * with each snapshot. Records use host byte order, so journals are for
+ * crash recovery on the same machine, not for interchange.
+ *
+ * All methods except the constructor and destructor must be called from
+ * the thread that edits the project.
+ */
+class EditJournal {
+public:
+    using SnapshotFn = std::function<ProjectData()>;
+
+    static constexpr std::size_t kDefaultCompactBytes = 4 << 20;
+
+    EditJournal() = default;
+    ~EditJournal();
+
+    EditJournal(const EditJournal&) = delete;
+    EditJournal& operator=(const EditJournal&) = delete;
+
+    // Starts journaling into `dir`, writing the base snapshot before it
+    // returns. Generations left over from a previous session are deleted
+    // once that snapshot is on disk, so recover() first if they matter.
+    bool open(const std::string& dir, SnapshotFn snapshot);
+    // Writes any pending snapshot and stops journaling.
+    void close();
+    bool isOpen() const { return file_ != nullptr; }
+
+    void record(const timeline::TimelineEdit& edit);
+    void record(const timeline::CurveEdit& edit);
+
+    // Begins a new generation now rather than at the threshold. Its
+    // snapshot is written in the background, which is only safe while the
+    // journal still leads to the current project.
+    void compact();
+    // Begins a new generation from a project that replaced the journaled
+    // one wholesale (a load or a recovery). The snapshot is written before
+    // this returns: replaying the new journal onto an older snapshot would
+    // apply its edits to the previous project. If the write fails,
+    // journaling stops and this returns false.
+    bool restart();
+    // Blocks until no snapshot is pending or being written.
+    void waitIdle();
+
+    void setCompactThreshold(std::size_t bytes) { threshold_ = bytes; }
+    std::size_t journalBytes() const { return bytes_; }
+
+    // Rebuilds the project from the newest readable snapshot in `dir` and
+    // the journals written after it. False if there is no snapshot. Meant
+    // for a directory nothing is writing to, i.e. after a crash.
+    static bool recover(const std::string& dir, ProjectData& out);
+
+private:
+    struct PendingSnapshot {
+        std::uint64_t generation;
+        ProjectData data;
+    };
+
+    std::string dir_;
+    SnapshotFn snapshot_;
+    std::FILE* file_ = nullptr;
+    std::uint64_t generation_ = 0;
+    std::size_t bytes_ = 0;
+    std::size_t threshold_ = kDefaultCompactBytes;
+    std::vector<std::uint8_t> record_;
+
+    // Snapshot writer. Only the newest pending snapshot is kept: it covers
+    // every edit an older one would have.
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::optional<PendingSnapshot> pending_;
+    bool writing_ = false;
+    bool stop_ = false;
+    std::thread worker_;
+
+    bool startGeneration(std::uint64_t generation);
+    void append();
+    void workerLoop();
+};
+
+} // namespace cineforge::io
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cineforge::io {
+
+/**
+ * Receives JSON events from JsonReader in document order. Returning false
+ * from any callback stops the parse, which then fails with the handler's
+ * message (if it set one via JsonReader::fail()) or a generic one.
+ *
+ * String views passed to key() and string() are only valid during the
+ * call.
+ */
+class JsonHandler {
+public:
+    virtual ~JsonHandler() = default;
+
+    virtual bool startObject() = 0;
+    virtual bool endObject() = 0;
+    virtual bool startArray() = 0;
+    virtual bool endArray() = 0;
+    virtual bool key(std::string_view name) = 0;
+    virtual bool string(std::string_view value) = 0;
+    virtual bool number(double value) = 0;
+    virtual bool boolean(bool value) = 0;
+    virtual bool null() = 0;
+};
+
+/**
+ * Streaming (SAX-style) JSON parser.
+ *
+ * Input is pulled through a refill callback one chunk at a time, so memory
+ * use is the chunk buffer, one token (the longest string or number, capped
+ * at maxTokenSize) and one byte per nesting level (capped at maxDepth),
+ * however large the document. Nesting is tracked on an explicit stack
+ * rather than by recursion, so hostile input cannot overflow the C++ stack.
+ *
+ * Numbers are converted with std::from_chars (strtod, and so the "C"
+ * numeric locale, where the library lacks it) and round-trip exactly
+ * whatever JsonWriter produced. The grammar is RFC 8259 except that
+ * number syntax is checked only as strictly as the converter does.
+ */
+class JsonReader {
+public:
+    // Copies up to `capacity` bytes into `buffer`; returns 0 at the end.
+    using RefillFn = std::function<std::size_t(char* buffer, std::size_t capacity)>;
+
+    struct Limits {
+        std::size_t chunkSize = 64 * 1024;
+        std::size_t maxTokenSize = 1 << 20;
+        std::size_t maxDepth = 256;
+    };
+
+    JsonReader() = default;
+    explicit JsonReader(const Limits& limits) : limits_(limits) {}
+
+    bool parse(const RefillFn& refill, JsonHandler& handler);
+    // Parses `text` in place, without copying it.
+    bool parse(std::string_view text, JsonHandler& handler);
+
+    // Lets a handler explain why it returned false.
+    void fail(std::string message);
+
+    const std::string& error() const { return error_; }
+    // Input offset at which the error was detected.
+    std::size_t errorOffset() const { return errorOffset_; }
+
+private:
+    Limits limits_;
+    const RefillFn* refill_ = nullptr;
+    std::vector<char> chunk_;
+    const char* data_ = nullptr;
+    std::size_t pos_ = 0;
+    std::size_t len_ = 0;
+    std::size_t consumed_ = 0; // bytes before data_
+    bool eof_ = false;
+    std::string token_;
+    std::string error_;
+    std::size_t errorOffset_ = 0;
+
+    bool run(JsonHandler& handler);
+    bool refill();
+    int peek();
+    int get();
+    int skipWhitespace();
+    bool readString();
+    bool readNumber(double& value);
+    bool readLiteral(const char* rest);
+    bool appendUtf8(unsigned codePoint);
+    bool readHex4(unsigned& value);
+    bool setError(const char* message);
+    bool handlerFailed();
+};
+
+} // namespace cineforge::io
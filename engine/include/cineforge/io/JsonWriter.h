@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cineforge::io {
+
+/**
+ * Appends JSON straight into a character buffer, with commas, nesting and
+ * optional indentation handled by the writer.
+ *
+ * Either builds a std::string in memory or streams through a sink in
+ * bufferSize pieces, so a large project never needs its whole text in
+ * memory. Doubles are written in the shortest form that JsonReader (or
+ * any correctly rounding parser) reads back to the same bits, using
+ * std::to_chars where the library has it and otherwise the fewer of 15 or
+ * 17 significant digits that round-trips (which assumes the "C" numeric
+ * locale). Non-finite values, which JSON cannot represent, become null.
+ *
+ * Misuse (a value where a key is expected, unbalanced ends) is a
+ * programming error and is not diagnosed.
+ */
+class JsonWriter {
+public:
+    // Receives the next piece of output; returning false fails the write.
+    using Sink = std::function<bool(const char* data, std::size_t size)>;
+
+    explicit JsonWriter(std::string& out, int indent = 2);
+    explicit JsonWriter(Sink sink, int indent = 2, std::size_t bufferSize = 64 * 1024);
+    ~JsonWriter();
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    JsonWriter& startObject();
+    JsonWriter& endObject();
+    JsonWriter& startArray();
+    JsonWriter& endArray();
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& string(std::string_view value);
+    JsonWriter& number(double value);
+    JsonWriter& integer(std::int64_t value);
+    JsonWriter& boolean(bool value);
+    JsonWriter& null();
+
+    // Flushes buffered output to the sink. False if the sink failed at
+    // any point.
+    bool finish();
+
+private:
+    struct Level {
+        bool object;
+        bool empty;
+    };
+
+    std::string own_;
+    std::string& buf_;
+    Sink sink_;
+    std::size_t bufferSize_ = 0;
+    int indent_;
+    bool failed_ = false;
+    bool afterKey_ = false;
+    std::vector<Level> levels_;
+
+    void beforeValue();
+    void newline(std::size_t depth);
+    void open(char bracket, bool object);
+    void close(char bracket);
+    void raw(const char* data, std::size_t size);
+    void maybeFlush();
+};
+
+} // namespace cineforge::io
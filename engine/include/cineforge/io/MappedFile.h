@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cineforge::io {
+
+/**
+ * Read-only view of a whole file. Memory-mapped where the platform
+ * supports it, so opening a large project costs page faults only for the
+ * bytes actually read; elsewhere the file is read into memory.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Replaces any current mapping. False if the file cannot be read; an
+    // empty file opens successfully with size() == 0.
+    bool open(const std::string& path);
+    void close();
+
+    const std::uint8_t* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool isOpen() const { return open_; }
+
+private:
+    const std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool open_ = false;
+    bool mapped_ = false;
+    std::vector<std::uint8_t> buffer_; // fallback storage
+};
+
+} // namespace cineforge::io
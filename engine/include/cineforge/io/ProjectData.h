@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+
+#include "cineforge/core/Symbol.h"
+#include "cineforge/media/MediaSource.h"
+#include "cineforge/timeline/Keyframe.h"
+#include "cineforge/timeline/Timeline.h"
+
+namespace cineforge::io {
+
+struct CurveData {
+    Symbol id;
+    Symbol target;
+    std::vector<timeline::Keyframe> keys;
+};
+
+/**
+ * Plain snapshot of everything a project file stores. Readers fill one in
+ * and Engine applies it in a single step, so a file that fails to parse
+ * halfway never leaves the engine with half a project.
+ */
+struct ProjectData {
+    double previewTime = 0.0;
+    std::vector<media::MediaSource> media;
+    std::vector<timeline::Track> tracks;
+    std::vector<CurveData> curves;
+};
+
+} // namespace cineforge::io
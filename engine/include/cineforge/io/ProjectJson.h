@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "cineforge/io/JsonReader.h"
+#include "cineforge/io/JsonWriter.h"
+#include "cineforge/io/ProjectData.h"
+
+namespace cineforge::io {
+
+/**
+ * JSON project format, for interchange and hand editing; the binary format
+ * (io/BinaryProject.h) is the faster one.
+ *
+ *   {
+ *     "version": 1,
+ *     "previewTime": 0,
+ *     "media": [{"id", "path", "proxyPath", "type", "duration"}],
+ *     "timeline": {"tracks": [
+ *       {"id", "type", "clips": [{"id", "source", "start", "end", "in", "out"}]}
+ *     ]},
+ *     "curves": [{"id", "target", "keys": [
+ *       {"time", "value", "interp", "bezier": [inX, inY, outX, outY]}
+ *     ]}]
+ *   }
+ *
+ * Track types are TrackType values; "interp" is one of "hold", "linear",
+ * "bezier", "easeIn", "easeOut" and "easeInOut" ("bezier" handles are
+ * optional). Readers ignore unknown keys and missing fields keep their
+ * defaults, so older files without "media", "curves" or in/out points
+ * still load. Files with a newer "version" are rejected.
+ */
+inline constexpr int kJsonProjectVersion = 1;
+
+void writeProjectJson(const ProjectData& project, JsonWriter& writer);
+std::string projectToJson(const ProjectData& project);
+
+// Parse failures leave `out` unspecified and, if `error` is given, describe
+// the problem and where it is.
+bool readProjectJson(const JsonReader::RefillFn& refill, ProjectData& out,
+                     std::string* error = nullptr);
+bool projectFromJson(std::string_view json, ProjectData& out, std::string* error = nullptr);
+
+// Streams to and from the file in fixed-size pieces. Saving goes through a
+// temporary file and a rename, like saveBinaryProject.
+bool saveProjectJson(const std::string& path, const ProjectData& project);
+bool loadProjectJson(const std::string& path, ProjectData& out, std::string* error = nullptr);
+
+} // namespace cineforge::io
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+#include "cineforge/media/Decoder.h"
+
+namespace cineforge::media {
+
+/**
+ * Playback-aware driver for a Decoder: given the playhead once per
+ * displayed frame, decides whether to keep decoding forward or to seek.
+ *
+ * While the playhead advances monotonically in small steps, as it does
+ * during playback, the decoder only decodes forward: no seek, no
+ * sync-sample lookup, and the backend's pipeline stays full. A step back
+ * or a jump past the sequential window is a discontinuity (scrub, loop,
+ * re-entering a clip) and goes through Decoder::seekExactUs(), which
+ * still decodes on instead when the target is in the current GOP.
+ *
+ * The scheduler holds no reference to the decoder, so it can sit next to
+ * one in a movable struct. Pass the same decoder on every call and
+ * reset() when it is replaced or reopened.
+ */
+class DecodeScheduler {
+public:
+    struct Stats {
+        std::uint64_t sequential = 0;
+        std::uint64_t discontinuities = 0;
+    };
+
+    static constexpr std::int64_t kDefaultWindowUs = 250000;
+
+    // `windowUs` is the largest forward step still treated as playback;
+    // it should cover a few dropped display frames at the fastest speed.
+    explicit DecodeScheduler(std::int64_t windowUs = kDefaultWindowUs);
+
+    // Brings `decoder` to the frame shown at `targetUs`, waiting at most
+    // `timeoutUs`. True once that frame is current. A call that runs out
+    // of time leaves the decoder where it got to, and the next one
+    // continues from there rather than seeking again.
+    bool advance(Decoder& decoder, std::int64_t targetUs, std::int64_t timeoutUs);
+
+    void reset();
+
+    std::int64_t lastTargetUs() const { return lastTargetUs_; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    std::int64_t windowUs_;
+    std::int64_t lastTargetUs_ = -1;
+    // A seek was issued and no frame has come out of it yet.
+    bool seekPending_ = false;
+    Stats stats_;
+};
+
+} // namespace cineforge::media
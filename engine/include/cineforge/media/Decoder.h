@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+namespace cineforge::media {
+
+/**
+ * Pull-style video decoder: open(), optionally seekToUs(), then
+ * decodeNext() one frame at a time in presentation order.
+ *
+ * Seeking is coarse, as with hardware decoders: the next decoded frame is
+ * the sync sample at or before the requested time, not the frame at it.
+ * seekExactUs() builds frame-accurate seeking on top by decoding forward.
+ * The current frame stays valid until the next decodeNext(), seek or
+ * close, and is converted to RGBA only when read, so frames that are
+ * decoded and skipped cost no conversion.
+ *
+ * Backends are driven from one thread at a time.
+ */
+class Decoder {
+public:
+    virtual ~Decoder() = default;
+
+    virtual bool open() = 0;
+    virtual void close() = 0;
+
+    // Repositions at the sync sample at or before `timeUs` and drops the
+    // current frame.
+    virtual bool seekToUs(std::int64_t timeUs) = 0;
+
+    // Advances to the next frame, waiting up to `timeoutUs` for a backend
+    // that decodes asynchronously. False if none is ready in time or the
+    // stream has ended; the current frame is then kept.
+    virtual bool decodeNext(std::int64_t timeoutUs = 0) = 0;
+    virtual bool endOfStream() const = 0;
+
+    // Presentation time of the current frame, or -1 if there is none.
+    virtual std::int64_t framePtsUs() const = 0;
+
+    // Writes the current frame as RGBA8, width() x height() with rows
+    // `stride` bytes apart. False if there is no current frame.
+    virtual bool readRgba(std::uint8_t* dst, int stride) = 0;
+
+    // Time of the sync sample seekToUs(timeUs) would resume from, or -1 if
+    // the backend cannot tell.
+    virtual std::int64_t syncSampleUs(std::int64_t timeUs) = 0;
+
+    virtual int width() const = 0;
+    virtual int height() const = 0;
+    virtual std::int64_t durationUs() const = 0;
+    // Nominal frame interval, or 0 if unknown.
+    virtual std::int64_t frameDurationUs() const = 0;
+
+    /**
+     * Makes the frame shown at `targetUs` current: the last one presented
+     * at or before it (or the first frame, for earlier targets). Frames in
+     * between are decoded and discarded.
+     *
+     * When the target lies ahead of the current frame in the same GOP, or
+     * a seek would skip only a few frames, decoding simply continues
+     * instead of seeking, which is what keeps sequential playback cheap.
+     * A backend without a frame duration stops at the first frame at or
+     * after the target, and always seeks across a sync sample.
+     *
+     * False if no such frame arrived within `timeoutUs`. The decoder is
+     * left part-way; once it has a frame, calling again with the same
+     * target resumes without another seek if the backend reports sync
+     * samples. DecodeScheduler also covers a seek still waiting for its
+     * first frame.
+     */
+    bool seekExactUs(std::int64_t targetUs, std::int64_t timeoutUs);
+
+    // The forward half of seekExactUs(): decodes on from the current
+    // position, never seeking, until the frame shown at `targetUs` is
+    // current. Frames are only ever passed, so a target behind the
+    // current frame returns true with that frame.
+    bool decodeForwardUs(std::int64_t targetUs, std::int64_t timeoutUs);
+
+    // Whether the current frame is the one shown at `targetUs`, i.e. the
+    // last one at or before it. Without a frame duration, whether it is
+    // at or after `targetUs`.
+    bool showsFrameAt(std::int64_t targetUs) const;
+};
+
+} // namespace cineforge::media
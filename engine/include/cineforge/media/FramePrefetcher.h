@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cineforge/media/DecodeScheduler.h"
+#include "cineforge/media/Decoder.h"
+
+namespace cineforge::media {
+
+// One decoded picture, tightly packed RGBA8.
+struct DecodedFrame {
+    std::int64_t ptsUs = -1;
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> rgba;
+};
+
+/**
+ * A decoder with a bounded ring of frames decoded ahead of where they
+ * are wanted, so that display never waits on decode.
+ *
+ * Two threads share it. The consumer (the render thread) asks for the
+ * frame at a time with frameAt(), which picks the queued frame with the
+ * nearest PTS and releases older ones, or announces with prime() where
+ * frames will be wanted, e.g. a clip starting just after the next cut.
+ * The producer (a decode thread) calls decodeStep() to queue one more
+ * frame while the ring has room, continuing forward from the last queued
+ * frame. A wanted time outside what the ring holds or will soon reach is
+ * a discontinuity: frameAt() or prime() empties the ring, and decoding
+ * restarts there through a DecodeScheduler.
+ *
+ * Slot buffers are reused, so steady playback allocates nothing. Only
+ * short bookkeeping happens under the lock; decoding and RGBA
+ * conversion do not.
+ */
+class FramePrefetcher {
+public:
+    static constexpr std::size_t kDefaultCapacity = 6;
+
+    // `decoder` must be open; it is only used from decodeStep().
+    explicit FramePrefetcher(std::unique_ptr<Decoder> decoder,
+                             std::size_t capacity = kDefaultCapacity);
+
+    FramePrefetcher(const FramePrefetcher&) = delete;
+    FramePrefetcher& operator=(const FramePrefetcher&) = delete;
+
+    // Consumer side.
+
+    // Queued frame nearest to `timeUs`, or nullptr if none is ready near
+    // it; also makes `timeUs` the wanted time. The frame stays valid until
+    // the consumer's next frameAt() or trim().
+    const DecodedFrame* frameAt(std::int64_t timeUs);
+    // Makes `timeUs` the wanted time without consuming anything.
+    void prime(std::int64_t timeUs);
+    // Drops every queued frame, frees their memory and stops decoding
+    // until the next frameAt() or prime().
+    void trim();
+
+    // Producer side.
+
+    // Decodes and queues at most one frame, waiting up to `timeoutUs` on
+    // the decoder. True if a frame was queued; false when there was
+    // nothing to do (ring full, nothing wanted, end of stream) or the
+    // decoder was not ready in time.
+    bool decodeStep(std::int64_t timeoutUs);
+    // Whether decodeStep() might queue a frame.
+    bool wantsDecode() const;
+
+    std::size_t capacity() const { return slots_.size(); }
+    std::size_t queued() const;
+
+private:
+    std::unique_ptr<Decoder> decoder_;
+    DecodeScheduler scheduler_; // producer only
+
+    mutable std::mutex mtx_;
+    std::vector<DecodedFrame> slots_;
+    std::size_t head_ = 0;  // oldest queued frame, the consumer's current one
+    std::size_t count_ = 0;
+    // Slot the producer is filling, outside the queued range; -1 if none.
+    std::ptrdiff_t filling_ = -1;
+    // Frame the consumer was last given. It is the head while queued, but
+    // the producer may drop the queue under it; the slot is not refilled
+    // until the consumer lets go.
+    std::ptrdiff_t held_ = -1;
+    // Bumped whenever the queue is dropped, so a frame decoded for the old
+    // position is not committed.
+    std::uint64_t generation_ = 0;
+    std::int64_t wantUs_ = -1;
+    // Decoder's frame duration as last seen by the producer, 0 if unknown.
+    std::int64_t frameUs_ = 0;
+    bool ended_ = false;
+
+    // Makes `timeUs` the wanted time, dropping the queue if it no longer
+    // leads there.
+    void retarget(std::int64_t timeUs);
+    void dropQueued();
+};
+
+} // namespace cineforge::media
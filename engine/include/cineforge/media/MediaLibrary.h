@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "cineforge/media/MediaSource.h"
+
+namespace cineforge::media {
+
+/**
+ * The media sources a project refers to, in import order. Clips name
+ * their source by id; this is where the id resolves to a path.
+ */
+class MediaLibrary {
+public:
+    // Adds `source`, or replaces the source with the same id in place.
+    void add(const MediaSource& source);
+    bool remove(Symbol id);
+    void clear();
+
+    // nullptr when the id is unknown. Invalidated by any edit.
+    const MediaSource* find(Symbol id) const;
+
+    const std::vector<MediaSource>& sources() const { return sources_; }
+    std::size_t size() const { return sources_.size(); }
+
+private:
+    std::vector<MediaSource> sources_;
+    std::unordered_map<Symbol, std::size_t> byId_;
+};
+
+} // namespace cineforge::media
@@ -2,10 +2,12 @@
 
 #include <string>
 
+#include "cineforge/core/Symbol.h"
+
 namespace cineforge::media {
 
 struct MediaSource {
-    std::string id;
+    Symbol id;
     std::string path;
     std::string proxyPath;
     std::string mediaType; // "video","audio","image"
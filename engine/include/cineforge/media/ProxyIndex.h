@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cineforge::media {
+
+struct ProxyIndexEntry {
+    std::string key;        // content address, also the proxy's file stem
+    std::string sourcePath; // where the source was last seen
+    std::string profile;    // transcoder settings the proxy was made with
+    std::string codec;
+    int width = 0;
+    int height = 0;
+    std::uint64_t bytes = 0;
+    std::int64_t lastUsed = 0; // milliseconds since the epoch
+};
+
+/**
+ * Persistent table of generated proxies, keyed by content address.
+ *
+ * Stored as a small versioned text file next to the proxies so that a
+ * fresh session can reuse them without touching the sources beyond their
+ * fingerprints. The class itself is not synchronised; ProxyManager guards
+ * it with its own lock and does the file I/O outside that lock.
+ */
+class ProxyIndex {
+public:
+    static constexpr const char* kFileName = "index.txt";
+    static constexpr int kVersion = 1;
+
+    // Replaces the contents with `file`'s. False (and empty) if the file
+    // is missing or from another version.
+    bool load(const std::string& file);
+    std::string serialize() const;
+    // Writes through a temporary file and a rename, so readers never see
+    // a torn index.
+    static bool writeFile(const std::string& file, const std::string& data);
+
+    const ProxyIndexEntry* find(const std::string& key) const;
+    // Most recently used entry made from `sourcePath`, for sources that
+    // are offline and cannot be fingerprinted.
+    const ProxyIndexEntry* findBySource(const std::string& sourcePath, int width,
+                                        const std::string& profile) const;
+
+    void put(ProxyIndexEntry entry);
+    bool erase(const std::string& key);
+
+    // Drops least recently used entries until the total is within `quota`,
+    // never dropping `keep`. Returns what was dropped so the caller can
+    // delete the files.
+    std::vector<ProxyIndexEntry> evict(std::uint64_t quota, const std::string& keep);
+
+    std::uint64_t totalBytes() const { return totalBytes_; }
+    std::size_t size() const { return entries_.size(); }
+
+private:
+    std::unordered_map<std::string, ProxyIndexEntry> entries_;
+    std::uint64_t totalBytes_ = 0;
+};
+
+} // namespace cineforge::media
@@ -1,10 +1,22 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "cineforge/media/MediaSource.h"
+#include "cineforge/media/ProxyIndex.h"
+#include "cineforge/media/SourceFingerprint.h"
 
 namespace cineforge::media {
 
@@ -16,27 +28,221 @@ struct ProxyInfo {
     bool valid = false;
 };
 
+// Result of ProxyManager::selectProxy().
+struct ProxySelection {
+    // Best tier available right now; invalid means "use the original".
+    ProxyInfo proxy;
+    // Tier that satisfies the viewport.
+    int wantedWidth = 0;
+    // `proxy` is a stand-in while the wanted tier is generated.
+    bool upgrading = false;
+};
+
 /**
- * Minimal proxy manager skeleton. The concrete implementation for now
- * will be a simple FFmpeg‑CLI invoker; later this can be replaced by a
- * proper libavfilter pipeline or platform‑specific transcoder.
+ * Generates and tracks low-resolution proxies of media sources.
+ *
+ * Proxy generation runs as jobs on a small pool of worker threads, so
+ * requests never block the caller and lookups never wait for a transcode.
+ * Concurrent requests for the same source and width share one job. Jobs
+ * run highest priority first (FIFO within a priority) and can be boosted,
+ * e.g. for clips near the playhead, or cancelled.
+ *
+ * Proxies are content addressed: each is named after a fingerprint of its
+ * source (see SourceFingerprint) and the proxy parameters, and recorded in
+ * a persistent ProxyIndex under the proxy root. A new session therefore
+ * reuses earlier proxies without transcoding, renamed or moved sources
+ * still match, and different files that share a name never collide.
+ * Index entries are checked against the proxy file on lookup, and the
+ * least recently used proxies are deleted once the disk quota is exceeded.
+ *
+ * Each source can have several proxy tiers (by default 480, 960 and 1920
+ * pixels wide) side by side. selectProxy() picks the tier for the current
+ * preview size and shows a lower one while the wanted tier is generated.
+ *
+ * The transcode itself is pluggable; the default invokes the FFmpeg CLI.
  */
 class ProxyManager {
 public:
+    using Callback = std::function<void(const ProxyInfo&)>;
+
+    // Writes a proxy of `src` scaled to `targetWidth` to `outputPath` and
+    // sets `height` to the proxy's height (left 0 if it cannot tell).
+    // Long-running implementations should poll `cancelled` and give up
+    // early when it is set.
+    using TranscodeFn = std::function<bool(const MediaSource& src, int targetWidth,
+                                           const std::string& outputPath,
+                                           const std::atomic<bool>& cancelled,
+                                           int& height)>;
+
+    // Priority used by ensureProxy(), above anything requested in the
+    // background.
+    static constexpr int kBlockingPriority = 1 << 30;
+    // Priority of tiers requested by selectProxy(): ahead of background
+    // imports, behind anything a caller is blocked on.
+    static constexpr int kPreviewPriority = 1 << 20;
+
+    static constexpr std::uint64_t kDefaultDiskQuota = std::uint64_t{10} << 30;
+
     ProxyManager(const std::string& ffmpegBinDir,
-                 const std::string& proxyRoot);
+                 const std::string& proxyRoot,
+                 std::size_t workers = 2);
+    ~ProxyManager();
+
+    ProxyManager(const ProxyManager&) = delete;
+    ProxyManager& operator=(const ProxyManager&) = delete;
 
+    /**
+     * Queues generation of a proxy and returns at once. A proxy already in
+     * the index resolves the future immediately; a pending job for the
+     * same source and width is joined (and raised to `priority` if that is
+     * higher). Other tiers of the source are left alone.
+     * `done` runs on the worker thread that finished the job, or inline
+     * if the proxy already exists, before the future becomes ready.
+     * Cancelled or failed jobs resolve with an invalid ProxyInfo.
+     */
+    std::shared_future<ProxyInfo> requestProxy(const MediaSource& src, int targetWidth,
+                                               int priority = 0, Callback done = {});
+
+    // Blocking form of requestProxy() at kBlockingPriority.
     ProxyInfo ensureProxy(const MediaSource& src, int targetWidth);
-    ProxyInfo getProxy(const std::string& sourceId) const;
-    void setProxy(const std::string& sourceId, const ProxyInfo& info);
+
+    // Raises every queued job of `sourceId` to at least `priority`.
+    void boost(Symbol sourceId, int priority);
+
+    // Cancels the queued or running job for (sourceId, targetWidth);
+    // false if there is none.
+    bool cancel(Symbol sourceId, int targetWidth);
+    void cancelAll();
+
+    // Jobs queued or running, not counting cancelled ones still winding
+    // down.
+    std::size_t pendingJobs() const;
+
+    /**
+     * Picks the smallest tier at least `viewportWidth * zoom` pixels wide
+     * (the largest tier if none is), where `viewportWidth` is the width
+     * the whole frame covers at zoom 1. If that tier is not ready yet it
+     * is requested at `priority`, and the largest ready tier below it is
+     * returned instead, or failing that the smallest ready one above it.
+     * When no smaller tier exists either, the smallest tier is requested
+     * as well because it is the quickest to produce. Tiers already queued
+     * are not requested again, nor are tiers whose transcode failed until
+     * the source file changes. Never waits for a transcode.
+     */
+    ProxySelection selectProxy(const MediaSource& src, int viewportWidth,
+                               double zoom = 1.0, int priority = kPreviewPriority);
+
+    // Proxy widths selectProxy() chooses between, ascending.
+    void setTiers(std::vector<int> widths);
+    std::vector<int> tiers() const;
+
+    // Largest ready tier of `sourceId`.
+    ProxyInfo getProxy(Symbol sourceId) const;
+    ProxyInfo getProxy(Symbol sourceId, int width) const;
+    // Ready tiers of `sourceId`, ascending by width.
+    std::vector<ProxyInfo> readyProxies(Symbol sourceId) const;
+    // Registers `info` as the tier of width `info.width`.
+    void setProxy(Symbol sourceId, const ProxyInfo& info);
+
+    // Replaces the transcoder for later requests. `profile` names its
+    // settings and is part of the content address, so proxies made with
+    // different settings are kept apart.
+    void setTranscoder(TranscodeFn fn, std::string profile = "custom");
+
+    // Deletes least recently used proxies as soon as the total exceeds
+    // `bytes`. The newest proxy is always kept, even when it alone is over.
+    void setDiskQuota(std::uint64_t bytes);
+    std::uint64_t diskQuota() const;
+    // Bytes of proxies recorded in the index.
+    std::uint64_t diskUsage() const;
+
+    // Writes pending index updates (recency only; everything else is saved
+    // as it happens). Also done on destruction.
+    void flushIndex();
 
 private:
+    struct JobKey {
+        Symbol source;
+        int width;
+
+        bool operator==(const JobKey& o) const {
+            return source == o.source && width == o.width;
+        }
+    };
+
+    struct JobKeyHash {
+        std::size_t operator()(const JobKey& k) const noexcept {
+            return std::hash<Symbol>()(k.source) * 31u +
+                   static_cast<std::size_t>(k.width);
+        }
+    };
+
+    struct Job {
+        JobKey key;
+        std::string indexKey;
+        SourceFingerprint fingerprint;
+        MediaSource source;
+        TranscodeFn transcode;
+        std::string profile;
+        int priority = 0;
+        std::uint64_t seq = 0;
+        bool running = false;
+        std::atomic<bool> cancelled{false};
+        std::promise<ProxyInfo> promise;
+        std::shared_future<ProxyInfo> future;
+        std::vector<Callback> callbacks;
+    };
+
     std::string ffmpegBinDir_;
     std::string proxyRoot_;
 
     mutable std::mutex mtx_;
-    std::unordered_map<std::string, ProxyInfo> map_;
+    std::condition_variable workAvailable_;
+    // Ready tiers per source, by width.
+    std::unordered_map<Symbol, std::map<int, ProxyInfo>> map_;
+    std::vector<int> tiers_{480, 960, 1920};
+    std::unordered_map<JobKey, std::shared_ptr<Job>, JobKeyHash> jobs_;
+    std::vector<std::shared_ptr<Job>> queue_;
+    // Last fingerprint of each source, reused while its path, size and
+    // modification time stay the same, and the tiers that failed to
+    // transcode from that version.
+    struct SourceState {
+        std::string path;
+        SourceFingerprint fingerprint;
+        std::vector<int> failedWidths;
+    };
+    std::unordered_map<Symbol, SourceState> sources_;
+    std::uint64_t nextSeq_ = 0;
+    TranscodeFn transcode_;
+    std::string profile_;
+    bool stop_ = false;
+
+    // Loaded lazily, also from const accessors.
+    mutable ProxyIndex index_;
+    bool indexDirty_ = false;
+    std::uint64_t indexGen_ = 0;
+    std::uint64_t diskQuota_ = kDefaultDiskQuota;
+    mutable std::once_flag indexLoaded_;
+    std::mutex fileMtx_;
+    std::uint64_t savedGen_ = 0;
+
+    std::size_t workerCount_;
+    std::vector<std::thread> workers_;
+
+    void workerLoop();
+    std::shared_ptr<Job> popJobLocked();
+    SourceFingerprint fingerprintSource(const MediaSource& src);
+    bool transcodeFailed(const MediaSource& src, int width);
+    void loadIndex() const;
+    void saveIndex();
+    void forgetProxiesLocked(const std::vector<ProxyIndexEntry>& evicted);
+    void removeProxyFiles(const std::vector<ProxyIndexEntry>& evicted) const;
+    std::string indexPath() const;
+    std::string proxyPathFor(const std::string& indexKey) const;
+    ProxyInfo infoFor(const ProxyIndexEntry& entry) const;
+    void finish(const std::shared_ptr<Job>& job, const ProxyInfo& info);
+    bool transcodeWithFfmpeg(const MediaSource& src, int targetWidth,
+                             const std::string& outputPath, int& height) const;
 };
 
 } // namespace cineforge::media
-
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cineforge::media {
+
+/**
+ * Cheap identity of a media file's contents: its size and modification
+ * time plus a hash of a few blocks sampled from the start, middle and end.
+ * Hashing whole camera originals would take longer than transcoding them,
+ * while the samples still tell apart files that merely share a name.
+ */
+struct SourceFingerprint {
+    std::uint64_t size = 0;
+    std::int64_t mtime = 0;
+    std::uint64_t sampleHash = 0;
+    bool valid = false;
+
+    bool operator==(const SourceFingerprint& o) const {
+        return valid == o.valid && size == o.size && mtime == o.mtime &&
+               sampleHash == o.sampleHash;
+    }
+    bool operator!=(const SourceFingerprint& o) const { return !(*this == o); }
+};
+
+// Bytes hashed at each sample position.
+inline constexpr std::size_t kFingerprintBlockSize = 64 * 1024;
+
+// Invalid if the file cannot be stat'ed or read.
+SourceFingerprint fingerprintFile(const std::string& path);
+
+// 64-bit FNV-1a, chainable through `seed`.
+std::uint64_t fnv1a64(const void* data, std::size_t size,
+                      std::uint64_t seed = 0xcbf29ce484222325ull);
+
+// 16 lowercase hex digits.
+std::string toHex64(std::uint64_t v);
+
+} // namespace cineforge::media
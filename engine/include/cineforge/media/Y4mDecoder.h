@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cineforge/io/MappedFile.h"
+#include "cineforge/media/Decoder.h"
+#include "cineforge/render/YuvConvert.h"
+
+namespace cineforge::media {
+
+/**
+ * Software Decoder over a YUV4MPEG2 (.y4m) file, such as the ones
+ * exporter::Y4mSink writes. Frames are read straight from a memory
+ * mapping, so decoding is deterministic and needs no platform codec; it
+ * is the backend decode, seek and prefetch logic runs against off-device.
+ *
+ * Every frame of a y4m file could be read directly, but to behave like a
+ * compressed stream only every `gopLength`-th frame is a sync sample:
+ * seekToUs() lands on the sync sample at or before the target and frames
+ * must be decoded forward from there.
+ *
+ * Only 8-bit 4:2:0 streams are supported. Samples are BT.601, limited
+ * range unless the header says XCOLORRANGE=FULL.
+ */
+class Y4mDecoder : public Decoder {
+public:
+    explicit Y4mDecoder(std::string path, int gopLength = 30);
+    ~Y4mDecoder() override;
+
+    bool open() override;
+    void close() override;
+
+    bool seekToUs(std::int64_t timeUs) override;
+    bool decodeNext(std::int64_t timeoutUs = 0) override;
+    bool endOfStream() const override { return ended_; }
+
+    std::int64_t framePtsUs() const override;
+    bool readRgba(std::uint8_t* dst, int stride) override;
+    std::int64_t syncSampleUs(std::int64_t timeUs) override;
+
+    int width() const override { return width_; }
+    int height() const override { return height_; }
+    std::int64_t durationUs() const override;
+    // Rounded down, so pts + frameDurationUs() never passes the next frame.
+    std::int64_t frameDurationUs() const override;
+
+    std::int64_t frameCount() const { return static_cast<std::int64_t>(frames_.size()); }
+    // Presentation time of frame `index`.
+    std::int64_t ptsOf(std::int64_t index) const;
+
+private:
+    std::string path_;
+    int gopLength_;
+    io::MappedFile file_;
+    int width_ = 0;
+    int height_ = 0;
+    int fpsNum_ = 0;
+    int fpsDen_ = 1;
+    render::YuvRange range_ = render::YuvRange::Limited;
+    std::vector<std::size_t> frames_; // offset of each frame's Y plane
+
+    std::int64_t next_ = 0;     // frame decodeNext() returns
+    std::int64_t current_ = -1; // current frame, -1 for none
+    bool ended_ = false;
+
+    bool parseHeader(std::size_t& offset);
+    // First frame of the GOP holding the frame shown at timeUs.
+    std::int64_t syncFrameAt(std::int64_t timeUs) const;
+};
+
+} // namespace cineforge::media
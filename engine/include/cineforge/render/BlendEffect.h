@@ -0,0 +1,46 @@
+#pragma once
+
+#include "cineforge/render/Effect.h"
+
+namespace cineforge::render {
+
+enum class BlendMode {
+    Normal,   // source-over
+    Add,
+    Multiply,
+    Screen,
+    Dissolve  // straight mix of two inputs, for cross-fade transitions
+};
+
+/**
+ * Layers inputs[1..] over inputs[0] in order, each weighted by its alpha
+ * and the effect's opacity. In Dissolve mode it takes exactly two inputs
+ * and opacity is the transition progress.
+ *
+ * Runs on the CPU when every frame carries RGBA8/BGRA8 cpuData; GPU
+ * backends are expected to bind their own blend pass.
+ */
+class BlendEffect : public CompositeEffect {
+public:
+    explicit BlendEffect(BlendMode mode = BlendMode::Normal, float opacity = 1.0f);
+
+    const char* id() const override { return "blend"; }
+    EffectAccess access() const override { return EffectAccess::PerPixel; }
+    std::size_t inputCount() const override;
+
+    void setMode(BlendMode mode);
+    BlendMode mode() const { return mode_; }
+
+    // Clamped to [0, 1].
+    void setOpacity(float opacity);
+    float opacity() const { return opacity_; }
+
+    void process(const Frame* const* inputs, std::size_t count,
+                 Frame& output) override;
+
+private:
+    BlendMode mode_;
+    float opacity_ = 1.0f;
+};
+
+} // namespace cineforge::render
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "cineforge/render/Effect.h"
+
+namespace cineforge::render {
+
+/**
+ * Brightness / contrast / saturation grade.
+ *
+ * Matches the app's TextureRenderer shader: rgb is scaled by brightness,
+ * contrast pivots around mid grey, and saturation mixes towards BT.601
+ * luma (0.299, 0.587, 0.114). Alpha passes through unchanged.
+ *
+ * The whole grade is one ColorMatrix, so the CPU path is
+ * applyColorMatrix() and consecutive grades fuse into a single pass.
+ */
+class ColorGradeEffect : public Effect {
+public:
+    ColorGradeEffect(float brightness = 1.0f, float contrast = 1.0f,
+                     float saturation = 1.0f);
+
+    const char* id() const override { return "color_grade"; }
+    EffectAccess access() const override { return EffectAccess::PerPixel; }
+
+    void setParams(float brightness, float contrast, float saturation);
+    float brightness() const { return brightness_; }
+    float contrast() const { return contrast_; }
+    float saturation() const { return saturation_; }
+
+    bool colorMatrix(ColorMatrix& out) const override;
+
+    void process(const Frame& input, Frame& output) override;
+
+private:
+    float brightness_;
+    float contrast_;
+    float saturation_;
+};
+
+} // namespace cineforge::render
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+
+#include "cineforge/render/Frame.h"
+
+namespace cineforge::render {
+
+/**
+ * Affine colour transform on normalized RGBA:
+ *
+ *   out[i] = m[i][0] * r + m[i][1] * g + m[i][2] * b + m[i][3] * a + m[i][4]
+ *
+ * with the result clamped to [0, 1]. Brightness, contrast, saturation,
+ * channel mixing and tints are all of this form, and any chain of them
+ * composes into a single matrix.
+ *
+ * Composing skips the clamp (and 8-bit rounding) that separate passes
+ * apply between steps, so a fused chain can differ from running the
+ * effects one by one wherever an intermediate leaves [0, 1]: e.g.
+ * brightening by 2x and then halving restores highlights that the
+ * unfused chain clips. This is the same result a single shader gives.
+ */
+struct ColorMatrix {
+    float m[4][5];
+
+    static ColorMatrix identity();
+};
+
+// `after` applied to the output of `before`.
+ColorMatrix compose(const ColorMatrix& after, const ColorMatrix& before);
+
+// Applies `m` to rows [y0, y1) of a packed (RGBA8/BGRA8) CPU frame. Uses
+// SSE2 or NEON when available; define CINEFORGE_NO_SIMD to force scalar.
+void applyColorMatrix(const Frame& input, Frame& output, const ColorMatrix& m,
+                      int y0, int y1);
+
+// GLSL ES function `vec4 <name>(vec4 c)` applying `m` with constants
+// baked in, for backends that fuse a chain into one fragment shader.
+std::string colorMatrixGlsl(const ColorMatrix& m, const std::string& name);
+
+} // namespace cineforge::render
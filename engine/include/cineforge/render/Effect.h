@@ -1,9 +1,30 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "cineforge/render/ColorMatrix.h"
 #include "cineforge/render/Frame.h"
 
 namespace cineforge::render {
 
+// Which input pixels an effect reads to produce one output pixel. This
+// decides whether CPU frames may be split into stripes and processed in
+// parallel.
+enum class EffectAccess {
+    PerPixel,      // only the same pixel; any row range can be processed alone
+    Neighbourhood, // nearby rows too; must override processRows()
+    WholeFrame     // arbitrary pixels; always processed in one call
+};
+
+// Process-wide, so the newest stamp among a graph's effects changes
+// whenever any of them does; see RenderGraph::revision().
+inline std::uint64_t nextParamsRevision() {
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
 class Effect {
 public:
     virtual ~Effect() = default;
@@ -11,9 +32,81 @@ public:
     // Unique identifier for debugging / profiling.
     virtual const char* id() const = 0;
 
+    virtual EffectAccess access() const { return EffectAccess::WholeFrame; }
+
+    // PerPixel effects that are an affine colour transform describe it
+    // here so that RenderGraph can fuse runs of them into one pass. Whether
+    // an effect returns true must not change once it is in a graph; the
+    // matrix itself may change between frames.
+    virtual bool colorMatrix(ColorMatrix& /*out*/) const { return false; }
+
     // Process a single frame. Implementations are free to assume that
     // input and output refer to different underlying textures.
     virtual void process(const Frame& input, Frame& output) = 0;
+
+    // Writes output rows [y0, y1) of a CPU frame; may be called
+    // concurrently for disjoint ranges. The default runs process() on row
+    // views, which is only correct for PerPixel effects. Neighbourhood
+    // effects override it and read whatever input rows they need.
+    virtual void processRows(const Frame& input, Frame& output, int y0, int y1) {
+        Frame out = cpuRowView(output, y0, y1);
+        process(cpuRowView(input, y0, y1), out);
+    }
+
+    // Stamp of the last parameter change; 0 if there was none.
+    std::uint64_t paramsRevision() const { return paramsRevision_; }
+
+protected:
+    // Setters call this when a change alters the output, so that cached
+    // renders made with the old parameters are dropped.
+    void paramsChanged() { paramsRevision_ = nextParamsRevision(); }
+
+private:
+    std::uint64_t paramsRevision_ = 0;
+};
+
+/**
+ * Effect that combines several frames into one: blends, layer composites,
+ * transitions. inputs[0] is the bottom layer.
+ */
+class CompositeEffect {
+public:
+    virtual ~CompositeEffect() = default;
+
+    virtual const char* id() const = 0;
+
+    // Number of inputs the effect expects; 0 accepts any non-zero count.
+    virtual std::size_t inputCount() const { return 0; }
+
+    virtual EffectAccess access() const { return EffectAccess::WholeFrame; }
+
+    // `output` never aliases any of the inputs.
+    virtual void process(const Frame* const* inputs, std::size_t count,
+                         Frame& output) = 0;
+
+    // Row-range counterpart of process(); see Effect::processRows().
+    // Callers never split composites with more than kMaxRowInputs inputs.
+    static constexpr std::size_t kMaxRowInputs = 16;
+    virtual void processRows(const Frame* const* inputs, std::size_t count,
+                             Frame& output, int y0, int y1) {
+        Frame views[kMaxRowInputs];
+        const Frame* ptrs[kMaxRowInputs];
+        for (std::size_t i = 0; i < count; ++i) {
+            views[i] = cpuRowView(*inputs[i], y0, y1);
+            ptrs[i] = &views[i];
+        }
+        Frame out = cpuRowView(output, y0, y1);
+        process(ptrs, count, out);
+    }
+
+    // See Effect::paramsRevision().
+    std::uint64_t paramsRevision() const { return paramsRevision_; }
+
+protected:
+    void paramsChanged() { paramsRevision_ = nextParamsRevision(); }
+
+private:
+    std::uint64_t paramsRevision_ = 0;
 };
 
 } // namespace cineforge::render
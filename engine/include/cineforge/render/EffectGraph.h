@@ -1,30 +1,38 @@
 #pragma once
 
 #include <memory>
-#include <vector>
 
 #include "cineforge/render/Effect.h"
-#include "cineforge/render/FrameBuffer.h"
+#include "cineforge/render/FrameBufferPool.h"
+#include "cineforge/render/RenderGraph.h"
 
 namespace cineforge::render {
 
 /**
- * Linear effect chain with ping‑pong framebuffers.
+ * Linear effect chain.
  *
- * This intentionally keeps the model simple for now; it can be replaced
- * by a more general node‑based render graph later without changing the
- * public engine facade.
+ * Convenience front end over RenderGraph for the common single-source
+ * case; build a RenderGraph directly for multi-input compositing.
  */
 class EffectGraph {
 public:
+    EffectGraph();
+
     void addEffect(std::unique_ptr<Effect> effect);
     void clear();
 
-    void process(const Frame& sourceFrame, Frame& outFrame) const;
+    // Intermediate buffers come from `pool`, or the shared pool if null.
+    void process(const Frame& sourceFrame, Frame& outFrame,
+                 FrameBufferPool* pool = nullptr) const;
+
+    // See RenderGraph::setThreadPool().
+    void setThreadPool(ThreadPool* pool) { graph_.setThreadPool(pool); }
+
+    const RenderGraph& graph() const { return graph_; }
 
 private:
-    std::vector<std::unique_ptr<Effect>> effects_;
+    RenderGraph graph_;
+    RenderGraph::NodeId tail_ = RenderGraph::kNoNode;
 };
 
 } // namespace cineforge::render
-
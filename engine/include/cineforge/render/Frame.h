@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace cineforge::render {
@@ -10,6 +11,13 @@ enum class PixelFormat {
     NV12
 };
 
+// Bytes needed to store a width x height image in `fmt`.
+inline std::size_t frameByteSize(int width, int height, PixelFormat fmt) {
+    const auto pixels = static_cast<std::size_t>(width > 0 ? width : 0) *
+                        static_cast<std::size_t>(height > 0 ? height : 0);
+    return fmt == PixelFormat::NV12 ? pixels + pixels / 2 : pixels * 4;
+}
+
 struct GPUTextureHandle {
     // Backend-specific opaque handle (Vulkan image, Metal texture, etc.).
     uint64_t id = 0;
@@ -27,5 +35,13 @@ struct Frame {
     int cpuStride = 0;
 };
 
+// Rows [y0, y1) of a packed (RGBA8/BGRA8) CPU frame, sharing its storage.
+inline Frame cpuRowView(const Frame& f, int y0, int y1) {
+    Frame view = f;
+    view.height = y1 - y0;
+    view.cpuData = f.cpuData + static_cast<std::size_t>(y0) * static_cast<std::size_t>(f.cpuStride);
+    return view;
+}
+
 } // namespace cineforge::render
 
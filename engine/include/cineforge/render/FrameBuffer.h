@@ -1,32 +1,50 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
 #include "cineforge/render/Frame.h"
 
 namespace cineforge::render {
 
+enum class FrameBackend {
+    Gpu, // opaque texture handle only; pixels live on the device
+    Cpu  // host memory exposed through Frame::cpuData / cpuStride
+};
+
 /**
  * Lightweight wrapper around a GPU-backed framebuffer/texture.
  *
- * The concrete allocation is delegated to the GPU backend; for now this
+ * The concrete GPU allocation is delegated to the backend; for now this
  * class only tracks dimensions and lifetime. Backends should specialize
  * create/destroy to integrate with Vulkan/Metal/D3D/WebGPU.
+ *
+ * The Cpu backend really allocates the pixels, with rows aligned to
+ * kRowAlignment bytes, which makes it usable for headless rendering and
+ * as a software fallback.
  */
 class FrameBuffer {
 public:
-    FrameBuffer(int width, int height, PixelFormat fmt);
+    static constexpr std::size_t kRowAlignment = 64;
+
+    FrameBuffer(int width, int height, PixelFormat fmt,
+                FrameBackend backend = FrameBackend::Gpu);
     ~FrameBuffer();
 
     Frame& frame() { return frame_; }
     const Frame& frame() const { return frame_; }
+    FrameBackend backend() const { return backend_; }
 
     void resize(int width, int height);
 
 private:
     Frame frame_{};
+    FrameBackend backend_;
+    std::unique_ptr<std::uint8_t[]> storage_;
 
     void createTexture();
     void destroyTexture();
 };
 
 } // namespace cineforge::render
-
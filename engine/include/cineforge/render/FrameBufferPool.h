@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cineforge/render/FrameBuffer.h"
+
+namespace cineforge::render {
+
+/**
+ * Recycles FrameBuffers by (width, height, format) bucket.
+ *
+ * acquire() hands out an idle buffer of the requested shape when one
+ * exists and only allocates otherwise, so steady-state rendering does not
+ * create or destroy textures. Released buffers are kept for reuse as long
+ * as the pool's total footprint (in use + idle) stays under the memory
+ * limit; beyond it they are freed, oldest idle buffers first. The limit
+ * never fails an acquire: buffers in use are bounded by their owners
+ * (e.g. the FrameCache budget), not by the pool.
+ *
+ * All buffers are created on the pool's backend; a pool serving the Cpu
+ * backend gives headless rendering with real pixels.
+ *
+ * The pool is thread-safe. It must outlive every Handle it hands out.
+ */
+class FrameBufferPool {
+public:
+    struct Stats {
+        std::uint64_t allocations = 0; // buffers created
+        std::uint64_t reuses = 0;      // acquires served from idle buffers
+        std::uint64_t frees = 0;       // buffers destroyed
+        std::size_t bytesInUse = 0;
+        std::size_t bytesIdle = 0;
+        std::size_t peakBytes = 0;     // high-water mark of in use + idle
+        std::size_t buffersInUse = 0;
+        std::size_t buffersIdle = 0;
+    };
+
+    /**
+     * Owning reference to a pooled buffer; returns it to the pool when
+     * destroyed or reset.
+     */
+    class Handle {
+    public:
+        Handle() = default;
+        ~Handle() { reset(); }
+
+        Handle(Handle&& other) noexcept
+            : pool_(other.pool_), buffer_(std::move(other.buffer_)) {
+            other.pool_ = nullptr;
+        }
+        Handle& operator=(Handle&& other) noexcept;
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+
+        explicit operator bool() const { return buffer_ != nullptr; }
+        FrameBuffer* get() const { return buffer_.get(); }
+        FrameBuffer* operator->() const { return buffer_.get(); }
+        Frame& frame() const { return buffer_->frame(); }
+
+        void reset();
+
+    private:
+        friend class FrameBufferPool;
+
+        Handle(FrameBufferPool* pool, std::unique_ptr<FrameBuffer> buffer)
+            : pool_(pool), buffer_(std::move(buffer)) {}
+
+        FrameBufferPool* pool_ = nullptr;
+        std::unique_ptr<FrameBuffer> buffer_;
+    };
+
+    explicit FrameBufferPool(std::size_t memoryLimit = std::size_t{512} << 20,
+                             FrameBackend backend = FrameBackend::Gpu);
+    ~FrameBufferPool();
+
+    FrameBufferPool(const FrameBufferPool&) = delete;
+    FrameBufferPool& operator=(const FrameBufferPool&) = delete;
+
+    // Process-wide pool used when no explicit pool is configured.
+    static FrameBufferPool& shared();
+
+    Handle acquire(int width, int height, PixelFormat fmt);
+
+    // Buffers handed out from now on use `backend`; idle buffers of the
+    // old backend are freed.
+    void setBackend(FrameBackend backend);
+    FrameBackend backend() const;
+
+    void setMemoryLimit(std::size_t bytes);
+    std::size_t memoryLimit() const;
+
+    // Frees all idle buffers.
+    void trim();
+
+    Stats stats() const;
+
+private:
+    struct BucketKey {
+        int width;
+        int height;
+        PixelFormat format;
+        FrameBackend backend;
+
+        bool operator==(const BucketKey& o) const {
+            return width == o.width && height == o.height &&
+                   format == o.format && backend == o.backend;
+        }
+    };
+
+    struct BucketHash {
+        std::size_t operator()(const BucketKey& k) const noexcept;
+    };
+
+    struct IdleBuffer {
+        std::unique_ptr<FrameBuffer> buffer;
+        std::uint64_t releasedAt = 0;
+    };
+
+    mutable std::mutex mtx_;
+    std::size_t limit_;
+    FrameBackend backend_;
+    std::uint64_t clock_ = 0;
+    std::unordered_map<BucketKey, std::vector<IdleBuffer>, BucketHash> idle_;
+    Stats stats_;
+
+    void release(std::unique_ptr<FrameBuffer> buffer);
+    void evictIdleLocked(std::size_t limit);
+};
+
+} // namespace cineforge::render
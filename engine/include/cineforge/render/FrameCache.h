@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+#include "cineforge/core/DirtyRegions.h"
+#include "cineforge/render/FrameBufferPool.h"
+
+namespace cineforge::render {
+
+/**
+ * Bounded LRU cache of rendered output frames.
+ *
+ * Entries are keyed by quantized timeline time and target size, and
+ * remember the content revision they were rendered at. The cache only
+ * stores and evicts; deciding whether an entry is still current is up to
+ * the renderer, which can re-stamp an entry when nothing affecting its
+ * time slot changed, or re-render into the entry's buffer in place.
+ */
+class FrameCache {
+public:
+    struct Entry {
+        std::int64_t tick = 0;
+        int width = 0;
+        int height = 0;
+        Revision revision = 0;
+        // Timeline time covered by this entry's tick: [t0, t1).
+        double t0 = 0.0;
+        double t1 = 0.0;
+        FrameBufferPool::Handle buffer;
+        std::size_t bytes = 0;
+    };
+
+    struct Stats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        std::size_t entries = 0;
+        std::size_t bytes = 0;
+    };
+
+    explicit FrameCache(std::size_t budgetBytes = std::size_t{256} << 20,
+                        double ticksPerSecond = 1000.0);
+
+    // Pool that entry buffers are drawn from and returned to on eviction;
+    // the shared pool by default. Changing it clears the cache.
+    void setFrameBufferPool(FrameBufferPool* pool);
+
+    // Memory budget for all cached frames; 0 disables caching.
+    void setBudget(std::size_t budgetBytes);
+    std::size_t budget() const { return budget_; }
+
+    // Time quantum; ideally the project frame rate so that every frame
+    // maps to its own tick.
+    void setTicksPerSecond(double ticksPerSecond);
+    double ticksPerSecond() const { return ticksPerSecond_; }
+
+    // Returns the entry for (time, size) and marks it most recently used,
+    // or nullptr on a miss.
+    Entry* lookup(double time, int width, int height);
+
+    // Creates the entry for (time, size) with a buffer to render into,
+    // evicting least recently used entries to stay within budget. Returns
+    // nullptr if a single frame of this size exceeds the budget.
+    Entry* insert(double time, int width, int height, PixelFormat fmt,
+                  Revision revision);
+
+    // Drops every entry whose time slot overlaps [t0, t1).
+    void invalidate(double t0, double t1);
+    void clear();
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Key {
+        std::int64_t tick;
+        int width;
+        int height;
+
+        bool operator==(const Key& o) const {
+            return tick == o.tick && width == o.width && height == o.height;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const noexcept;
+    };
+
+    using LruList = std::list<Entry>; // front = most recently used
+
+    std::size_t budget_;
+    double ticksPerSecond_;
+    FrameBufferPool* pool_;
+    LruList lru_;
+    std::unordered_map<Key, LruList::iterator, KeyHash> map_;
+    Stats stats_;
+
+    std::int64_t tickFor(double time) const;
+    void evictTo(std::size_t budget);
+    void erase(LruList::iterator it);
+};
+
+} // namespace cineforge::render
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "cineforge/core/ThreadPool.h"
+#include "cineforge/render/Effect.h"
+#include "cineforge/render/FrameBufferPool.h"
+
+namespace cineforge::render {
+
+/**
+ * Directed acyclic graph of effects.
+ *
+ * Source nodes stand for the frames passed to process(), effect nodes
+ * transform one input and composite nodes combine several (track
+ * compositing, blends, transitions). Only the ancestors of the output node
+ * are run, in a depth-first topological order.
+ *
+ * Intermediate results live in pooled buffers that match the output
+ * frame. Buffers are assigned ahead of time from each result's last use,
+ * so a buffer is handed to the next node as soon as its last consumer has
+ * run and peak memory tracks the widest point of the graph, not its size.
+ *
+ * Nodes whose effect is not WholeFrame run on CPU frames as horizontal
+ * stripes spread over a thread pool.
+ *
+ * Chains of PerPixel effects that expose a ColorMatrix, where each result
+ * feeds only the next effect, are fused: the matrices are composed every
+ * frame and applied in one pass, skipping the intermediate frames. See
+ * ColorMatrix for how that can differ from running the effects apart.
+ *
+ * The schedule is rebuilt lazily after edits, so process() must not be
+ * called concurrently with itself or with edits.
+ */
+class RenderGraph {
+public:
+    using NodeId = std::uint32_t;
+    static constexpr NodeId kNoNode = std::numeric_limits<NodeId>::max();
+
+    // Node reading sources[slot] in process().
+    NodeId addSource(std::size_t slot = 0);
+    // These return kNoNode, and take no ownership, if an input is unknown.
+    NodeId addEffect(std::unique_ptr<Effect> effect, NodeId input);
+    NodeId addComposite(std::unique_ptr<CompositeEffect> effect,
+                        std::vector<NodeId> inputs);
+
+    // Rewires an existing node. Edits that would create a cycle are
+    // accepted but make the graph invalid until fixed.
+    bool setInputs(NodeId node, std::vector<NodeId> inputs);
+    void setOutput(NodeId node);
+    NodeId output() const { return output_; }
+
+    void clear();
+    std::size_t nodeCount() const { return nodes_.size(); }
+
+    // Fusion is on by default; turn it off to get exactly the clamping
+    // behaviour of running every effect separately.
+    void setFusion(bool enabled);
+    bool fusion() const { return fusion_; }
+
+    // Pool that CPU stripes are spread over; the shared pool by default.
+    // Null runs every node on the calling thread.
+    void setThreadPool(ThreadPool* pool);
+
+    // Validates and schedules the graph; false if there is no output, a
+    // cycle, or a node with the wrong number of inputs.
+    bool compile() const;
+
+    // Valid after a successful compile().
+    std::size_t scheduledNodes() const { return steps_.size(); }
+    std::size_t intermediateBuffers() const { return registerCount_; }
+    // Effects that run inside fused chains, each chain's last one included.
+    std::size_t fusedEffects() const { return fused_.size(); }
+
+    // Changes whenever the graph is edited or one of its effects reports a
+    // parameter change, so output rendered earlier can be recognised as
+    // stale.
+    std::uint64_t revision() const;
+
+    // Renders the output node into `outFrame`. Intermediates come from
+    // `pool`, or the shared pool if null. Returns false if the graph is
+    // invalid or reads a source slot past `sourceCount`.
+    bool process(const Frame* const* sources, std::size_t sourceCount,
+                 Frame& outFrame, FrameBufferPool* pool = nullptr) const;
+    bool process(const Frame& source, Frame& outFrame,
+                 FrameBufferPool* pool = nullptr) const {
+        const Frame* sources[] = {&source};
+        return process(sources, 1, outFrame, pool);
+    }
+
+private:
+    enum class NodeKind : std::uint8_t { Source, Effect, Composite };
+
+    struct Node {
+        NodeKind kind = NodeKind::Source;
+        std::size_t slot = 0;
+        std::unique_ptr<Effect> effect;
+        std::unique_ptr<CompositeEffect> composite;
+        std::vector<NodeId> inputs;
+    };
+
+    // Where a step reads an input from: >= 0 is an intermediate register,
+    // < 0 is source slot -(operand + 1).
+    using Operand = std::int32_t;
+
+    struct Step {
+        NodeId node;
+        std::uint32_t firstOperand;
+        std::uint32_t operandCount;
+        std::int32_t target; // register, or -1 for the output frame
+        std::uint32_t firstFused; // chain in fused_, head first
+        std::uint32_t fusedCount; // 0 unless this step is a fused chain
+    };
+
+    // Stripes below these sizes cost more to schedule than they save.
+    static constexpr int kMinStripeRows = 8;
+    static constexpr std::size_t kMinStripePixels = 16384;
+
+    std::vector<Node> nodes_;
+    NodeId output_ = kNoNode;
+    ThreadPool* threads_ = nullptr;
+    bool sharedThreads_ = true;
+    bool fusion_ = true;
+    std::uint64_t editRevision_ = 0;
+
+    mutable bool dirty_ = true;
+    mutable bool valid_ = false;
+    mutable std::vector<Step> steps_;
+    mutable std::vector<Operand> operands_;
+    mutable std::vector<NodeId> fused_;
+    mutable std::size_t registerCount_ = 0;
+    mutable Operand outputSource_ = 0; // output is a source node when < 0
+    mutable std::size_t maxSlot_ = 0;
+    // process() scratch, sized by compile(); registers are empty between
+    // calls.
+    mutable std::vector<FrameBufferPool::Handle> regs_;
+    mutable std::vector<const Frame*> inputs_;
+
+    void edited();
+    bool validInputs(const std::vector<NodeId>& inputs) const;
+    bool fusable(NodeId id) const;
+    int stripesFor(const Frame* const* inputs, std::size_t count,
+                   const Frame& target, ThreadPool* pool) const;
+    void run(const Node& node, const Frame* const* inputs, std::size_t count,
+             Frame& target) const;
+    void runFused(const Step& step, const Frame& input, Frame& target,
+                  FrameBufferPool& buffers) const;
+    bool schedule(std::vector<NodeId>& order) const;
+};
+
+} // namespace cineforge::render
@@ -1,9 +1,12 @@
 #pragma once
 
-#include <memory>
+#include <cstdint>
+#include <functional>
 
-#include "cineforge/render/FrameBuffer.h"
+#include "cineforge/core/DirtyRegions.h"
 #include "cineforge/render/EffectGraph.h"
+#include "cineforge/render/FrameBufferPool.h"
+#include "cineforge/render/FrameCache.h"
 
 namespace cineforge::render {
 
@@ -11,26 +14,57 @@ struct RenderContext {
     int targetWidth = 0;
     int targetHeight = 0;
     double timeSeconds = 0.0;
+    // Content revision of the project being rendered. 0 means "unknown"
+    // and bypasses the frame cache.
+    Revision revision = 0;
 };
 
 /**
  * High‑level preview/export renderer entrypoint.
+ *
+ * Preview output is served from a FrameCache when possible. A cached
+ * frame from an older revision is reused as long as the change query
+ * reports that nothing affecting its time slot changed since. Edits to the
+ * effect graph, including effect parameter changes, are picked up from
+ * RenderGraph::revision() and drop the whole cache.
  */
 class Renderer {
 public:
+    // Answers "did anything affecting [t0, t1) change since `since`?".
+    using ChangeQuery =
+        std::function<bool(Revision since, double t0, double t1)>;
+
     Renderer();
 
     void setEffectGraph(const EffectGraph* graph);
+    void setChangeQuery(ChangeQuery query);
+
+    // Pool for all render targets and intermediates; the shared pool by
+    // default. Must outlive the renderer.
+    void setFrameBufferPool(FrameBufferPool* pool);
+    FrameBufferPool& frameBufferPool() { return *pool_; }
 
+    // The returned frame stays valid until the next render call.
     Frame renderPreview(const RenderContext& ctx);
 
+    FrameCache& frameCache() { return cache_; }
+    const FrameCache& frameCache() const { return cache_; }
+
+    // Drops cached frames overlapping [t0, t1), for changes neither the
+    // change query nor the graph revision can see (e.g. an effect reading
+    // state outside its parameters).
+    void invalidate(double t0, double t1) { cache_.invalidate(t0, t1); }
+
 private:
     const EffectGraph* graph_ = nullptr;
-    std::unique_ptr<FrameBuffer> ping_;
-    std::unique_ptr<FrameBuffer> pong_;
+    FrameBufferPool* pool_ = &FrameBufferPool::shared();
+    FrameBufferPool::Handle ping_;
+    FrameBufferPool::Handle pong_;
+    ChangeQuery changeQuery_;
+    FrameCache cache_;
+    std::uint64_t graphRevision_ = 0; // of graph_ when the cache was filled
 
     void ensureBuffers(int w, int h);
 };
 
 } // namespace cineforge::render
-
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+#include "cineforge/render/Frame.h"
+
+namespace cineforge::render {
+
+// 4:2:0 layouts decoders hand out. NV12 interleaves chroma as U,V pairs,
+// NV21 as V,U; I420 has separate U and V planes.
+enum class YuvLayout {
+    NV12,
+    NV21,
+    I420
+};
+
+enum class YuvMatrix {
+    BT601,
+    BT709
+};
+
+enum class YuvRange {
+    Limited, // Y in [16, 235], chroma in [16, 240]
+    Full
+};
+
+/**
+ * A borrowed 4:2:0 image. For NV12/NV21, `u` is the interleaved chroma
+ * plane and `v` is unused; for I420 `u` and `v` share `uvStride`. Strides
+ * are in bytes and may exceed the visible width, as decoder buffers
+ * usually do. Odd sizes are allowed: chroma rows and columns cover
+ * (size + 1) / 2 samples.
+ */
+struct YuvImage {
+    int width = 0;
+    int height = 0;
+    YuvLayout layout = YuvLayout::NV12;
+    const std::uint8_t* y = nullptr;
+    const std::uint8_t* u = nullptr;
+    const std::uint8_t* v = nullptr;
+    int yStride = 0;
+    int uvStride = 0;
+};
+
+enum class YuvKernel {
+    Auto, // best available on this CPU
+    Scalar,
+    Sse2,
+    Avx2,
+    Neon
+};
+
+// Whether `kernel` is compiled in and supported by this CPU. AVX2 is
+// detected at run time; SSE2 and NEON follow the build target, and
+// CINEFORGE_NO_SIMD leaves only Scalar.
+bool yuvKernelAvailable(YuvKernel kernel);
+
+/**
+ * Converts rows [y0, y1) of `src` into an RGBA8 CPU frame, so callers can
+ * split a frame into stripes across threads. Chroma is nearest-sampled.
+ *
+ * All kernels use the same 6-bit fixed-point arithmetic and produce
+ * identical bytes; Scalar is the reference. Values are within 3 levels of
+ * the exact float conversion. An unavailable kernel falls back to Auto.
+ */
+void yuvToRgba(const YuvImage& src, YuvMatrix matrix, YuvRange range, Frame& output,
+               int y0, int y1, YuvKernel kernel = YuvKernel::Auto);
+
+} // namespace cineforge::render
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace cineforge::timeline {
+
+struct Clip;
+
+/**
+ * Static interval index over a start‑sorted clip list.
+ *
+ * The clips themselves are the leaves of an implicit, in‑order binary
+ * tree laid out over the array; every node additionally stores the
+ * maximum end time of its subtree. Overlap queries then only descend into
+ * subtrees that can still contain a hit, giving O(log n + k) lookups with
+ * no per‑node allocations and a cache‑friendly, structure‑of‑arrays layout.
+ *
+ * The index refers to clips by position, so it must be rebuilt whenever
+ * the underlying vector changes.
+ */
+class IntervalIndex {
+public:
+    // Rebuilds the index. `clips` must be sorted by start time.
+    void build(const std::vector<Clip>& clips);
+    void clear();
+
+    std::size_t size() const { return starts_.size(); }
+
+    // Calls fn(i) for every interval i with start < hi && end > lo, in
+    // ascending position (i.e. start) order.
+    template <typename Fn>
+    void forEachOverlap(double lo, double hi, Fn&& fn) const;
+
+private:
+    std::vector<double> starts_;
+    std::vector<double> ends_;
+    std::vector<double> maxEnds_; // max end time of the subtree rooted at i
+    int rootLevel_ = -1;
+};
+
+template <typename Fn>
+void IntervalIndex::forEachOverlap(double lo, double hi, Fn&& fn) const {
+    if (rootLevel_ < 0) {
+        return;
+    }
+
+    struct Node {
+        std::size_t x;
+        int level;
+        bool leftDone;
+    };
+
+    const std::size_t n = starts_.size();
+    Node stack[64];
+    int top = 0;
+    stack[top++] = {(std::size_t{1} << rootLevel_) - 1, rootLevel_, false};
+
+    while (top > 0) {
+        const Node z = stack[--top];
+        if (z.level <= 3) {
+            // Small subtree: a linear scan is cheaper than descending.
+            const std::size_t i0 = z.x >> z.level << z.level;
+            std::size_t i1 = i0 + (std::size_t{1} << (z.level + 1)) - 1;
+            if (i1 > n) {
+                i1 = n;
+            }
+            for (std::size_t i = i0; i < i1 && starts_[i] < hi; ++i) {
+                if (lo < ends_[i]) {
+                    fn(i);
+                }
+            }
+        } else if (!z.leftDone) {
+            // Revisit z after its left subtree. The left child may lie past
+            // the end of the array when the tree is not perfectly filled.
+            const std::size_t y = z.x - (std::size_t{1} << (z.level - 1));
+            stack[top++] = {z.x, z.level, true};
+            if (y >= n || maxEnds_[y] > lo) {
+                stack[top++] = {y, z.level - 1, false};
+            }
+        } else if (z.x < n && starts_[z.x] < hi) {
+            if (lo < ends_[z.x]) {
+                fn(z.x);
+            }
+            stack[top++] = {z.x + (std::size_t{1} << (z.level - 1)),
+                            z.level - 1, false};
+        }
+    }
+}
+
+} // namespace cineforge::timeline
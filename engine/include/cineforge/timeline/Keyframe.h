@@ -1,9 +1,13 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
-#include <string>
 #include <vector>
 
+#include "cineforge/core/Symbol.h"
+
 namespace cineforge::timeline {
 
 enum class InterpolationType {
@@ -15,6 +19,10 @@ enum class InterpolationType {
     EaseInOut
 };
 
+// Tangent handles relative to their key, in (seconds, value) units: the
+// out handle shapes the segment leaving the key, the in handle (usually
+// with a negative inX) the segment arriving at it. All-zero handles give a
+// straight line; keys marked Bezier without handles get flat tangents.
 struct BezierHandles {
     float inX = 0.0f;
     float inY = 0.0f;
@@ -29,16 +37,83 @@ struct Keyframe {
     std::optional<BezierHandles> bezier;
 };
 
+/**
+ * Animated scalar parameter.
+ *
+ * Keys are kept sorted by time and owned by the curve so that derived
+ * per‑segment data can be rebuilt whenever they change: each segment's
+ * timing and value polynomials are computed once in setKeys()/addKey(),
+ * and evaluate() only runs a table‑seeded, iteration‑bounded solve.
+ *
+ * A curve can additionally be baked at a fixed rate (typically the
+ * project frame rate). While baked, evaluate() is an index plus a lerp
+ * and is exact at multiples of 1 / rate; between those instants it
+ * linearly interpolates the neighbouring samples, except after a sample
+ * that falls in a Hold segment, which is held until the next one. A step
+ * between samples therefore lands on the following sample.
+ */
 struct KeyframeCurve {
-    std::string id;
-    std::string target; // e.g. "clip:c1:param:opacity"
-    std::vector<Keyframe> keys;
+    Symbol id;
+    Symbol target; // e.g. "clip:c1:param:opacity"
+
+    const std::vector<Keyframe>& keys() const { return keys_; }
 
-    // Optional sampled cache for fast evaluation.
-    std::vector<double> sampleTimes;
-    std::vector<double> sampleValues;
+    // Replaces all keys; they are stably sorted by time.
+    void setKeys(std::vector<Keyframe> keys);
+    // Inserts a key, after any existing keys at the same time.
+    void addKey(const Keyframe& key);
+    void clearKeys();
 
     double evaluate(double time) const;
+
+    // Samples the curve on the grid k / sampleRate covering all keys. The
+    // rate is sticky: key edits rebake at the same rate, so the cache is
+    // never stale. A rate <= 0 drops the cache. Returns false (and leaves
+    // the curve unbaked) if the span would need more than kMaxSamples.
+    bool bake(double sampleRate);
+    bool isBaked() const { return !sampleValues_.empty(); }
+    double sampleRate() const { return sampleRate_; }
+
+    // Raw cache for batch evaluators: samples()[i] is the value at
+    // (sampleOrigin() + i) / sampleRate().
+    const std::vector<double>& samples() const { return sampleValues_; }
+    double sampleOrigin() const { return sampleOrigin_; }
+    // heldSamples()[i] != 0: samples()[i] is held up to the next sample
+    // rather than interpolated. Empty when the curve has no Hold segment.
+    const std::vector<std::uint8_t>& heldSamples() const { return sampleHeld_; }
+
+    static constexpr std::size_t kMaxSamples = std::size_t{1} << 20;
+
+private:
+    static constexpr int kSplineSamples = 11;
+
+    // Cubic segment between keys_[i] and keys_[i + 1]. For a normalized
+    // parameter s in [0, 1]:
+    //   x(s) = ((ax * s + bx) * s + cx) * s          (normalized time)
+    //   y(s) = ((ay * s + by) * s + cy) * s + dy     (value)
+    struct Segment {
+        InterpolationType interp = InterpolationType::Linear;
+        double invDuration = 0.0;
+        double ax = 0.0, bx = 0.0, cx = 0.0;
+        double ay = 0.0, by = 0.0, cy = 0.0, dy = 0.0;
+        // x(s) at s = i / (kSplineSamples - 1), seeds the solve for s.
+        std::array<double, kSplineSamples> xSamples{};
+    };
+
+    std::vector<Keyframe> keys_;
+    std::vector<Segment> segments_;
+
+    // Sampled cache: sampleValues_[i] is the value at
+    // (sampleOrigin_ + i) / sampleRate_.
+    double sampleRate_ = 0.0;
+    double sampleOrigin_ = 0.0;
+    std::vector<double> sampleValues_;
+    std::vector<std::uint8_t> sampleHeld_;
+
+    void rebuildSegments();
+    void rebake();
+    double evaluateKeys(double time) const;
+    double evaluateSegment(std::size_t i, double time) const;
 };
 
 } // namespace cineforge::timeline
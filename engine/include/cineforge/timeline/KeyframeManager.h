@@ -1,24 +1,137 @@
 #pragma once
 
-#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <unordered_map>
+#include <vector>
 
+#include "cineforge/core/DirtyRegions.h"
 #include "cineforge/timeline/Keyframe.h"
 
 namespace cineforge::timeline {
 
+// One applied curve change; `curve` is the stored curve for Set and is
+// only valid during the listener call.
+struct CurveEdit {
+    enum class Kind { Set, Remove, Clear };
+
+    Kind kind = Kind::Clear;
+    Symbol id;
+    const KeyframeCurve* curve = nullptr;
+};
+
+/**
+ * Owns all keyframe curves of a project.
+ *
+ * Curves live in a dense array indexed by "slot". Besides the by-id
+ * eval(), the manager offers batch evaluation of every curve (or of a
+ * registered subset) at one time into a caller-provided array, which is
+ * what preview and export use to fetch all animated parameters of a
+ * frame. Batch evaluation runs over a structure-of-arrays view of the
+ * baked sample caches; curves that are not baked take the scalar path.
+ */
 class KeyframeManager {
 public:
+    /**
+     * A fixed list of curve ids to evaluate together. Ids are resolved to
+     * slots on first use and re-resolved only after the manager's layout
+     * changes or the set is used with another manager. Unknown ids
+     * evaluate to 0.
+     */
+    class EvalSet {
+    public:
+        EvalSet() = default;
+        explicit EvalSet(std::vector<Symbol> ids) : ids_(std::move(ids)) {}
+
+        const std::vector<Symbol>& ids() const { return ids_; }
+        std::size_t size() const { return ids_.size(); }
+
+    private:
+        friend class KeyframeManager;
+
+        std::vector<Symbol> ids_;
+        mutable std::vector<std::uint32_t> slots_;
+        mutable std::uint64_t layout_ = 0;
+    };
+
+    KeyframeManager() = default;
+
+    // Not copyable: the batch table points into the curves' sample caches
+    // and the layout id must stay unique to this manager.
+    KeyframeManager(const KeyframeManager&) = delete;
+    KeyframeManager& operator=(const KeyframeManager&) = delete;
+
     void registerCurve(const KeyframeCurve& curve);
-    void removeCurve(const std::string& id);
+    void removeCurve(Symbol id);
+    void clear();
+
+    const KeyframeCurve* getCurve(Symbol id) const;
 
-    const KeyframeCurve* getCurve(const std::string& id) const;
+    double eval(Symbol id, double time) const;
 
-    double eval(const std::string& id, double time) const;
+    // Slots are dense in [0, curveCount()). Removing a curve moves the
+    // last curve into the freed slot.
+    std::size_t curveCount() const { return curves_.size(); }
+    Symbol curveAt(std::size_t slot) const { return curves_[slot].id; }
+
+    // out[slot] = value of the curve in `slot`; `out` must hold
+    // curveCount() entries.
+    void evalAll(double time, double* out) const;
+
+    // out[i] = value of set.ids()[i]; `out` must hold set.size() entries.
+    void evalSet(const EvalSet& set, double time, double* out) const;
+
+    // Bakes every registered curve, and every curve registered later, at
+    // `sampleRate` (usually the project frame rate). <= 0 disables baking.
+    // Baked values between samples depend on the rate, so a new rate
+    // counts as a change to every curve.
+    void setSampleRate(double sampleRate);
+    double sampleRate() const { return sampleRate_; }
+
+    // Called after registerCurve(), clear() and removeCurve() of a known
+    // id; used by autosave.
+    using EditListener = std::function<void(const CurveEdit&)>;
+    void setEditListener(EditListener listener) { listener_ = std::move(listener); }
+
+    // Every curve change is stamped with a revision and the range of
+    // timeline time whose evaluated values it can alter.
+    Revision revision() const { return changes_.revision(); }
+    bool changedSince(Revision since, double t0, double t1) const {
+        return changes_.changedSince(since, t0, t1);
+    }
 
 private:
-    std::unordered_map<std::string, KeyframeCurve> curves_;
+    static constexpr std::uint32_t kNoSlot = ~std::uint32_t{0};
+
+    // Structure-of-arrays view over the curves' sample caches, indexed by
+    // slot. Rebuilt lazily after any curve changes; like Timeline's
+    // indexes this makes batch evaluation unsafe to run concurrently with
+    // itself or with edits.
+    struct BatchTable {
+        std::vector<double> rate;
+        std::vector<double> origin;
+        std::vector<double> maxPos; // sample count - 1
+        std::vector<const double*> samples;
+        std::vector<const std::uint8_t*> held; // null: no held samples
+        std::vector<std::uint8_t> sampled; // 0: evaluate the curve directly
+    };
+
+    std::vector<KeyframeCurve> curves_;
+    std::unordered_map<Symbol, std::uint32_t> slots_;
+    double sampleRate_ = 0.0;
+    DirtyRegionTracker changes_;
+    EditListener listener_;
+
+    // Drawn from a process-wide counter, so an EvalSet resolved against
+    // another manager never matches this one.
+    std::uint64_t layout_ = newLayout();
+    mutable BatchTable batch_;
+    mutable bool batchDirty_ = true;
+
+    static std::uint64_t newLayout();
+    const BatchTable& batchTable() const;
+    double evalSlot(std::uint32_t slot, double pos) const;
 };
 
 } // namespace cineforge::timeline
-
@@ -1,8 +1,14 @@
 #pragma once
 
-#include <string>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 
+#include "cineforge/core/DirtyRegions.h"
+#include "cineforge/core/Symbol.h"
+#include "cineforge/timeline/IntervalIndex.h"
+
 namespace cineforge::timeline {
 
 enum class TrackType {
@@ -14,12 +20,12 @@ enum class TrackType {
 };
 
 struct ClipRef {
-    std::string id;
+    Symbol id;
 };
 
 struct Clip {
-    std::string id;
-    std::string sourceId;
+    Symbol id;
+    Symbol sourceId;
     double start = 0.0;   // timeline start (ms or seconds – engine‑wide convention)
     double end = 0.0;     // timeline end
     double inPoint = 0.0; // source in
@@ -27,25 +33,111 @@ struct Clip {
 };
 
 struct Track {
-    std::string id;
+    Symbol id;
     TrackType type = TrackType::Unknown;
     std::vector<Clip> clips;
 };
 
+/**
+ * One applied timeline edit, described by the arguments that reproduce
+ * it: replaying the same edits in order on the same starting timeline
+ * gives the same result. Pointers refer to the track or clip as added
+ * and are only valid during the listener call.
+ */
+struct TimelineEdit {
+    enum class Kind { AddTrack, AddClip, SplitClip, MoveClip, RemoveClip, Clear };
+
+    Kind kind = Kind::Clear;
+    Symbol target;               // the track for AddClip, else the clip
+    double time = 0.0;           // split time or new start
+    const Track* track = nullptr; // AddTrack
+    const Clip* clip = nullptr;   // AddClip
+};
+
+/**
+ * Clips are kept sorted by start time within each track, and every track
+ * carries an interval index so that "what is active at t" queries do not
+ * have to scan the whole project. Tracks are exposed read‑only; all edits
+ * go through the methods below so the ordering and indexes stay valid.
+ */
 class Timeline {
 public:
     void addTrack(const Track& track);
-    void addClip(const std::string& trackId, const Clip& clip);
+    void addClip(Symbol trackId, const Clip& clip);
+    void clear();
 
     const std::vector<Track>& tracks() const { return tracks_; }
-    std::vector<Track>& tracks() { return tracks_; }
+
+    // O(1) lookups; nullptr when the id is unknown. Pointers are
+    // invalidated by any edit.
+    const Track* findTrack(Symbol trackId) const;
+    const Clip* findClip(Symbol clipId) const;
 
     // Simplified editing operations for now.
-    void splitClip(const std::string& clipId, double time);
-    void moveClip(const std::string& clipId, double newStart);
+    void splitClip(Symbol clipId, double time);
+    void moveClip(Symbol clipId, double newStart);
+    void removeClip(Symbol clipId);
+
+    // Clips active at `time` (start <= time < end), appended to `out` in
+    // track order and, within a track, by start time. A clip is not active
+    // at its own end time, so at a cut only the clip starting there is;
+    // callers that want the last frame at the very end query just before.
+    void clipsAt(double time, std::vector<const Clip*>& out) const;
+    std::vector<const Clip*> clipsAt(double time) const;
+
+    // Clips overlapping [t0, t1), in the same order as clipsAt().
+    void clipsInRange(double t0, double t1, std::vector<const Clip*>& out) const;
+    std::vector<const Clip*> clipsInRange(double t0, double t1) const;
+
+    // Called after every edit that changed the timeline (not for ones
+    // rejected because of an unknown or duplicate id); used by autosave.
+    using EditListener = std::function<void(const TimelineEdit&)>;
+    void setEditListener(EditListener listener) { listener_ = std::move(listener); }
+
+    // Every edit is stamped with a revision and the time range it touched.
+    Revision revision() const { return changes_.revision(); }
+    bool changedSince(Revision since, double t0, double t1) const {
+        return changes_.changedSince(since, t0, t1);
+    }
 
 private:
+    struct TrackIndex {
+        IntervalIndex intervals;
+        bool dirty = true;
+    };
+
+    struct ClipLocation {
+        std::uint32_t track = 0;
+        std::uint32_t index = 0;
+    };
+
     std::vector<Track> tracks_;
+
+    // Clip ids are unique across the whole timeline. Both maps are kept in
+    // step with every edit; positions are refreshed only from the first
+    // shifted element onwards, so appends stay O(1).
+    std::unordered_map<Symbol, std::uint32_t> trackById_;
+    std::unordered_map<Symbol, ClipLocation> clipById_;
+
+    DirtyRegionTracker changes_;
+    EditListener listener_;
+
+    // Parallel to tracks_. Rebuilt lazily on the first query after an edit,
+    // so bulk edits cost one rebuild rather than one per clip. Queries are
+    // therefore not safe to run concurrently with each other or with edits.
+    mutable std::vector<TrackIndex> index_;
+
+    const ClipLocation* locate(Symbol clipId) const;
+    void insertClip(std::size_t track, Clip clip);
+    void relocate(std::size_t track, std::size_t from, std::size_t to);
+    void notify(const TimelineEdit& edit) const {
+        if (listener_) {
+            listener_(edit);
+        }
+    }
+
+    const IntervalIndex& intervalsFor(std::size_t track) const;
+    void collect(double lo, double hi, std::vector<const Clip*>& out) const;
 };
 
 } // namespace cineforge::timeline
@@ -0,0 +1,52 @@
+#include "cineforge/core/DirtyRegions.h"
+
+#include <atomic>
+#include <limits>
+
+namespace cineforge {
+
+Revision nextRevision() {
+    static std::atomic<Revision> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+DirtyRegionTracker::DirtyRegionTracker(std::size_t capacity)
+    : capacity_(capacity > 0 ? capacity : 1) {}
+
+Revision DirtyRegionTracker::markDirty(double t0, double t1) {
+    revision_ = nextRevision();
+    if (t0 < t1) {
+        if (entries_.size() == capacity_) {
+            horizon_ = entries_.front().revision;
+            entries_.pop_front();
+        }
+        entries_.push_back({revision_, t0, t1});
+    }
+    return revision_;
+}
+
+Revision DirtyRegionTracker::markAllDirty() {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    return markDirty(-inf, inf);
+}
+
+bool DirtyRegionTracker::changedSince(Revision since, double t0,
+                                      double t1) const {
+    if (since >= revision_) {
+        return false;
+    }
+    if (since < horizon_) {
+        return true;
+    }
+    for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+        if (it->revision <= since) {
+            break;
+        }
+        if (t0 < it->t1 && it->t0 < t1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace cineforge
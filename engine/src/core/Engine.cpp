@@ -1,12 +1,18 @@
 #include "cineforge/core/Engine.h"
 
+#include "cineforge/exporter/Exporter.h"
+#include "cineforge/io/BinaryProject.h"
+#include "cineforge/io/EditJournal.h"
+#include "cineforge/io/MappedFile.h"
+#include "cineforge/io/ProjectJson.h"
+#include "cineforge/media/MediaLibrary.h"
 #include "cineforge/media/ProxyManager.h"
 #include "cineforge/render/Renderer.h"
 #include "cineforge/timeline/KeyframeManager.h"
 #include "cineforge/timeline/Timeline.h"
+#include <algorithm>
 #include <cstddef>
-#include <iomanip>
-#include <sstream>
+#include <string_view>
 
 
 namespace cineforge {
@@ -15,10 +21,69 @@ struct Engine::Impl {
   double previewTimeSeconds = 0.0;
   timeline::Timeline timeline;
   timeline::KeyframeManager keyframes;
+  media::MediaLibrary media;
   render::Renderer renderer;
   media::ProxyManager proxyManager;
+  exporter::Exporter exporter;
+  // Last, so it stops before anything its snapshot callback reads is gone.
+  io::EditJournal journal;
+
+  Impl() : proxyManager("", "media/proxies") {
+    renderer.setChangeQuery([this](Revision since, double t0, double t1) {
+      return timeline.changedSince(since, t0, t1) ||
+             keyframes.changedSince(since, t0, t1);
+    });
+  }
+
+  io::ProjectData snapshot() const {
+    io::ProjectData project;
+    project.previewTime = previewTimeSeconds;
+    project.media = media.sources();
+    project.tracks = timeline.tracks();
+    project.curves.reserve(keyframes.curveCount());
+    for (std::size_t slot = 0; slot < keyframes.curveCount(); ++slot) {
+      const auto *curve = keyframes.getCurve(keyframes.curveAt(slot));
+      project.curves.push_back({curve->id, curve->target, curve->keys()});
+    }
+    return project;
+  }
 
-  Impl() : proxyManager("", "media/proxies") {}
+  void listen(bool on) {
+    if (!on) {
+      timeline.setEditListener(nullptr);
+      keyframes.setEditListener(nullptr);
+      return;
+    }
+    timeline.setEditListener(
+        [this](const timeline::TimelineEdit &edit) { journal.record(edit); });
+    keyframes.setEditListener(
+        [this](const timeline::CurveEdit &edit) { journal.record(edit); });
+  }
+
+  // Tracks go in whole, so each is sorted and indexed once rather than
+  // once per clip. A replaced project is not journaled edit by edit; the
+  // journal restarts from a snapshot of it, written before any further
+  // edit is recorded.
+  void apply(io::ProjectData &&project) {
+    listen(false);
+    previewTimeSeconds = project.previewTime;
+    media.clear();
+    for (const auto &source : project.media)
+      media.add(source);
+    timeline.clear();
+    for (const auto &track : project.tracks)
+      timeline.addTrack(track);
+    keyframes.clear();
+    for (auto &data : project.curves) {
+      timeline::KeyframeCurve curve;
+      curve.id = data.id;
+      curve.target = data.target;
+      curve.setKeys(std::move(data.keys));
+      keyframes.registerCurve(curve);
+    }
+    if (journal.isOpen() && journal.restart())
+      listen(true);
+  }
 };
 
 Engine &Engine::instance() {
@@ -31,52 +96,67 @@ Engine::Engine() : impl_(std::make_unique<Impl>()) {}
 Engine::~Engine() = default;
 
 std::string Engine::saveProjectToJson() const {
-  std::stringstream ss;
-  ss << "{\n";
-  ss << "  \"previewTime\": " << impl_->previewTimeSeconds << ",\n";
-  ss << "  \"timeline\": {\n";
-  ss << "    \"tracks\": [\n";
-
-  const auto &tracks = impl_->timeline.tracks();
-  for (std::size_t i = 0; i < tracks.size(); ++i) {
-    ss << "      {\n";
-    ss << "        \"id\": \"" << tracks[i].id << "\",\n";
-    ss << "        \"type\": " << static_cast<int>(tracks[i].type) << ",\n";
-    ss << "        \"clips\": [\n";
-    for (std::size_t j = 0; j < tracks[i].clips.size(); ++j) {
-      const auto &c = tracks[i].clips[j];
-      ss << "          {\"id\": \"" << c.id << "\", \"source\": \""
-         << c.sourceId << "\", \"start\": " << c.start << ", \"end\": " << c.end
-         << "}";
-      if (j < tracks[i].clips.size() - 1)
-        ss << ",";
-      ss << "\n";
-    }
-    ss << "        ]\n";
-    ss << "      }";
-    if (i < tracks.size() - 1)
-      ss << ",";
-    ss << "\n";
+  return io::projectToJson(impl_->snapshot());
+}
+
+bool Engine::loadProjectFromFile(const std::string &path) {
+  io::MappedFile file;
+  if (!file.open(path))
+    return false;
+  if (io::isBinaryProject(file.data(), file.size())) {
+    io::ProjectData project;
+    if (!io::decodeBinaryProject(file.data(), file.size(), project))
+      return false;
+    impl_->apply(std::move(project));
+    return true;
   }
+  // JSON is parsed straight out of the mapping.
+  io::ProjectData project;
+  if (!io::projectFromJson(
+          std::string_view(reinterpret_cast<const char *>(file.data()),
+                           file.size()),
+          project))
+    return false;
+  impl_->apply(std::move(project));
+  return true;
+}
 
-  ss << "    ]\n";
-  ss << "  }\n";
-  ss << "}";
-  return ss.str();
+bool Engine::saveProjectToFile(const std::string &path) const {
+  const std::string ext = ".json";
+  if (path.size() >= ext.size() &&
+      path.compare(path.size() - ext.size(), ext.size(), ext) == 0) {
+    return io::saveProjectJson(path, impl_->snapshot());
+  }
+  return io::saveBinaryProject(path, impl_->snapshot());
 }
 
 bool Engine::loadProjectFromJson(const std::string &json) {
-  // Very basic "parser" that just clears and logs for now,
-  // real implementation would use a proper JSON lib.
-  if (json.empty() || json == "{}")
+  io::ProjectData project;
+  if (!io::projectFromJson(json, project))
     return false;
+  impl_->apply(std::move(project));
+  return true;
+}
 
-  impl_->timeline.tracks().clear();
-  // Simplified: always add a default track if loading from non-empty
-  timeline::Track defaultTrack;
-  defaultTrack.id = "main_track";
-  impl_->timeline.addTrack(defaultTrack);
+bool Engine::startAutosave(const std::string &dir) {
+  impl_->listen(false);
+  auto *impl = impl_.get();
+  if (!impl->journal.open(dir, [impl] { return impl->snapshot(); }))
+    return false;
+  impl_->listen(true);
+  return true;
+}
 
+void Engine::stopAutosave() {
+  impl_->listen(false);
+  impl_->journal.close();
+}
+
+bool Engine::recoverProject(const std::string &dir) {
+  io::ProjectData project;
+  if (!io::EditJournal::recover(dir, project))
+    return false;
+  impl_->apply(std::move(project));
   return true;
 }
 
@@ -86,6 +166,10 @@ void Engine::setPreviewTime(double timeSeconds) {
 
 double Engine::previewTime() const { return impl_->previewTimeSeconds; }
 
+std::uint64_t Engine::contentRevision() const {
+  return std::max(impl_->timeline.revision(), impl_->keyframes.revision());
+}
+
 timeline::Timeline &Engine::timeline() { return impl_->timeline; }
 
 const timeline::Timeline &Engine::timeline() const { return impl_->timeline; }
@@ -100,10 +184,16 @@ render::Renderer &Engine::renderer() { return impl_->renderer; }
 
 const render::Renderer &Engine::renderer() const { return impl_->renderer; }
 
+media::MediaLibrary &Engine::media() { return impl_->media; }
+
+const media::MediaLibrary &Engine::media() const { return impl_->media; }
+
 media::ProxyManager &Engine::proxyManager() { return impl_->proxyManager; }
 
 const media::ProxyManager &Engine::proxyManager() const {
   return impl_->proxyManager;
 }
 
+exporter::Exporter &Engine::exporter() { return impl_->exporter; }
+
 } // namespace cineforge
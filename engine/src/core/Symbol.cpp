@@ -0,0 +1,72 @@
+#include "cineforge/core/Symbol.h"
+
+#include <mutex>
+
+namespace cineforge {
+
+SymbolTable::SymbolTable() {
+    names_.emplace_back();
+    lookup_.emplace(std::string_view(names_.front()), 0u);
+}
+
+SymbolTable& SymbolTable::global() {
+    static SymbolTable table;
+    return table;
+}
+
+Symbol SymbolTable::intern(std::string_view text) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx_);
+        auto it = lookup_.find(text);
+        if (it != lookup_.end()) {
+            return Symbol{it->second};
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+    auto it = lookup_.find(text);
+    if (it != lookup_.end()) {
+        return Symbol{it->second};
+    }
+    const auto value = static_cast<std::uint32_t>(names_.size());
+    // deque::emplace_back never moves existing elements, so the views held
+    // by lookup_ stay valid.
+    names_.emplace_back(text);
+    lookup_.emplace(std::string_view(names_.back()), value);
+    return Symbol{value};
+}
+
+void SymbolTable::internAll(const std::string_view* texts, std::size_t count,
+                            Symbol* out) {
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+    lookup_.reserve(lookup_.size() + count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto it = lookup_.find(texts[i]);
+        if (it != lookup_.end()) {
+            out[i] = Symbol{it->second};
+            continue;
+        }
+        const auto value = static_cast<std::uint32_t>(names_.size());
+        names_.emplace_back(texts[i]);
+        lookup_.emplace(std::string_view(names_.back()), value);
+        out[i] = Symbol{value};
+    }
+}
+
+Symbol SymbolTable::find(std::string_view text) const {
+    std::shared_lock<std::shared_mutex> lock(mtx_);
+    auto it = lookup_.find(text);
+    return it == lookup_.end() ? Symbol{} : Symbol{it->second};
+}
+
+const std::string& SymbolTable::name(Symbol sym) const {
+    std::shared_lock<std::shared_mutex> lock(mtx_);
+    return sym.value < names_.size() ? names_[sym.value] : names_.front();
+}
+
+std::size_t SymbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mtx_);
+    return names_.size();
+}
+
+} // namespace cineforge
@@ -0,0 +1,160 @@
+#include "cineforge/core/ThreadPool.h"
+
+#include <algorithm>
+
+namespace cineforge {
+
+namespace {
+
+// Identifies the pool and queue of the current worker thread, if any.
+thread_local const ThreadPool* tlsPool = nullptr;
+thread_local std::size_t tlsQueue = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        threads = hw > 1 ? hw - 1 : 1;
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMtx_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : workers_) {
+        t.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::submit(Task task) {
+    const std::size_t q = tlsPool == this
+                              ? tlsQueue
+                              : nextQueue_.fetch_add(1, std::memory_order_relaxed) %
+                                    queues_.size();
+    {
+        // Counted before it is queued so pending_ never underflows, and
+        // under sleepMtx_ so a worker about to sleep cannot miss it.
+        std::lock_guard<std::mutex> lock(sleepMtx_);
+        pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[q]->mtx);
+        queues_[q]->tasks.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::tryPop(std::size_t self, Task& task) {
+    {
+        Queue& own = *queues_[self];
+        std::lock_guard<std::mutex> lock(own.mtx);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    const std::size_t n = queues_.size();
+    for (std::size_t k = 1; k < n; ++k) {
+        Queue& victim = *queues_[(self + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mtx);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(std::size_t self) {
+    tlsPool = this;
+    tlsQueue = self;
+    for (;;) {
+        Task task;
+        if (tryPop(self, task)) {
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMtx_);
+        wake_.wait(lock, [this] {
+            return stop_ || pending_.load(std::memory_order_relaxed) > 0;
+        });
+        if (stop_ && pending_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count,
+                             const std::function<void(std::size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+    if (count == 1 || workers_.empty()) {
+        for (std::size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    // Helpers may start after every index is taken, so the shared state
+    // outlives this call; they only touch `fn` while indices remain.
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::size_t count = 0;
+        const std::function<void(std::size_t)>* fn = nullptr;
+        std::mutex mtx;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<State>();
+    state->count = count;
+    state->fn = &fn;
+
+    auto run = [state] {
+        std::size_t ran = 0;
+        for (;;) {
+            const std::size_t i = state->next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= state->count) {
+                break;
+            }
+            (*state->fn)(i);
+            ++ran;
+        }
+        if (ran != 0 &&
+            state->done.fetch_add(ran, std::memory_order_acq_rel) + ran == state->count) {
+            std::lock_guard<std::mutex> lock(state->mtx);
+            state->finished.notify_all();
+        }
+    };
+
+    const std::size_t helpers = std::min(count - 1, workers_.size());
+    for (std::size_t h = 0; h < helpers; ++h) {
+        submit(run);
+    }
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mtx);
+    state->finished.wait(lock, [&] {
+        return state->done.load(std::memory_order_acquire) == count;
+    });
+}
+
+} // namespace cineforge
@@ -0,0 +1,330 @@
+#include "cineforge/exporter/Exporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "cineforge/core/BoundedQueue.h"
+#include "cineforge/render/EffectGraph.h"
+#include "cineforge/render/FrameBufferPool.h"
+
+namespace cineforge::exporter {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Item {
+    std::int64_t frame = 0;
+    double time = 0.0;
+    render::FrameBufferPool::Handle source;
+    render::FrameBufferPool::Handle output;
+};
+
+// Counting semaphore bounding the frames between decode and encode.
+class Credits {
+public:
+    explicit Credits(std::size_t count) : available_(count) {}
+
+    bool acquire() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [this] { return closed_ || available_ > 0; });
+        if (closed_) {
+            return false;
+        }
+        --available_;
+        return true;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            ++available_;
+        }
+        cv_.notify_one();
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            closed_ = true;
+        }
+        cv_.notify_all();
+    }
+
+private:
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::size_t available_;
+    bool closed_ = false;
+};
+
+class BusyTimer {
+public:
+    explicit BusyTimer(std::atomic<std::int64_t>& total)
+        : total_(total), start_(Clock::now()) {}
+    ~BusyTimer() {
+        total_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             Clock::now() - start_)
+                             .count(),
+                         std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::int64_t>& total_;
+    Clock::time_point start_;
+};
+
+bool copyPixels(const render::Frame& src, render::Frame& dst) {
+    if (!src.cpuData || !dst.cpuData) {
+        return false;
+    }
+    if (src.cpuData == dst.cpuData) {
+        return true;
+    }
+    const std::size_t rowBytes =
+        render::frameByteSize(std::min(src.width, dst.width), 1, dst.format);
+    const int rows = std::min(src.height, dst.height);
+    for (int y = 0; y < rows; ++y) {
+        std::memcpy(dst.cpuData + static_cast<std::size_t>(y) * dst.cpuStride,
+                    src.cpuData + static_cast<std::size_t>(y) * src.cpuStride,
+                    rowBytes);
+    }
+    return true;
+}
+
+StageStats finishStage(std::size_t threads, std::uint64_t frames,
+                       std::int64_t busyNs, double wallSeconds) {
+    StageStats s;
+    s.threads = threads;
+    s.frames = frames;
+    s.busySeconds = static_cast<double>(busyNs) * 1e-9;
+    if (wallSeconds > 0.0 && threads > 0) {
+        s.utilisation = s.busySeconds / (wallSeconds * static_cast<double>(threads));
+    }
+    return s;
+}
+
+} // namespace
+
+Exporter::Exporter() = default;
+
+Exporter::~Exporter() = default;
+
+void Exporter::setSource(std::shared_ptr<FrameSource> source) {
+    source_ = std::move(source);
+}
+
+void Exporter::setSink(std::shared_ptr<FrameSink> sink) {
+    sink_ = std::move(sink);
+}
+
+void Exporter::setRenderFactory(RenderFactory factory) {
+    factory_ = std::move(factory);
+}
+
+RenderFactory Exporter::effectGraphFactory(
+    std::function<void(render::EffectGraph&)> build) {
+    return [build = std::move(build)]() -> RenderFunction {
+        // Workers already keep every core busy with whole frames, so the
+        // graphs run their stripes inline. Intermediates need real pixels,
+        // hence a private CPU pool per worker.
+        auto graph = std::make_shared<render::EffectGraph>();
+        auto pool = std::make_shared<render::FrameBufferPool>(
+            std::size_t{256} << 20, render::FrameBackend::Cpu);
+        build(*graph);
+        graph->setThreadPool(nullptr);
+        return [graph, pool](std::int64_t, double, const render::Frame& source,
+                             render::Frame& out) {
+            // An empty graph passes `source` through by assignment, so it
+            // must not write to the pooled frame directly.
+            render::Frame target = out;
+            graph->process(source, target, pool.get());
+            return copyPixels(target, out);
+        };
+    };
+}
+
+void Exporter::cancel() {
+    cancel_.store(true, std::memory_order_relaxed);
+}
+
+bool Exporter::run(const ExportSettings& settings, ExportStats* stats) {
+    std::lock_guard<std::mutex> runLock(runMtx_);
+    // A cancel() that came in before this run stops it rather than being
+    // lost; the flag is cleared on the way out so it cannot leak into the
+    // next one.
+    struct ClearCancel {
+        std::atomic<bool>& flag;
+        ~ClearCancel() { flag.store(false, std::memory_order_relaxed); }
+    } clearCancel{cancel_};
+
+    if (!source_ || !sink_ || settings.width <= 0 || settings.height <= 0 ||
+        settings.fpsNum <= 0 || settings.fpsDen <= 0 || settings.frameCount < 0) {
+        return false;
+    }
+
+    std::size_t workers = settings.renderWorkers;
+    if (workers == 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        workers = hw > 3 ? hw - 2 : 1;
+    }
+    const std::size_t depth = std::max<std::size_t>(settings.queueDepth, 1);
+    const std::size_t inFlight = settings.maxFramesInFlight != 0
+                                     ? settings.maxFramesInFlight
+                                     : workers + 2 * depth + 1;
+
+    // Declared before the queues so every pooled frame is returned first.
+    const std::size_t frameBytes =
+        render::frameByteSize(settings.width, settings.height, settings.format);
+    render::FrameBufferPool pool(frameBytes * (inFlight * 2 + 2),
+                                 render::FrameBackend::Cpu);
+    BoundedQueue<Item> decoded(depth);
+    BoundedQueue<Item> rendered(depth);
+    Credits credits(inFlight);
+
+    std::atomic<bool> failed{false};
+    auto abort = [&] {
+        failed.store(true, std::memory_order_relaxed);
+        decoded.close();
+        rendered.close();
+        credits.close();
+    };
+    auto stopping = [&] {
+        return failed.load(std::memory_order_relaxed) ||
+               cancel_.load(std::memory_order_relaxed);
+    };
+
+    if (!sink_->open(settings)) {
+        return false;
+    }
+
+    std::atomic<std::int64_t> decodeNs{0}, renderNs{0}, encodeNs{0};
+    std::atomic<std::uint64_t> decodedFrames{0}, renderedFrames{0};
+    const auto wallStart = Clock::now();
+
+    std::thread decoder([&] {
+        const std::int64_t end = settings.firstFrame + settings.frameCount;
+        for (std::int64_t f = settings.firstFrame; f < end; ++f) {
+            if (stopping() || !credits.acquire()) {
+                break;
+            }
+            Item item;
+            item.frame = f;
+            item.time = settings.timeOf(f);
+            item.source = pool.acquire(settings.width, settings.height, settings.format);
+            bool ok;
+            {
+                BusyTimer busy(decodeNs);
+                ok = source_->decode(f, item.time, item.source.frame());
+            }
+            if (!ok) {
+                abort();
+                break;
+            }
+            decodedFrames.fetch_add(1, std::memory_order_relaxed);
+            if (!decoded.push(item)) {
+                break;
+            }
+        }
+        decoded.close();
+    });
+
+    std::atomic<std::size_t> liveWorkers{workers};
+    std::vector<std::thread> renderers;
+    for (std::size_t w = 0; w < workers; ++w) {
+        renderers.emplace_back([&] {
+            RenderFunction render = factory_ ? factory_() : RenderFunction{};
+            Item item;
+            while (decoded.pop(item)) {
+                if (stopping()) {
+                    abort();
+                    break;
+                }
+                item.output = pool.acquire(settings.width, settings.height, settings.format);
+                bool ok;
+                {
+                    BusyTimer busy(renderNs);
+                    ok = render ? render(item.frame, item.time, item.source.frame(),
+                                         item.output.frame())
+                                : copyPixels(item.source.frame(), item.output.frame());
+                }
+                item.source.reset();
+                if (!ok) {
+                    abort();
+                    break;
+                }
+                renderedFrames.fetch_add(1, std::memory_order_relaxed);
+                if (!rendered.push(item)) {
+                    break;
+                }
+            }
+            if (liveWorkers.fetch_sub(1) == 1) {
+                rendered.close();
+            }
+        });
+    }
+
+    // Encode on this thread, restoring frame order on the way.
+    std::map<std::int64_t, Item> reorder;
+    std::size_t peakReorder = 0;
+    std::uint64_t encoded = 0;
+    std::int64_t next = settings.firstFrame;
+    Item item;
+    while (rendered.pop(item)) {
+        if (stopping()) {
+            abort();
+            break;
+        }
+        reorder.emplace(item.frame, std::move(item));
+        peakReorder = std::max(peakReorder, reorder.size() - 1);
+        for (auto it = reorder.begin(); it != reorder.end() && it->first == next;
+             it = reorder.begin()) {
+            bool ok;
+            {
+                BusyTimer busy(encodeNs);
+                ok = sink_->write(next, it->second.output.frame());
+            }
+            reorder.erase(it);
+            credits.release();
+            if (!ok) {
+                abort();
+                break;
+            }
+            ++encoded;
+            ++next;
+        }
+    }
+
+    decoder.join();
+    for (auto& t : renderers) {
+        t.join();
+    }
+    reorder.clear();
+    const bool closed = sink_->close();
+    const double wall =
+        std::chrono::duration<double>(Clock::now() - wallStart).count();
+
+    const bool cancelled = cancel_.load(std::memory_order_relaxed);
+    const bool complete = !failed.load() && !cancelled &&
+                          encoded == static_cast<std::uint64_t>(settings.frameCount);
+    if (stats) {
+        ExportStats s;
+        s.framesEncoded = encoded;
+        s.wallSeconds = wall;
+        s.fps = wall > 0.0 ? static_cast<double>(encoded) / wall : 0.0;
+        s.decode = finishStage(1, decodedFrames.load(), decodeNs.load(), wall);
+        s.render = finishStage(workers, renderedFrames.load(), renderNs.load(), wall);
+        s.encode = finishStage(1, encoded, encodeNs.load(), wall);
+        s.peakReorderDepth = peakReorder;
+        s.cancelled = cancelled;
+        *stats = s;
+    }
+    return complete && closed;
+}
+
+} // namespace cineforge::exporter
@@ -0,0 +1,43 @@
+#include "cineforge/exporter/TestPatternSource.h"
+
+namespace cineforge::exporter {
+
+void TestPatternSource::pixel(std::int64_t frame, int x, int y, std::uint8_t rgba[4]) {
+    const auto f = static_cast<int>(frame & 0xFFFF);
+    rgba[0] = static_cast<std::uint8_t>(x + f * 4);
+    rgba[1] = static_cast<std::uint8_t>(y + f * 2);
+    rgba[2] = static_cast<std::uint8_t>((x ^ y) + f);
+    rgba[3] = 255;
+    // Top 8 rows: the low 16 bits of the frame number, least significant
+    // first in 8-pixel cells, so reordering bugs are visible in the output.
+    if (y < 8) {
+        const int bit = x / 8;
+        if (bit < 16) {
+            const std::uint8_t v = (f >> bit) & 1 ? 255 : 0;
+            rgba[0] = rgba[1] = rgba[2] = v;
+        }
+    }
+}
+
+bool TestPatternSource::decode(std::int64_t frame, double, render::Frame& out) {
+    using render::PixelFormat;
+    if (!out.cpuData ||
+        (out.format != PixelFormat::RGBA8 && out.format != PixelFormat::BGRA8)) {
+        return false;
+    }
+    const bool bgra = out.format == PixelFormat::BGRA8;
+    std::uint8_t rgba[4];
+    for (int y = 0; y < out.height; ++y) {
+        std::uint8_t* row = out.cpuData + static_cast<std::size_t>(y) * out.cpuStride;
+        for (int x = 0; x < out.width; ++x, row += 4) {
+            pixel(frame, x, y, rgba);
+            row[0] = rgba[bgra ? 2 : 0];
+            row[1] = rgba[1];
+            row[2] = rgba[bgra ? 0 : 2];
+            row[3] = rgba[3];
+        }
+    }
+    return true;
+}
+
+} // namespace cineforge::exporter
@@ -0,0 +1,111 @@
+#include "cineforge/exporter/Y4mSink.h"
+
+#include <algorithm>
+
+namespace cineforge::exporter {
+
+namespace {
+
+// BT.601 limited range in 8-bit fixed point.
+inline std::uint8_t lumaOf(int r, int g, int b) {
+    return static_cast<std::uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+inline std::uint8_t cbOf(int r, int g, int b) {
+    return static_cast<std::uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+inline std::uint8_t crOf(int r, int g, int b) {
+    return static_cast<std::uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+} // namespace
+
+Y4mSink::Y4mSink(std::string path, Chroma chroma)
+    : path_(std::move(path)), chroma_(chroma) {}
+
+Y4mSink::~Y4mSink() {
+    close();
+}
+
+bool Y4mSink::open(const ExportSettings& settings) {
+    close();
+    file_ = std::fopen(path_.c_str(), "wb");
+    if (!file_) {
+        return false;
+    }
+    width_ = settings.width;
+    height_ = settings.height;
+    frames_ = 0;
+    const char* tag = chroma_ == Chroma::C444 ? "C444" : "C420jpeg";
+    return std::fprintf(file_, "YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 %s XCOLORRANGE=LIMITED\n",
+                        width_, height_, settings.fpsNum, settings.fpsDen, tag) > 0;
+}
+
+bool Y4mSink::write(std::int64_t, const render::Frame& image) {
+    using render::PixelFormat;
+    if (!file_ || !image.cpuData || image.width != width_ || image.height != height_ ||
+        (image.format != PixelFormat::RGBA8 && image.format != PixelFormat::BGRA8)) {
+        return false;
+    }
+    const int ri = image.format == PixelFormat::BGRA8 ? 2 : 0;
+    const int bi = 2 - ri;
+
+    const auto w = static_cast<std::size_t>(width_);
+    const auto h = static_cast<std::size_t>(height_);
+    const std::size_t cw = chroma_ == Chroma::C444 ? w : (w + 1) / 2;
+    const std::size_t ch = chroma_ == Chroma::C444 ? h : (h + 1) / 2;
+    planes_.resize(w * h + 2 * cw * ch);
+    std::uint8_t* yp = planes_.data();
+    std::uint8_t* up = yp + w * h;
+    std::uint8_t* vp = up + cw * ch;
+
+    auto px = [&](std::size_t x, std::size_t y) {
+        return image.cpuData + y * static_cast<std::size_t>(image.cpuStride) + x * 4;
+    };
+
+    for (std::size_t y = 0; y < h; ++y) {
+        for (std::size_t x = 0; x < w; ++x) {
+            const std::uint8_t* p = px(x, y);
+            yp[y * w + x] = lumaOf(p[ri], p[1], p[bi]);
+            if (chroma_ == Chroma::C444) {
+                up[y * w + x] = cbOf(p[ri], p[1], p[bi]);
+                vp[y * w + x] = crOf(p[ri], p[1], p[bi]);
+            }
+        }
+    }
+    if (chroma_ == Chroma::C420) {
+        for (std::size_t cy = 0; cy < ch; ++cy) {
+            for (std::size_t cx = 0; cx < cw; ++cx) {
+                // Average RGB over the 2x2 block, clamped at odd edges.
+                const std::size_t x0 = cx * 2, x1 = std::min(x0 + 1, w - 1);
+                const std::size_t y0 = cy * 2, y1 = std::min(y0 + 1, h - 1);
+                const std::uint8_t* a = px(x0, y0);
+                const std::uint8_t* b = px(x1, y0);
+                const std::uint8_t* c = px(x0, y1);
+                const std::uint8_t* d = px(x1, y1);
+                const int r = (a[ri] + b[ri] + c[ri] + d[ri] + 2) >> 2;
+                const int g = (a[1] + b[1] + c[1] + d[1] + 2) >> 2;
+                const int bl = (a[bi] + b[bi] + c[bi] + d[bi] + 2) >> 2;
+                up[cy * cw + cx] = cbOf(r, g, bl);
+                vp[cy * cw + cx] = crOf(r, g, bl);
+            }
+        }
+    }
+
+    if (std::fputs("FRAME\n", file_) < 0 ||
+        std::fwrite(planes_.data(), 1, planes_.size(), file_) != planes_.size()) {
+        return false;
+    }
+    ++frames_;
+    return true;
+}
+
+bool Y4mSink::close() {
+    if (!file_) {
+        return true;
+    }
+    const bool ok = std::fclose(file_) == 0;
+    file_ = nullptr;
+    return ok;
+}
+
+} // namespace cineforge::exporter
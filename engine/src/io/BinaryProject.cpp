@@ -0,0 +1,428 @@
+#include "cineforge/io/BinaryProject.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+
+#include "cineforge/io/MappedFile.h"
+
+namespace cineforge::io {
+
+namespace {
+
+constexpr char kMagic[8] = {'C', 'F', 'P', 'R', 'O', 'J', '\r', '\n'};
+
+enum SectionId : std::uint32_t {
+    kStrings = 1,
+    kStringData = 2,
+    kTracks = 3,
+    kClips = 4,
+    kCurves = 5,
+    kKeys = 6,
+    kMedia = 7,
+};
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint32_t sectionCount;
+    std::uint32_t flags;
+    double previewTime;
+};
+
+struct SectionEntry {
+    std::uint32_t id;
+    std::uint32_t recordSize;
+    std::uint64_t offset;
+    std::uint64_t count;
+};
+
+struct StringRecord {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+struct TrackRecord {
+    std::uint32_t name;
+    std::uint32_t type;
+    std::uint32_t firstClip;
+    std::uint32_t clipCount;
+};
+
+struct ClipRecord {
+    std::uint32_t name;
+    std::uint32_t source;
+    double start;
+    double end;
+    double inPoint;
+    double outPoint;
+};
+
+struct CurveRecord {
+    std::uint32_t name;
+    std::uint32_t target;
+    std::uint32_t firstKey;
+    std::uint32_t keyCount;
+};
+
+constexpr std::uint32_t kKeyHasBezier = 1;
+
+struct KeyRecord {
+    double time;
+    double value;
+    std::uint32_t interp;
+    std::uint32_t flags;
+    float inX, inY, outX, outY;
+};
+
+// Paths are stored as raw text in StringData rather than as entries in
+// Strings, so loading does not intern them.
+struct MediaRecord {
+    std::uint32_t name;
+    std::uint32_t mediaType;
+    StringRecord path;
+    StringRecord proxyPath;
+    double duration;
+};
+
+static_assert(sizeof(FileHeader) == 32, "header layout");
+static_assert(sizeof(SectionEntry) == 24, "directory layout");
+static_assert(sizeof(ClipRecord) == 40, "clip layout");
+static_assert(sizeof(KeyRecord) == 40, "key layout");
+static_assert(sizeof(MediaRecord) == 32, "media layout");
+
+bool hostIsLittleEndian() {
+    const std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+class Writer {
+public:
+    explicit Writer(const ProjectData& project) : project_(project) {
+        strings_.push_back({0, 0});
+        index_.emplace(0u, 0u);
+    }
+
+    std::vector<std::uint8_t> encode() {
+        std::vector<TrackRecord> tracks;
+        std::vector<ClipRecord> clips;
+        std::vector<CurveRecord> curves;
+        std::vector<KeyRecord> keys;
+        std::vector<MediaRecord> media;
+
+        for (const auto& m : project_.media) {
+            media.push_back({str(m.id), str(intern(m.mediaType)), text(m.path),
+                             text(m.proxyPath), m.duration});
+        }
+        for (const auto& t : project_.tracks) {
+            tracks.push_back({str(t.id), static_cast<std::uint32_t>(t.type),
+                              static_cast<std::uint32_t>(clips.size()),
+                              static_cast<std::uint32_t>(t.clips.size())});
+            for (const auto& c : t.clips) {
+                clips.push_back({str(c.id), str(c.sourceId), c.start, c.end,
+                                 c.inPoint, c.outPoint});
+            }
+        }
+        for (const auto& c : project_.curves) {
+            curves.push_back({str(c.id), str(c.target),
+                              static_cast<std::uint32_t>(keys.size()),
+                              static_cast<std::uint32_t>(c.keys.size())});
+            for (const auto& k : c.keys) {
+                KeyRecord r{};
+                r.time = k.time;
+                r.value = k.value;
+                r.interp = static_cast<std::uint32_t>(k.interp);
+                if (k.bezier) {
+                    r.flags = kKeyHasBezier;
+                    r.inX = k.bezier->inX;
+                    r.inY = k.bezier->inY;
+                    r.outX = k.bezier->outX;
+                    r.outY = k.bezier->outY;
+                }
+                keys.push_back(r);
+            }
+        }
+
+        addSection(kStrings, strings_);
+        addSection(kStringData, stringData_);
+        addSection(kTracks, tracks);
+        addSection(kClips, clips);
+        addSection(kCurves, curves);
+        addSection(kKeys, keys);
+        addSection(kMedia, media);
+
+        FileHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kBinaryProjectVersion;
+        header.headerSize = sizeof(FileHeader);
+        header.sectionCount = static_cast<std::uint32_t>(sections_.size());
+        header.previewTime = project_.previewTime;
+
+        std::size_t offset = align(sizeof(FileHeader) +
+                                   sections_.size() * sizeof(SectionEntry));
+        for (auto& s : sections_) {
+            s.entry.offset = offset;
+            offset = align(offset + s.bytes.size());
+        }
+
+        std::vector<std::uint8_t> out(offset, 0);
+        std::memcpy(out.data(), &header, sizeof(header));
+        for (std::size_t i = 0; i < sections_.size(); ++i) {
+            std::memcpy(out.data() + sizeof(FileHeader) + i * sizeof(SectionEntry),
+                        &sections_[i].entry, sizeof(SectionEntry));
+            if (!sections_[i].bytes.empty()) {
+                std::memcpy(out.data() + sections_[i].entry.offset,
+                            sections_[i].bytes.data(), sections_[i].bytes.size());
+            }
+        }
+        return out;
+    }
+
+private:
+    struct Section {
+        SectionEntry entry;
+        std::vector<std::uint8_t> bytes;
+    };
+
+    const ProjectData& project_;
+    std::vector<StringRecord> strings_;
+    std::vector<char> stringData_;
+    std::unordered_map<std::uint32_t, std::uint32_t> index_; // Symbol -> string
+    std::vector<Section> sections_;
+
+    static std::size_t align(std::size_t n) { return (n + 7) & ~std::size_t{7}; }
+
+    std::uint32_t str(Symbol s) {
+        auto [it, inserted] =
+            index_.emplace(s.value, static_cast<std::uint32_t>(strings_.size()));
+        if (inserted) {
+            const std::string& name = nameOf(s);
+            strings_.push_back({static_cast<std::uint32_t>(stringData_.size()),
+                                static_cast<std::uint32_t>(name.size())});
+            stringData_.insert(stringData_.end(), name.begin(), name.end());
+        }
+        return it->second;
+    }
+
+    StringRecord text(const std::string& s) {
+        const StringRecord r{static_cast<std::uint32_t>(stringData_.size()),
+                             static_cast<std::uint32_t>(s.size())};
+        stringData_.insert(stringData_.end(), s.begin(), s.end());
+        return r;
+    }
+
+    template <typename T>
+    void addSection(std::uint32_t id, const std::vector<T>& records) {
+        Section s;
+        s.entry = {id, static_cast<std::uint32_t>(sizeof(T)), 0, records.size()};
+        s.bytes.resize(records.size() * sizeof(T));
+        if (!records.empty()) {
+            std::memcpy(s.bytes.data(), records.data(), s.bytes.size());
+        }
+        sections_.push_back(std::move(s));
+    }
+};
+
+// A section as found in the file. Records are copied out rather than
+// cast in place, so the mapping needs no particular alignment and shorter
+// (older) records read as zero-extended.
+struct Table {
+    const std::uint8_t* base = nullptr;
+    std::uint64_t count = 0;
+    std::uint32_t recordSize = 0;
+
+    template <typename T>
+    T at(std::uint64_t i) const {
+        T r{};
+        std::memcpy(&r, base + i * recordSize, std::min<std::size_t>(recordSize, sizeof(T)));
+        return r;
+    }
+};
+
+} // namespace
+
+bool isBinaryProject(const void* data, std::size_t size) {
+    return size >= sizeof(kMagic) && std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+}
+
+std::vector<std::uint8_t> encodeBinaryProject(const ProjectData& project) {
+    if (!hostIsLittleEndian()) {
+        return {};
+    }
+    return Writer(project).encode();
+}
+
+bool decodeBinaryProject(const void* data, std::size_t size, ProjectData& out) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    if (!hostIsLittleEndian() || !isBinaryProject(data, size) ||
+        size < sizeof(FileHeader)) {
+        return false;
+    }
+    FileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.version == 0 || header.version > kBinaryProjectVersion ||
+        header.headerSize < sizeof(FileHeader) || header.headerSize > size ||
+        header.sectionCount > (size - header.headerSize) / sizeof(SectionEntry)) {
+        return false;
+    }
+
+    Table tables[kMedia + 1];
+    for (std::uint32_t i = 0; i < header.sectionCount; ++i) {
+        SectionEntry e;
+        std::memcpy(&e, bytes + header.headerSize + i * sizeof(SectionEntry), sizeof(e));
+        if (e.recordSize == 0 || e.offset > size ||
+            e.count > (size - e.offset) / e.recordSize) {
+            return false;
+        }
+        if (e.id < std::size(tables)) {
+            tables[e.id] = {bytes + e.offset, e.count, e.recordSize};
+        }
+    }
+
+    const Table& strings = tables[kStrings];
+    const Table& stringData = tables[kStringData];
+    const Table& tracks = tables[kTracks];
+    const Table& clips = tables[kClips];
+    const Table& curves = tables[kCurves];
+    const Table& keys = tables[kKeys];
+    const Table& media = tables[kMedia];
+    if (stringData.recordSize > 1 ||
+        strings.count > std::numeric_limits<std::uint32_t>::max()) {
+        return false;
+    }
+
+    // Each distinct name is interned exactly once, in one batch.
+    std::vector<std::string_view> names(static_cast<std::size_t>(strings.count));
+    const char* chars = reinterpret_cast<const char*>(stringData.base);
+    for (std::uint64_t i = 0; i < strings.count; ++i) {
+        const auto s = strings.at<StringRecord>(i);
+        if (std::uint64_t{s.offset} + s.length > stringData.count) {
+            return false;
+        }
+        names[i] = std::string_view(chars + s.offset, s.length);
+    }
+    std::vector<Symbol> symbols(names.size());
+    SymbolTable::global().internAll(names.data(), names.size(), symbols.data());
+    auto symbol = [&](std::uint32_t i, Symbol& sym) {
+        if (i >= symbols.size()) {
+            return false;
+        }
+        sym = symbols[i];
+        return true;
+    };
+
+    out = ProjectData{};
+    out.previewTime = header.previewTime;
+
+    out.tracks.resize(static_cast<std::size_t>(tracks.count));
+    for (std::uint64_t i = 0; i < tracks.count; ++i) {
+        const auto r = tracks.at<TrackRecord>(i);
+        auto& t = out.tracks[i];
+        if (!symbol(r.name, t.id) ||
+            std::uint64_t{r.firstClip} + r.clipCount > clips.count) {
+            return false;
+        }
+        t.type = r.type <= static_cast<std::uint32_t>(timeline::TrackType::Unknown)
+                     ? static_cast<timeline::TrackType>(r.type)
+                     : timeline::TrackType::Unknown;
+        t.clips.resize(r.clipCount);
+        for (std::uint32_t j = 0; j < r.clipCount; ++j) {
+            const auto c = clips.at<ClipRecord>(r.firstClip + std::uint64_t{j});
+            auto& clip = t.clips[j];
+            if (!symbol(c.name, clip.id) || !symbol(c.source, clip.sourceId)) {
+                return false;
+            }
+            clip.start = c.start;
+            clip.end = c.end;
+            clip.inPoint = c.inPoint;
+            clip.outPoint = c.outPoint;
+        }
+    }
+
+    out.curves.resize(static_cast<std::size_t>(curves.count));
+    for (std::uint64_t i = 0; i < curves.count; ++i) {
+        const auto r = curves.at<CurveRecord>(i);
+        auto& curve = out.curves[i];
+        if (!symbol(r.name, curve.id) || !symbol(r.target, curve.target) ||
+            std::uint64_t{r.firstKey} + r.keyCount > keys.count) {
+            return false;
+        }
+        curve.keys.resize(r.keyCount);
+        for (std::uint32_t j = 0; j < r.keyCount; ++j) {
+            const auto k = keys.at<KeyRecord>(r.firstKey + std::uint64_t{j});
+            auto& key = curve.keys[j];
+            key.time = k.time;
+            key.value = k.value;
+            key.interp =
+                k.interp <= static_cast<std::uint32_t>(timeline::InterpolationType::EaseInOut)
+                    ? static_cast<timeline::InterpolationType>(k.interp)
+                    : timeline::InterpolationType::Linear;
+            if (k.flags & kKeyHasBezier) {
+                key.bezier = timeline::BezierHandles{k.inX, k.inY, k.outX, k.outY};
+            }
+        }
+    }
+
+    auto text = [&](const StringRecord& r, std::string& s) {
+        if (std::uint64_t{r.offset} + r.length > stringData.count) {
+            return false;
+        }
+        s.assign(chars + r.offset, r.length);
+        return true;
+    };
+    out.media.resize(static_cast<std::size_t>(media.count));
+    for (std::uint64_t i = 0; i < media.count; ++i) {
+        const auto r = media.at<MediaRecord>(i);
+        auto& m = out.media[i];
+        Symbol type;
+        if (!symbol(r.name, m.id) || !symbol(r.mediaType, type) ||
+            !text(r.path, m.path) || !text(r.proxyPath, m.proxyPath)) {
+            return false;
+        }
+        m.mediaType = nameOf(type);
+        m.duration = r.duration;
+    }
+    return true;
+}
+
+bool saveBinaryProject(const std::string& path, const ProjectData& project) {
+    const std::vector<std::uint8_t> bytes = encodeBinaryProject(project);
+    if (bytes.empty()) {
+        return false;
+    }
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.write(reinterpret_cast<const char*>(bytes.data()),
+                       static_cast<std::streamsize>(bytes.size())) ||
+            !out.flush()) {
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool loadBinaryProject(const std::string& path, ProjectData& out) {
+    MappedFile file;
+    return file.open(path) && decodeBinaryProject(file.data(), file.size(), out);
+}
+
+} // namespace cineforge::io
@@ -0,0 +1,639 @@
+#include "cineforge/io/EditJournal.h"
+
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <string_view>
+#include <system_error>
+
+#include "cineforge/io/BinaryProject.h"
+#include "cineforge/io/MappedFile.h"
+#include "cineforge/media/SourceFingerprint.h"
+
+namespace cineforge::io {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char kMagic[8] = {'C', 'F', 'J', 'R', 'N', 'L', '\r', '\n'};
+constexpr std::uint32_t kJournalVersion = 1;
+
+struct JournalHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t generation;
+};
+
+// Precedes every record; `check` is the low half of the payload's FNV-1a.
+struct RecordHeader {
+    std::uint32_t size;
+    std::uint32_t check;
+};
+
+static_assert(sizeof(JournalHeader) == 24, "journal header layout");
+static_assert(sizeof(RecordHeader) == 8, "record header layout");
+
+enum Op : std::uint8_t {
+    kAddTrack = 1,
+    kAddClip = 2,
+    kSplitClip = 3,
+    kMoveClip = 4,
+    kRemoveClip = 5,
+    kClearTimeline = 6,
+    kSetCurve = 7,
+    kRemoveCurve = 8,
+    kClearCurves = 9,
+};
+
+constexpr std::uint8_t kKeyHasBezier = 1;
+
+std::uint32_t checksum(const std::uint8_t* data, std::size_t size) {
+    return static_cast<std::uint32_t>(media::fnv1a64(data, size));
+}
+
+std::string snapshotName(std::uint64_t g) {
+    return "snapshot-" + std::to_string(g) + ".cfp";
+}
+
+std::string journalName(std::uint64_t g) {
+    return "journal-" + std::to_string(g) + ".log";
+}
+
+// Recognises snapshot-<g>.cfp and journal-<g>.log, and the .tmp files a
+// save in progress leaves behind.
+bool parseName(std::string name, bool& snapshot, bool& temporary, std::uint64_t& g) {
+    temporary = name.size() > 4 && name.compare(name.size() - 4, 4, ".tmp") == 0;
+    if (temporary) {
+        name.resize(name.size() - 4);
+    }
+    std::size_t digits;
+    if (name.rfind("snapshot-", 0) == 0 && name.size() > 13 &&
+        name.compare(name.size() - 4, 4, ".cfp") == 0) {
+        snapshot = true;
+        digits = 9;
+    } else if (name.rfind("journal-", 0) == 0 && name.size() > 12 &&
+               name.compare(name.size() - 4, 4, ".log") == 0) {
+        snapshot = false;
+        digits = 8;
+    } else {
+        return false;
+    }
+    g = 0;
+    for (std::size_t i = digits; i + 4 < name.size(); ++i) {
+        const char c = name[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        g = g * 10 + static_cast<std::uint64_t>(c - '0');
+    }
+    return true;
+}
+
+struct Generation {
+    bool snapshot = false;
+    bool journal = false;
+};
+
+std::map<std::uint64_t, Generation> listGenerations(const std::string& dir) {
+    std::map<std::uint64_t, Generation> out;
+    std::error_code ec;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        bool snapshot, temporary;
+        std::uint64_t g;
+        if (parseName(it->path().filename().string(), snapshot, temporary, g) && !temporary) {
+            (snapshot ? out[g].snapshot : out[g].journal) = true;
+        }
+    }
+    return out;
+}
+
+// Deletes every generation before `keep`, and leftover temporaries.
+void removeOlder(const std::string& dir, std::uint64_t keep) {
+    std::vector<fs::path> doomed;
+    std::error_code ec;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        bool snapshot, temporary;
+        std::uint64_t g;
+        if (parseName(it->path().filename().string(), snapshot, temporary, g) && g < keep) {
+            doomed.push_back(it->path());
+        }
+    }
+    for (const auto& path : doomed) {
+        fs::remove(path, ec);
+    }
+}
+
+class Encoder {
+public:
+    explicit Encoder(std::vector<std::uint8_t>& out) : out_(out) { out_.clear(); }
+
+    template <typename T>
+    void put(T v) {
+        const auto* p = reinterpret_cast<const std::uint8_t*>(&v);
+        out_.insert(out_.end(), p, p + sizeof(T));
+    }
+
+    void name(Symbol s) {
+        const std::string& text = nameOf(s);
+        put(static_cast<std::uint32_t>(text.size()));
+        out_.insert(out_.end(), text.begin(), text.end());
+    }
+
+    void clip(const timeline::Clip& c) {
+        name(c.id);
+        name(c.sourceId);
+        put(c.start);
+        put(c.end);
+        put(c.inPoint);
+        put(c.outPoint);
+    }
+
+    void key(const timeline::Keyframe& k) {
+        put(k.time);
+        put(k.value);
+        put(static_cast<std::uint8_t>(k.interp));
+        put(static_cast<std::uint8_t>(k.bezier ? kKeyHasBezier : 0));
+        if (k.bezier) {
+            put(k.bezier->inX);
+            put(k.bezier->inY);
+            put(k.bezier->outX);
+            put(k.bezier->outY);
+        }
+    }
+
+private:
+    std::vector<std::uint8_t>& out_;
+};
+
+// Bounds-checked reads; any overrun marks the whole record bad.
+class Decoder {
+public:
+    Decoder(const std::uint8_t* data, std::size_t size) : p_(data), end_(data + size) {}
+
+    bool ok() const { return ok_; }
+    bool done() const { return ok_ && p_ == end_; }
+
+    template <typename T>
+    T get() {
+        T v{};
+        if (static_cast<std::size_t>(end_ - p_) < sizeof(T)) {
+            ok_ = false;
+            return v;
+        }
+        std::memcpy(&v, p_, sizeof(T));
+        p_ += sizeof(T);
+        return v;
+    }
+
+    Symbol name() {
+        const auto size = get<std::uint32_t>();
+        if (!ok_ || static_cast<std::size_t>(end_ - p_) < size) {
+            ok_ = false;
+            return Symbol{};
+        }
+        const std::string_view text(reinterpret_cast<const char*>(p_), size);
+        p_ += size;
+        return intern(text);
+    }
+
+    timeline::Clip clip() {
+        timeline::Clip c;
+        c.id = name();
+        c.sourceId = name();
+        c.start = get<double>();
+        c.end = get<double>();
+        c.inPoint = get<double>();
+        c.outPoint = get<double>();
+        return c;
+    }
+
+    timeline::Keyframe key() {
+        timeline::Keyframe k;
+        k.time = get<double>();
+        k.value = get<double>();
+        const auto interp = get<std::uint8_t>();
+        k.interp = interp <= static_cast<std::uint8_t>(timeline::InterpolationType::EaseInOut)
+                       ? static_cast<timeline::InterpolationType>(interp)
+                       : timeline::InterpolationType::Linear;
+        if (get<std::uint8_t>() & kKeyHasBezier) {
+            timeline::BezierHandles h;
+            h.inX = get<float>();
+            h.inY = get<float>();
+            h.outX = get<float>();
+            h.outY = get<float>();
+            k.bezier = h;
+        }
+        return k;
+    }
+
+    // Element count that cannot exceed the bytes left, so a corrupt count
+    // cannot trigger a huge allocation.
+    std::uint32_t count(std::size_t minElementSize) {
+        const auto n = get<std::uint32_t>();
+        if (static_cast<std::size_t>(end_ - p_) / minElementSize < n) {
+            ok_ = false;
+            return 0;
+        }
+        return n;
+    }
+
+private:
+    const std::uint8_t* p_;
+    const std::uint8_t* end_;
+    bool ok_ = true;
+};
+
+// Applies one record; false if it does not decode.
+bool replayRecord(Decoder& in, timeline::Timeline& tl, timeline::KeyframeManager& km) {
+    const auto op = in.get<std::uint8_t>();
+    switch (op) {
+    case kAddTrack: {
+        timeline::Track track;
+        track.id = in.name();
+        const auto type = in.get<std::uint8_t>();
+        track.type = type <= static_cast<std::uint8_t>(timeline::TrackType::Unknown)
+                         ? static_cast<timeline::TrackType>(type)
+                         : timeline::TrackType::Unknown;
+        const auto n = in.count(40);
+        track.clips.reserve(n);
+        for (std::uint32_t i = 0; i < n && in.ok(); ++i) {
+            track.clips.push_back(in.clip());
+        }
+        if (!in.done()) {
+            return false;
+        }
+        tl.addTrack(track);
+        return true;
+    }
+    case kAddClip: {
+        const Symbol track = in.name();
+        const timeline::Clip clip = in.clip();
+        if (!in.done()) {
+            return false;
+        }
+        tl.addClip(track, clip);
+        return true;
+    }
+    case kSplitClip:
+    case kMoveClip: {
+        const Symbol clip = in.name();
+        const auto time = in.get<double>();
+        if (!in.done()) {
+            return false;
+        }
+        if (op == kSplitClip) {
+            tl.splitClip(clip, time);
+        } else {
+            tl.moveClip(clip, time);
+        }
+        return true;
+    }
+    case kRemoveClip: {
+        const Symbol clip = in.name();
+        if (!in.done()) {
+            return false;
+        }
+        tl.removeClip(clip);
+        return true;
+    }
+    case kClearTimeline:
+        if (!in.done()) {
+            return false;
+        }
+        tl.clear();
+        return true;
+    case kSetCurve: {
+        timeline::KeyframeCurve curve;
+        curve.id = in.name();
+        curve.target = in.name();
+        const auto n = in.count(18);
+        std::vector<timeline::Keyframe> keys;
+        keys.reserve(n);
+        for (std::uint32_t i = 0; i < n && in.ok(); ++i) {
+            keys.push_back(in.key());
+        }
+        if (!in.done()) {
+            return false;
+        }
+        curve.setKeys(std::move(keys));
+        km.registerCurve(curve);
+        return true;
+    }
+    case kRemoveCurve: {
+        const Symbol id = in.name();
+        if (!in.done()) {
+            return false;
+        }
+        km.removeCurve(id);
+        return true;
+    }
+    case kClearCurves:
+        if (!in.done()) {
+            return false;
+        }
+        km.clear();
+        return true;
+    default: return false;
+    }
+}
+
+// Replays journal `g`; false if it is missing, damaged or ends in a torn
+// record, in which case later journals must not be applied either.
+bool replayJournal(const std::string& dir, std::uint64_t g, timeline::Timeline& tl,
+                   timeline::KeyframeManager& km) {
+    MappedFile file;
+    if (!file.open((fs::path(dir) / journalName(g)).string())) {
+        return false;
+    }
+    const auto* bytes = static_cast<const std::uint8_t*>(file.data());
+    const std::size_t size = file.size();
+    JournalHeader header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kJournalVersion || header.generation != g) {
+        return false;
+    }
+    std::size_t pos = sizeof(header);
+    while (pos < size) {
+        RecordHeader rec;
+        if (size - pos < sizeof(rec)) {
+            return false;
+        }
+        std::memcpy(&rec, bytes + pos, sizeof(rec));
+        pos += sizeof(rec);
+        if (size - pos < rec.size || checksum(bytes + pos, rec.size) != rec.check) {
+            return false;
+        }
+        Decoder in(bytes + pos, rec.size);
+        if (!replayRecord(in, tl, km)) {
+            return false;
+        }
+        pos += rec.size;
+    }
+    return true;
+}
+
+} // namespace
+
+EditJournal::~EditJournal() {
+    close();
+}
+
+bool EditJournal::open(const std::string& dir, SnapshotFn snapshot) {
+    close();
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    const auto existing = listGenerations(dir);
+    const std::uint64_t g = existing.empty() ? 1 : existing.rbegin()->first + 1;
+    if (!saveBinaryProject((fs::path(dir) / snapshotName(g)).string(), snapshot())) {
+        return false;
+    }
+    dir_ = dir;
+    snapshot_ = std::move(snapshot);
+    if (!startGeneration(g)) {
+        return false;
+    }
+    removeOlder(dir_, g);
+    return true;
+}
+
+void EditJournal::close() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        worker_.join();
+        stop_ = false;
+    }
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool EditJournal::startGeneration(std::uint64_t generation) {
+    const std::string path = (fs::path(dir_) / journalName(generation)).string();
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    JournalHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kJournalVersion;
+    header.generation = generation;
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1 || std::fflush(file) != 0) {
+        std::fclose(file);
+        std::error_code ec;
+        fs::remove(path, ec);
+        return false;
+    }
+    if (file_) {
+        std::fclose(file_);
+    }
+    file_ = file;
+    generation_ = generation;
+    bytes_ = sizeof(header);
+    return true;
+}
+
+void EditJournal::record(const timeline::TimelineEdit& edit) {
+    if (!file_) {
+        return;
+    }
+    using Kind = timeline::TimelineEdit::Kind;
+    Encoder out(record_);
+    switch (edit.kind) {
+    case Kind::AddTrack:
+        out.put(kAddTrack);
+        out.name(edit.track->id);
+        out.put(static_cast<std::uint8_t>(edit.track->type));
+        out.put(static_cast<std::uint32_t>(edit.track->clips.size()));
+        for (const auto& c : edit.track->clips) {
+            out.clip(c);
+        }
+        break;
+    case Kind::AddClip:
+        out.put(kAddClip);
+        out.name(edit.target);
+        out.clip(*edit.clip);
+        break;
+    case Kind::SplitClip:
+    case Kind::MoveClip:
+        out.put(edit.kind == Kind::SplitClip ? kSplitClip : kMoveClip);
+        out.name(edit.target);
+        out.put(edit.time);
+        break;
+    case Kind::RemoveClip:
+        out.put(kRemoveClip);
+        out.name(edit.target);
+        break;
+    case Kind::Clear: out.put(kClearTimeline); break;
+    }
+    append();
+}
+
+void EditJournal::record(const timeline::CurveEdit& edit) {
+    if (!file_) {
+        return;
+    }
+    using Kind = timeline::CurveEdit::Kind;
+    Encoder out(record_);
+    switch (edit.kind) {
+    case Kind::Set:
+        out.put(kSetCurve);
+        out.name(edit.curve->id);
+        out.name(edit.curve->target);
+        out.put(static_cast<std::uint32_t>(edit.curve->keys().size()));
+        for (const auto& k : edit.curve->keys()) {
+            out.key(k);
+        }
+        break;
+    case Kind::Remove:
+        out.put(kRemoveCurve);
+        out.name(edit.id);
+        break;
+    case Kind::Clear: out.put(kClearCurves); break;
+    }
+    append();
+}
+
+// Writes record_ and flushes it to the OS, so it survives the process
+// crashing. A failed write stops journaling rather than leave a gap.
+void EditJournal::append() {
+    const RecordHeader rec{static_cast<std::uint32_t>(record_.size()),
+                           checksum(record_.data(), record_.size())};
+    if (std::fwrite(&rec, sizeof(rec), 1, file_) != 1 ||
+        std::fwrite(record_.data(), 1, record_.size(), file_) != record_.size() ||
+        std::fflush(file_) != 0) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return;
+    }
+    bytes_ += sizeof(rec) + record_.size();
+    if (bytes_ >= threshold_) {
+        compact();
+    }
+}
+
+void EditJournal::compact() {
+    // The copy is taken before any further edit is recorded, so it is
+    // exactly the state the finished journal ends in.
+    if (!file_ || !startGeneration(generation_ + 1)) {
+        return;
+    }
+    PendingSnapshot job{generation_, snapshot_()};
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        pending_ = std::move(job);
+    }
+    if (!worker_.joinable()) {
+        worker_ = std::thread([this] { workerLoop(); });
+    }
+    cv_.notify_all();
+}
+
+bool EditJournal::restart() {
+    if (!file_) {
+        return false;
+    }
+    // A snapshot still queued is of the replaced project; let a write in
+    // progress finish so it cannot race the cleanup below.
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        pending_.reset();
+    }
+    waitIdle();
+    const std::uint64_t g = generation_ + 1;
+    if (!saveBinaryProject((fs::path(dir_) / snapshotName(g)).string(), snapshot_()) ||
+        !startGeneration(g)) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    removeOlder(dir_, g);
+    return true;
+}
+
+void EditJournal::waitIdle() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait(lock, [this] { return !pending_ && !writing_; });
+}
+
+void EditJournal::workerLoop() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    for (;;) {
+        cv_.wait(lock, [this] { return stop_ || pending_; });
+        if (!pending_) {
+            return;
+        }
+        PendingSnapshot job = std::move(*pending_);
+        pending_.reset();
+        writing_ = true;
+        lock.unlock();
+
+        // If this fails the older generations stay, and the next
+        // compaction tries again.
+        if (saveBinaryProject((fs::path(dir_) / snapshotName(job.generation)).string(),
+                              job.data)) {
+            removeOlder(dir_, job.generation);
+        }
+
+        lock.lock();
+        writing_ = false;
+        cv_.notify_all();
+    }
+}
+
+bool EditJournal::recover(const std::string& dir, ProjectData& out) {
+    const auto generations = listGenerations(dir);
+    ProjectData base;
+    auto it = generations.rbegin();
+    for (; it != generations.rend(); ++it) {
+        if (it->second.snapshot &&
+            loadBinaryProject((fs::path(dir) / snapshotName(it->first)).string(), base)) {
+            break;
+        }
+    }
+    if (it == generations.rend()) {
+        return false;
+    }
+
+    timeline::Timeline tl;
+    timeline::KeyframeManager km;
+    for (const auto& track : base.tracks) {
+        tl.addTrack(track);
+    }
+    for (auto& data : base.curves) {
+        timeline::KeyframeCurve curve;
+        curve.id = data.id;
+        curve.target = data.target;
+        curve.setKeys(std::move(data.keys));
+        km.registerCurve(curve);
+    }
+    for (std::uint64_t g = it->first;; ++g) {
+        auto j = generations.find(g);
+        if (j == generations.end() || !j->second.journal || !replayJournal(dir, g, tl, km)) {
+            break;
+        }
+    }
+
+    out.previewTime = base.previewTime;
+    out.media = std::move(base.media);
+    out.tracks = tl.tracks();
+    out.curves.clear();
+    out.curves.reserve(km.curveCount());
+    for (std::size_t slot = 0; slot < km.curveCount(); ++slot) {
+        const auto* curve = km.getCurve(km.curveAt(slot));
+        out.curves.push_back({curve->id, curve->target, curve->keys()});
+    }
+    return true;
+}
+
+} // namespace cineforge::io
@@ -0,0 +1,371 @@
+#include "cineforge/io/JsonReader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <system_error>
+
+namespace cineforge::io {
+
+namespace {
+
+bool isNumberChar(int c) {
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' ||
+           c == 'E';
+}
+
+} // namespace
+
+bool JsonReader::parse(const RefillFn& refill, JsonHandler& handler) {
+    chunk_.resize(std::max<std::size_t>(limits_.chunkSize, 1));
+    refill_ = &refill;
+    data_ = chunk_.data();
+    pos_ = len_ = consumed_ = 0;
+    eof_ = false;
+    const bool ok = run(handler);
+    refill_ = nullptr;
+    return ok;
+}
+
+bool JsonReader::parse(std::string_view text, JsonHandler& handler) {
+    refill_ = nullptr;
+    data_ = text.data();
+    pos_ = 0;
+    len_ = text.size();
+    consumed_ = 0;
+    eof_ = true;
+    return run(handler);
+}
+
+void JsonReader::fail(std::string message) {
+    error_ = std::move(message);
+    errorOffset_ = consumed_ + pos_;
+}
+
+bool JsonReader::setError(const char* message) {
+    fail(message);
+    return false;
+}
+
+bool JsonReader::handlerFailed() {
+    if (error_.empty()) {
+        fail("rejected by handler");
+    }
+    return false;
+}
+
+bool JsonReader::refill() {
+    if (eof_ || !refill_) {
+        return false;
+    }
+    consumed_ += len_;
+    pos_ = 0;
+    len_ = std::min((*refill_)(chunk_.data(), chunk_.size()), chunk_.size());
+    eof_ = len_ == 0;
+    return !eof_;
+}
+
+inline int JsonReader::peek() {
+    if (pos_ == len_ && !refill()) {
+        return -1;
+    }
+    return static_cast<unsigned char>(data_[pos_]);
+}
+
+inline int JsonReader::get() {
+    const int c = peek();
+    if (c >= 0) {
+        ++pos_;
+    }
+    return c;
+}
+
+int JsonReader::skipWhitespace() {
+    for (;;) {
+        const int c = peek();
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            return c;
+        }
+        ++pos_;
+    }
+}
+
+bool JsonReader::readHex4(unsigned& value) {
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+        const int c = get();
+        value <<= 4;
+        if (c >= '0' && c <= '9') {
+            value |= static_cast<unsigned>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            value |= static_cast<unsigned>(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            value |= static_cast<unsigned>(c - 'A' + 10);
+        } else {
+            return setError("invalid \\u escape");
+        }
+    }
+    return true;
+}
+
+bool JsonReader::appendUtf8(unsigned cp) {
+    if (cp < 0x80) {
+        token_.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        token_.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        token_.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        token_.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        token_.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        token_.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        token_.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        token_.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        token_.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        token_.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+    return true;
+}
+
+// Called after the opening quote; leaves the unescaped text in token_.
+bool JsonReader::readString() {
+    token_.clear();
+    for (;;) {
+        // Copy runs of plain characters straight out of the chunk.
+        const std::size_t start = pos_;
+        while (pos_ < len_) {
+            const auto ch = static_cast<unsigned char>(data_[pos_]);
+            if (ch == '"' || ch == '\\' || ch < 0x20) {
+                break;
+            }
+            ++pos_;
+        }
+        token_.append(data_ + start, pos_ - start);
+        if (token_.size() > limits_.maxTokenSize) {
+            return setError("string too long");
+        }
+
+        const int c = get();
+        if (c < 0) {
+            return setError("unterminated string");
+        }
+        if (c == '"') {
+            return true;
+        }
+        if (c != '\\') {
+            if (c < 0x20) {
+                return setError("control character in string");
+            }
+            // Chunk boundary in the middle of a run.
+            token_.push_back(static_cast<char>(c));
+            continue;
+        }
+
+        const int e = get();
+        switch (e) {
+        case '"': token_.push_back('"'); break;
+        case '\\': token_.push_back('\\'); break;
+        case '/': token_.push_back('/'); break;
+        case 'b': token_.push_back('\b'); break;
+        case 'f': token_.push_back('\f'); break;
+        case 'n': token_.push_back('\n'); break;
+        case 'r': token_.push_back('\r'); break;
+        case 't': token_.push_back('\t'); break;
+        case 'u': {
+            unsigned cp;
+            if (!readHex4(cp)) {
+                return false;
+            }
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                unsigned low;
+                if (get() != '\\' || get() != 'u' || !readHex4(low) || low < 0xDC00 ||
+                    low > 0xDFFF) {
+                    return setError("unpaired surrogate");
+                }
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                return setError("unpaired surrogate");
+            }
+            appendUtf8(cp);
+            break;
+        }
+        default:
+            return setError("invalid escape");
+        }
+    }
+}
+
+bool JsonReader::readNumber(double& value) {
+    token_.clear();
+    for (int c = peek(); isNumberChar(c); c = peek()) {
+        token_.push_back(static_cast<char>(c));
+        ++pos_;
+        if (token_.size() > limits_.maxTokenSize) {
+            return setError("number too long");
+        }
+    }
+    const char* begin = token_.c_str();
+#if defined(__cpp_lib_to_chars)
+    const auto [end, ec] = std::from_chars(begin, begin + token_.size(), value);
+    if (ec == std::errc::result_out_of_range) {
+        return setError("number out of range");
+    }
+    if (ec != std::errc() || end != begin + token_.size()) {
+        return setError("invalid number");
+    }
+#else
+    char* end = nullptr;
+    value = std::strtod(begin, &end);
+    if (end != begin + token_.size() || token_.empty()) {
+        return setError("invalid number");
+    }
+    if (!std::isfinite(value)) {
+        return setError("number out of range");
+    }
+#endif
+    return true;
+}
+
+bool JsonReader::readLiteral(const char* rest) {
+    for (; *rest; ++rest) {
+        if (get() != *rest) {
+            return setError("invalid literal");
+        }
+    }
+    return true;
+}
+
+bool JsonReader::run(JsonHandler& h) {
+    error_.clear();
+    errorOffset_ = 0;
+
+    enum class State { Value, Key, After };
+    State state = State::Value;
+    // One byte per open container: '{' or '['.
+    std::vector<char> stack;
+
+    for (;;) {
+        int c = skipWhitespace();
+        switch (state) {
+        case State::Value:
+            if (c < 0) {
+                return setError("unexpected end of input");
+            }
+            ++pos_;
+            switch (c) {
+            case '{':
+            case '[':
+                if (stack.size() >= limits_.maxDepth) {
+                    return setError("nesting too deep");
+                }
+                if (!(c == '{' ? h.startObject() : h.startArray())) {
+                    return handlerFailed();
+                }
+                stack.push_back(static_cast<char>(c));
+                if (skipWhitespace() == (c == '{' ? '}' : ']')) {
+                    ++pos_;
+                    stack.pop_back();
+                    if (!(c == '{' ? h.endObject() : h.endArray())) {
+                        return handlerFailed();
+                    }
+                    state = State::After;
+                } else {
+                    state = c == '{' ? State::Key : State::Value;
+                }
+                break;
+            case '"':
+                if (!readString()) {
+                    return false;
+                }
+                if (!h.string(token_)) {
+                    return handlerFailed();
+                }
+                state = State::After;
+                break;
+            case 't':
+            case 'f':
+                if (!readLiteral(c == 't' ? "rue" : "alse")) {
+                    return false;
+                }
+                if (!h.boolean(c == 't')) {
+                    return handlerFailed();
+                }
+                state = State::After;
+                break;
+            case 'n':
+                if (!readLiteral("ull")) {
+                    return false;
+                }
+                if (!h.null()) {
+                    return handlerFailed();
+                }
+                state = State::After;
+                break;
+            default: {
+                if (c != '-' && (c < '0' || c > '9')) {
+                    --pos_;
+                    return setError("unexpected character");
+                }
+                --pos_;
+                double v;
+                if (!readNumber(v)) {
+                    return false;
+                }
+                if (!h.number(v)) {
+                    return handlerFailed();
+                }
+                state = State::After;
+                break;
+            }
+            }
+            break;
+
+        case State::Key:
+            if (c != '"') {
+                return setError("expected object key");
+            }
+            ++pos_;
+            if (!readString()) {
+                return false;
+            }
+            if (!h.key(token_)) {
+                return handlerFailed();
+            }
+            if (skipWhitespace() != ':') {
+                return setError("expected ':'");
+            }
+            ++pos_;
+            state = State::Value;
+            break;
+
+        case State::After:
+            if (stack.empty()) {
+                return c < 0 || setError("trailing characters after document");
+            }
+            if (c < 0) {
+                return setError("unexpected end of input");
+            }
+            ++pos_;
+            if (c == ',') {
+                state = stack.back() == '{' ? State::Key : State::Value;
+            } else if (c == '}' && stack.back() == '{') {
+                stack.pop_back();
+                if (!h.endObject()) {
+                    return handlerFailed();
+                }
+            } else if (c == ']' && stack.back() == '[') {
+                stack.pop_back();
+                if (!h.endArray()) {
+                    return handlerFailed();
+                }
+            } else {
+                --pos_;
+                return setError("expected ',' or a closing bracket");
+            }
+            break;
+        }
+    }
+}
+
+} // namespace cineforge::io
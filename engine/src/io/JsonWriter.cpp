@@ -0,0 +1,189 @@
+#include "cineforge/io/JsonWriter.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace cineforge::io {
+
+JsonWriter::JsonWriter(std::string& out, int indent) : buf_(out), indent_(indent) {}
+
+JsonWriter::JsonWriter(Sink sink, int indent, std::size_t bufferSize)
+    : buf_(own_), sink_(std::move(sink)), bufferSize_(bufferSize), indent_(indent) {
+    own_.reserve(bufferSize_ + 256);
+}
+
+JsonWriter::~JsonWriter() {
+    finish();
+}
+
+bool JsonWriter::finish() {
+    if (sink_ && !buf_.empty()) {
+        failed_ = failed_ || !sink_(buf_.data(), buf_.size());
+        buf_.clear();
+    }
+    return !failed_;
+}
+
+void JsonWriter::maybeFlush() {
+    if (sink_ && buf_.size() >= bufferSize_) {
+        finish();
+    }
+}
+
+void JsonWriter::raw(const char* data, std::size_t size) {
+    buf_.append(data, size);
+}
+
+void JsonWriter::newline(std::size_t depth) {
+    if (indent_ > 0) {
+        buf_.push_back('\n');
+        buf_.append(depth * static_cast<std::size_t>(indent_), ' ');
+    }
+}
+
+// Emits the separator and indentation that precede a value (or a key).
+void JsonWriter::beforeValue() {
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+    if (levels_.empty()) {
+        return;
+    }
+    Level& level = levels_.back();
+    if (!level.empty) {
+        buf_.push_back(',');
+    }
+    level.empty = false;
+    newline(levels_.size());
+}
+
+void JsonWriter::open(char bracket, bool object) {
+    beforeValue();
+    buf_.push_back(bracket);
+    levels_.push_back({object, true});
+}
+
+void JsonWriter::close(char bracket) {
+    const bool empty = levels_.back().empty;
+    levels_.pop_back();
+    if (!empty) {
+        newline(levels_.size());
+    }
+    buf_.push_back(bracket);
+    maybeFlush();
+}
+
+JsonWriter& JsonWriter::startObject() {
+    open('{', true);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    close('}');
+    return *this;
+}
+
+JsonWriter& JsonWriter::startArray() {
+    open('[', false);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    close(']');
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    string(name);
+    buf_.push_back(':');
+    if (indent_ > 0) {
+        buf_.push_back(' ');
+    }
+    afterKey_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::string(std::string_view value) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    beforeValue();
+    buf_.push_back('"');
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        const auto c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        raw(value.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+        case '"': raw("\\\"", 2); break;
+        case '\\': raw("\\\\", 2); break;
+        case '\n': raw("\\n", 2); break;
+        case '\r': raw("\\r", 2); break;
+        case '\t': raw("\\t", 2); break;
+        default: {
+            const char esc[6] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+            raw(esc, sizeof(esc));
+        }
+        }
+    }
+    raw(value.data() + run, value.size() - run);
+    buf_.push_back('"');
+    maybeFlush();
+    return *this;
+}
+
+JsonWriter& JsonWriter::number(double value) {
+    if (!std::isfinite(value)) {
+        return null();
+    }
+    beforeValue();
+    char tmp[32];
+#if defined(__cpp_lib_to_chars)
+    const std::size_t n = static_cast<std::size_t>(
+        std::to_chars(tmp, tmp + sizeof(tmp), value).ptr - tmp);
+#else
+    // 17 digits always round-trip; 15 usually do too and keep values such
+    // as 0.1 readable, so they are tried first.
+    int len = std::snprintf(tmp, sizeof(tmp), "%.15g", value);
+    if (std::strtod(tmp, nullptr) != value) {
+        len = std::snprintf(tmp, sizeof(tmp), "%.17g", value);
+    }
+    const auto n = static_cast<std::size_t>(len);
+#endif
+    raw(tmp, n);
+    maybeFlush();
+    return *this;
+}
+
+JsonWriter& JsonWriter::integer(std::int64_t value) {
+    beforeValue();
+    char tmp[24];
+    const int n = std::snprintf(tmp, sizeof(tmp), "%lld", static_cast<long long>(value));
+    raw(tmp, static_cast<std::size_t>(n));
+    maybeFlush();
+    return *this;
+}
+
+JsonWriter& JsonWriter::boolean(bool value) {
+    beforeValue();
+    if (value) {
+        raw("true", 4);
+    } else {
+        raw("false", 5);
+    }
+    maybeFlush();
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    beforeValue();
+    raw("null", 4);
+    maybeFlush();
+    return *this;
+}
+
+} // namespace cineforge::io
@@ -0,0 +1,101 @@
+#include "cineforge/io/MappedFile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#define CINEFORGE_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cineforge::io {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        open_ = std::exchange(other.open_, false);
+        mapped_ = std::exchange(other.mapped_, false);
+        buffer_ = std::move(other.buffer_);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#if defined(CINEFORGE_HAVE_MMAP)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            size_ = 0;
+            return false;
+        }
+        data_ = static_cast<const std::uint8_t*>(p);
+        mapped_ = true;
+    }
+    // The mapping keeps the file referenced on its own.
+    ::close(fd);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return false;
+    }
+    const std::streamoff end = in.tellg();
+    if (end < 0) {
+        return false;
+    }
+    buffer_.resize(static_cast<std::size_t>(end));
+    in.seekg(0);
+    if (!buffer_.empty() &&
+        !in.read(reinterpret_cast<char*>(buffer_.data()),
+                 static_cast<std::streamsize>(buffer_.size()))) {
+        buffer_.clear();
+        return false;
+    }
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#endif
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+#if defined(CINEFORGE_HAVE_MMAP)
+    if (mapped_) {
+        ::munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+#endif
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    mapped_ = false;
+}
+
+} // namespace cineforge::io
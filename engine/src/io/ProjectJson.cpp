@@ -0,0 +1,459 @@
+#include "cineforge/io/ProjectJson.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+#include <system_error>
+#include <vector>
+
+namespace cineforge::io {
+
+namespace {
+
+using timeline::InterpolationType;
+
+constexpr std::string_view kInterpNames[] = {"hold",   "linear",  "bezier",
+                                             "easeIn", "easeOut", "easeInOut"};
+
+std::string_view interpName(InterpolationType interp) {
+    const auto i = static_cast<std::size_t>(interp);
+    return i < std::size(kInterpNames) ? kInterpNames[i] : kInterpNames[1];
+}
+
+bool interpFromName(std::string_view name, InterpolationType& out) {
+    for (std::size_t i = 0; i < std::size(kInterpNames); ++i) {
+        if (kInterpNames[i] == name) {
+            out = static_cast<InterpolationType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Builds a ProjectData from reader events. The position in the document is
+ * a stack of contexts; anything the schema does not know about is skipped
+ * by counting nesting depth, without building anything.
+ */
+class ProjectHandler final : public JsonHandler {
+public:
+    ProjectHandler(JsonReader& reader, ProjectData& out) : reader_(reader), out_(out) {}
+
+    bool startObject() override {
+        if (skipDepth_ > 0) {
+            ++skipDepth_;
+            return true;
+        }
+        Ctx next = Ctx::Skip;
+        switch (top()) {
+        case Ctx::Document: next = Ctx::Root; break;
+        case Ctx::Root:
+            if (key_ == "timeline") {
+                next = Ctx::Timeline;
+            }
+            break;
+        case Ctx::MediaList:
+            out_.media.emplace_back();
+            next = Ctx::Media;
+            break;
+        case Ctx::TrackList:
+            out_.tracks.emplace_back();
+            next = Ctx::Track;
+            break;
+        case Ctx::ClipList:
+            out_.tracks.back().clips.emplace_back();
+            next = Ctx::Clip;
+            break;
+        case Ctx::CurveList:
+            out_.curves.emplace_back();
+            next = Ctx::Curve;
+            break;
+        case Ctx::KeyList:
+            out_.curves.back().keys.emplace_back();
+            next = Ctx::Key;
+            break;
+        default: break;
+        }
+        return enter(next);
+    }
+
+    bool startArray() override {
+        if (skipDepth_ > 0) {
+            ++skipDepth_;
+            return true;
+        }
+        Ctx next = Ctx::Skip;
+        switch (top()) {
+        case Ctx::Document: return reject("project must be a JSON object");
+        case Ctx::Root:
+            if (key_ == "media") {
+                next = Ctx::MediaList;
+            } else if (key_ == "curves") {
+                next = Ctx::CurveList;
+            }
+            break;
+        case Ctx::Timeline:
+            if (key_ == "tracks") {
+                next = Ctx::TrackList;
+            }
+            break;
+        case Ctx::Track:
+            if (key_ == "clips") {
+                next = Ctx::ClipList;
+            }
+            break;
+        case Ctx::Curve:
+            if (key_ == "keys") {
+                next = Ctx::KeyList;
+            }
+            break;
+        case Ctx::Key:
+            if (key_ == "bezier") {
+                out_.curves.back().keys.back().bezier.emplace();
+                handle_ = 0;
+                next = Ctx::Bezier;
+            }
+            break;
+        default: break;
+        }
+        return enter(next);
+    }
+
+    bool endObject() override { return leave(); }
+    bool endArray() override { return leave(); }
+
+    bool key(std::string_view name) override {
+        if (skipDepth_ == 0) {
+            key_.assign(name.data(), name.size());
+        }
+        return true;
+    }
+
+    bool string(std::string_view value) override {
+        if (skipDepth_ > 0) {
+            return true;
+        }
+        switch (top()) {
+        case Ctx::Document: return reject("project must be a JSON object");
+        case Ctx::Media: {
+            auto& m = out_.media.back();
+            if (key_ == "id") {
+                m.id = intern(value);
+            } else if (key_ == "path") {
+                m.path.assign(value.data(), value.size());
+            } else if (key_ == "proxyPath") {
+                m.proxyPath.assign(value.data(), value.size());
+            } else if (key_ == "type") {
+                m.mediaType.assign(value.data(), value.size());
+            }
+            break;
+        }
+        case Ctx::Track:
+            if (key_ == "id") {
+                out_.tracks.back().id = intern(value);
+            }
+            break;
+        case Ctx::Clip: {
+            auto& c = out_.tracks.back().clips.back();
+            if (key_ == "id") {
+                c.id = intern(value);
+            } else if (key_ == "source") {
+                c.sourceId = intern(value);
+            }
+            break;
+        }
+        case Ctx::Curve: {
+            auto& c = out_.curves.back();
+            if (key_ == "id") {
+                c.id = intern(value);
+            } else if (key_ == "target") {
+                c.target = intern(value);
+            }
+            break;
+        }
+        case Ctx::Key:
+            if (key_ == "interp" && !interpFromName(value, out_.curves.back().keys.back().interp)) {
+                return reject("unknown interpolation type");
+            }
+            break;
+        default: break;
+        }
+        return true;
+    }
+
+    bool number(double value) override {
+        if (skipDepth_ > 0) {
+            return true;
+        }
+        switch (top()) {
+        case Ctx::Document: return reject("project must be a JSON object");
+        case Ctx::Root:
+            if (key_ == "version" && value > kJsonProjectVersion) {
+                return reject("project was written by a newer version");
+            }
+            if (key_ == "previewTime") {
+                out_.previewTime = value;
+            }
+            break;
+        case Ctx::Media:
+            if (key_ == "duration") {
+                out_.media.back().duration = value;
+            }
+            break;
+        case Ctx::Track:
+            if (key_ == "type") {
+                const auto unknown = static_cast<double>(timeline::TrackType::Unknown);
+                out_.tracks.back().type = value >= 0 && value <= unknown
+                                              ? static_cast<timeline::TrackType>(static_cast<int>(value))
+                                              : timeline::TrackType::Unknown;
+            }
+            break;
+        case Ctx::Clip: {
+            auto& c = out_.tracks.back().clips.back();
+            if (key_ == "start") {
+                c.start = value;
+            } else if (key_ == "end") {
+                c.end = value;
+            } else if (key_ == "in") {
+                c.inPoint = value;
+            } else if (key_ == "out") {
+                c.outPoint = value;
+            }
+            break;
+        }
+        case Ctx::Key: {
+            auto& k = out_.curves.back().keys.back();
+            if (key_ == "time") {
+                k.time = value;
+            } else if (key_ == "value") {
+                k.value = value;
+            } else if (key_ == "interp") {
+                const auto last = static_cast<double>(InterpolationType::EaseInOut);
+                if (!(value >= 0 && value <= last)) {
+                    return reject("unknown interpolation type");
+                }
+                k.interp = static_cast<InterpolationType>(static_cast<int>(value));
+            }
+            break;
+        }
+        case Ctx::Bezier: {
+            auto& h = *out_.curves.back().keys.back().bezier;
+            float* fields[] = {&h.inX, &h.inY, &h.outX, &h.outY};
+            if (handle_ < std::size(fields)) {
+                *fields[handle_] = static_cast<float>(value);
+            }
+            ++handle_;
+            break;
+        }
+        default: break;
+        }
+        return true;
+    }
+
+    bool boolean(bool) override { return scalar(); }
+    bool null() override { return scalar(); }
+
+private:
+    enum class Ctx {
+        Document,
+        Root,
+        Skip,
+        MediaList,
+        Media,
+        Timeline,
+        TrackList,
+        Track,
+        ClipList,
+        Clip,
+        CurveList,
+        Curve,
+        KeyList,
+        Key,
+        Bezier,
+    };
+
+    JsonReader& reader_;
+    ProjectData& out_;
+    std::vector<Ctx> stack_{Ctx::Document};
+    std::string key_;
+    int skipDepth_ = 0;
+    std::size_t handle_ = 0;
+
+    Ctx top() const { return stack_.back(); }
+
+    bool enter(Ctx next) {
+        if (next == Ctx::Skip) {
+            skipDepth_ = 1;
+        } else {
+            stack_.push_back(next);
+        }
+        return true;
+    }
+
+    bool leave() {
+        if (skipDepth_ > 0) {
+            --skipDepth_;
+        } else {
+            stack_.pop_back();
+        }
+        return true;
+    }
+
+    bool scalar() {
+        return skipDepth_ > 0 || top() != Ctx::Document || reject("project must be a JSON object");
+    }
+
+    bool reject(const char* message) {
+        reader_.fail(message);
+        return false;
+    }
+};
+
+template <typename Parse>
+bool parseProject(JsonReader& reader, ProjectData& out, std::string* error, Parse&& parse) {
+    out = ProjectData{};
+    ProjectHandler handler(reader, out);
+    if (parse(handler)) {
+        return true;
+    }
+    if (error) {
+        *error = "offset " + std::to_string(reader.errorOffset()) + ": " + reader.error();
+    }
+    return false;
+}
+
+} // namespace
+
+void writeProjectJson(const ProjectData& project, JsonWriter& w) {
+    w.startObject();
+    w.key("version").integer(kJsonProjectVersion);
+    w.key("previewTime").number(project.previewTime);
+
+    w.key("media").startArray();
+    for (const auto& m : project.media) {
+        w.startObject();
+        w.key("id").string(nameOf(m.id));
+        w.key("path").string(m.path);
+        if (!m.proxyPath.empty()) {
+            w.key("proxyPath").string(m.proxyPath);
+        }
+        w.key("type").string(m.mediaType);
+        w.key("duration").number(m.duration);
+        w.endObject();
+    }
+    w.endArray();
+
+    w.key("timeline").startObject();
+    w.key("tracks").startArray();
+    for (const auto& t : project.tracks) {
+        w.startObject();
+        w.key("id").string(nameOf(t.id));
+        w.key("type").integer(static_cast<int>(t.type));
+        w.key("clips").startArray();
+        for (const auto& c : t.clips) {
+            w.startObject();
+            w.key("id").string(nameOf(c.id));
+            w.key("source").string(nameOf(c.sourceId));
+            w.key("start").number(c.start);
+            w.key("end").number(c.end);
+            w.key("in").number(c.inPoint);
+            w.key("out").number(c.outPoint);
+            w.endObject();
+        }
+        w.endArray();
+        w.endObject();
+    }
+    w.endArray();
+    w.endObject();
+
+    w.key("curves").startArray();
+    for (const auto& c : project.curves) {
+        w.startObject();
+        w.key("id").string(nameOf(c.id));
+        w.key("target").string(nameOf(c.target));
+        w.key("keys").startArray();
+        for (const auto& k : c.keys) {
+            w.startObject();
+            w.key("time").number(k.time);
+            w.key("value").number(k.value);
+            w.key("interp").string(interpName(k.interp));
+            if (k.bezier) {
+                w.key("bezier").startArray();
+                w.number(k.bezier->inX).number(k.bezier->inY);
+                w.number(k.bezier->outX).number(k.bezier->outY);
+                w.endArray();
+            }
+            w.endObject();
+        }
+        w.endArray();
+        w.endObject();
+    }
+    w.endArray();
+    w.endObject();
+}
+
+std::string projectToJson(const ProjectData& project) {
+    std::string out;
+    {
+        JsonWriter writer(out);
+        writeProjectJson(project, writer);
+    }
+    return out;
+}
+
+bool readProjectJson(const JsonReader::RefillFn& refill, ProjectData& out, std::string* error) {
+    JsonReader reader;
+    return parseProject(reader, out, error,
+                        [&](JsonHandler& handler) { return reader.parse(refill, handler); });
+}
+
+bool projectFromJson(std::string_view json, ProjectData& out, std::string* error) {
+    JsonReader reader;
+    return parseProject(reader, out, error,
+                        [&](JsonHandler& handler) { return reader.parse(json, handler); });
+}
+
+bool saveProjectJson(const std::string& path, const ProjectData& project) {
+    const std::string tmp = path + ".tmp";
+    std::FILE* file = std::fopen(tmp.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok;
+    {
+        JsonWriter writer([file](const char* data, std::size_t size) {
+            return std::fwrite(data, 1, size, file) == size;
+        });
+        writeProjectJson(project, writer);
+        ok = writer.finish();
+    }
+    ok = std::fclose(file) == 0 && ok;
+    std::error_code ec;
+    if (ok) {
+        std::filesystem::rename(tmp, path, ec);
+    }
+    if (!ok || ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool loadProjectJson(const std::string& path, ProjectData& out, std::string* error) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        if (error) {
+            *error = "cannot open " + path;
+        }
+        return false;
+    }
+    const bool ok = readProjectJson(
+        [file](char* buffer, std::size_t capacity) {
+            return std::fread(buffer, 1, capacity, file);
+        },
+        out, error);
+    std::fclose(file);
+    return ok;
+}
+
+} // namespace cineforge::io
@@ -0,0 +1,36 @@
+#include "cineforge/media/DecodeScheduler.h"
+
+namespace cineforge::media {
+
+DecodeScheduler::DecodeScheduler(std::int64_t windowUs) : windowUs_(windowUs) {}
+
+bool DecodeScheduler::advance(Decoder& decoder, std::int64_t targetUs, std::int64_t timeoutUs) {
+    // Where the decoder stands: its current frame, or the target of a
+    // seek still producing its first one.
+    const std::int64_t pts = decoder.framePtsUs();
+    const std::int64_t from = pts >= 0 ? pts : (seekPending_ ? lastTargetUs_ : -1);
+    const bool sequential = from >= 0 && lastTargetUs_ >= 0 && targetUs >= lastTargetUs_ &&
+                            from <= targetUs && targetUs - from <= windowUs_;
+
+    bool ready;
+    if (sequential) {
+        ++stats_.sequential;
+        ready = decoder.decodeForwardUs(targetUs, timeoutUs);
+    } else {
+        ++stats_.discontinuities;
+        ready = decoder.seekExactUs(targetUs, timeoutUs);
+        seekPending_ = true;
+    }
+    if (decoder.framePtsUs() >= 0 || decoder.endOfStream()) {
+        seekPending_ = false;
+    }
+    lastTargetUs_ = targetUs;
+    return ready;
+}
+
+void DecodeScheduler::reset() {
+    lastTargetUs_ = -1;
+    seekPending_ = false;
+}
+
+} // namespace cineforge::media
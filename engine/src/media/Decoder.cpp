@@ -0,0 +1,58 @@
+#include "cineforge/media/Decoder.h"
+
+#include <chrono>
+
+namespace cineforge::media {
+
+namespace {
+
+// A seek saves decoding the frames up to the sync sample but flushes the
+// backend's pipeline, so it is only worth it when it skips more than this.
+constexpr std::int64_t kSeekSavesFrames = 4;
+
+} // namespace
+
+bool Decoder::showsFrameAt(std::int64_t targetUs) const {
+    const std::int64_t pts = framePtsUs();
+    const std::int64_t frameUs = frameDurationUs();
+    return pts >= 0 && (frameUs > 0 ? pts + frameUs > targetUs : pts >= targetUs);
+}
+
+bool Decoder::seekExactUs(std::int64_t targetUs, std::int64_t timeoutUs) {
+    const std::int64_t current = framePtsUs();
+    if (current < 0 || current > targetUs) {
+        if (!seekToUs(targetUs)) {
+            return false;
+        }
+    } else if (!showsFrameAt(targetUs) && !endOfStream()) {
+        // Where a seek would resume; without that, assume the target.
+        const std::int64_t sync = syncSampleUs(targetUs);
+        const std::int64_t resume = sync >= 0 ? sync : targetUs;
+        if (resume - current > kSeekSavesFrames * frameDurationUs() && !seekToUs(targetUs)) {
+            return false;
+        }
+    }
+    return decodeForwardUs(targetUs, timeoutUs);
+}
+
+bool Decoder::decodeForwardUs(std::int64_t targetUs, std::int64_t timeoutUs) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point deadline = Clock::now() + std::chrono::microseconds(timeoutUs);
+    for (;;) {
+        if (showsFrameAt(targetUs)) {
+            return true;
+        }
+        if (endOfStream()) {
+            return framePtsUs() >= 0; // the last frame holds to the end
+        }
+        // The timeout bounds waiting for the backend, not decoding work.
+        const auto left = std::chrono::duration_cast<std::chrono::microseconds>(
+                              deadline - Clock::now())
+                              .count();
+        if (!decodeNext(left > 0 ? left : 0) && !endOfStream() && Clock::now() >= deadline) {
+            return false;
+        }
+    }
+}
+
+} // namespace cineforge::media
@@ -0,0 +1,152 @@
+#include "cineforge/media/FramePrefetcher.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace cineforge::media {
+
+namespace {
+
+// Slack for a consumer slightly behind its nearest frame when the decoder
+// does not know its frame rate yet.
+constexpr std::int64_t kUnknownFrameUs = 50000;
+
+} // namespace
+
+FramePrefetcher::FramePrefetcher(std::unique_ptr<Decoder> decoder, std::size_t capacity)
+    : decoder_(std::move(decoder)), slots_(std::max<std::size_t>(capacity, 2)) {}
+
+const DecodedFrame* FramePrefetcher::frameAt(std::int64_t timeUs) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    retarget(timeUs);
+    if (count_ == 0) {
+        held_ = -1;
+        return nullptr;
+    }
+    // Queued frames ascend in PTS, so the distance falls until the
+    // nearest one and rises after it.
+    std::size_t best = 0;
+    std::int64_t bestDistance = -1;
+    for (std::size_t i = 0; i < count_; ++i) {
+        const std::int64_t pts = slots_[(head_ + i) % slots_.size()].ptsUs;
+        const std::int64_t distance = pts > timeUs ? pts - timeUs : timeUs - pts;
+        if (bestDistance >= 0 && distance >= bestDistance) {
+            break;
+        }
+        best = i;
+        bestDistance = distance;
+    }
+    head_ = (head_ + best) % slots_.size();
+    count_ -= best;
+    held_ = static_cast<std::ptrdiff_t>(head_);
+    return &slots_[head_];
+}
+
+void FramePrefetcher::prime(std::int64_t timeUs) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    retarget(timeUs);
+}
+
+void FramePrefetcher::trim() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    dropQueued();
+    wantUs_ = -1;
+    held_ = -1;
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        if (static_cast<std::ptrdiff_t>(i) != filling_) {
+            std::vector<std::uint8_t>().swap(slots_[i].rgba);
+        }
+    }
+}
+
+void FramePrefetcher::retarget(std::int64_t timeUs) {
+    if (count_ > 0) {
+        // Behind the consumer's frame, or further ahead of the last queued
+        // one than decoding on would sensibly reach. Past the end of the
+        // stream there is nothing further to reach.
+        const std::int64_t front = slots_[head_].ptsUs;
+        const std::int64_t back = slots_[(head_ + count_ - 1) % slots_.size()].ptsUs;
+        const std::int64_t slack = frameUs_ > 0 ? frameUs_ : kUnknownFrameUs;
+        if (timeUs < front - slack ||
+            (!ended_ && timeUs > back + DecodeScheduler::kDefaultWindowUs)) {
+            dropQueued();
+        }
+    } else if (ended_ && timeUs < wantUs_) {
+        ended_ = false; // the stream ran out after this point
+    }
+    wantUs_ = timeUs;
+}
+
+void FramePrefetcher::dropQueued() {
+    head_ = (head_ + count_) % slots_.size();
+    if (static_cast<std::ptrdiff_t>(head_) == held_) {
+        // A full ring wraps onto the frame still on screen; refill after it.
+        head_ = (head_ + 1) % slots_.size();
+    }
+    count_ = 0;
+    ++generation_;
+    ended_ = false;
+}
+
+bool FramePrefetcher::wantsDecode() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return wantUs_ >= 0 && count_ < slots_.size() && !ended_;
+}
+
+std::size_t FramePrefetcher::queued() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return count_;
+}
+
+bool FramePrefetcher::decodeStep(std::int64_t timeoutUs) {
+    std::int64_t want = 0;
+    bool continuing = false;
+    std::uint64_t generation = 0;
+    std::size_t slot = 0;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (wantUs_ < 0) {
+            return false;
+        }
+        want = wantUs_;
+        if (ended_ || count_ == slots_.size()) {
+            return false;
+        }
+        continuing = count_ > 0;
+        generation = generation_;
+        slot = (head_ + count_) % slots_.size();
+        if (static_cast<std::ptrdiff_t>(slot) == held_) {
+            return false; // dropped, but still on screen until the next frameAt()
+        }
+        filling_ = static_cast<std::ptrdiff_t>(slot);
+    }
+
+    bool ready = continuing ? decoder_->decodeNext(timeoutUs)
+                            : scheduler_.advance(*decoder_, want, timeoutUs);
+
+    DecodedFrame& frame = slots_[slot];
+    if (ready) {
+        frame.ptsUs = decoder_->framePtsUs();
+        frame.width = decoder_->width();
+        frame.height = decoder_->height();
+        frame.rgba.resize(static_cast<std::size_t>(frame.width) * frame.height * 4);
+        ready = decoder_->readRgba(frame.rgba.data(), frame.width * 4);
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    filling_ = -1;
+    frameUs_ = decoder_->frameDurationUs();
+    if (!ready) {
+        if (decoder_->endOfStream() && generation == generation_) {
+            ended_ = true;
+        }
+        return false;
+    }
+    if (generation != generation_) {
+        return false; // dropped while decoding
+    }
+    ++count_;
+    return true;
+}
+
+} // namespace cineforge::media
@@ -0,0 +1,38 @@
+#include "cineforge/media/MediaLibrary.h"
+
+namespace cineforge::media {
+
+void MediaLibrary::add(const MediaSource& source) {
+    auto [it, inserted] = byId_.emplace(source.id, sources_.size());
+    if (inserted) {
+        sources_.push_back(source);
+    } else {
+        sources_[it->second] = source;
+    }
+}
+
+bool MediaLibrary::remove(Symbol id) {
+    auto it = byId_.find(id);
+    if (it == byId_.end()) {
+        return false;
+    }
+    const std::size_t index = it->second;
+    byId_.erase(it);
+    sources_.erase(sources_.begin() + static_cast<std::ptrdiff_t>(index));
+    for (std::size_t i = index; i < sources_.size(); ++i) {
+        byId_[sources_[i].id] = i;
+    }
+    return true;
+}
+
+void MediaLibrary::clear() {
+    sources_.clear();
+    byId_.clear();
+}
+
+const MediaSource* MediaLibrary::find(Symbol id) const {
+    auto it = byId_.find(id);
+    return it == byId_.end() ? nullptr : &sources_[it->second];
+}
+
+} // namespace cineforge::media
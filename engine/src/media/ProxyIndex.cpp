@@ -0,0 +1,170 @@
+#include "cineforge/media/ProxyIndex.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace cineforge::media {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr const char* kMagic = "cineforge-proxy-index";
+
+// Fields are tab separated with the path last, so only the short fields
+// need to be kept free of tabs and newlines.
+std::string sanitize(std::string s) {
+    std::replace_if(s.begin(), s.end(),
+                    [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+    return s;
+}
+
+} // namespace
+
+bool ProxyIndex::load(const std::string& file) {
+    entries_.clear();
+    totalBytes_ = 0;
+
+    std::ifstream in(file);
+    std::string line;
+    if (!in || !std::getline(in, line)) {
+        return false;
+    }
+    std::istringstream header(line);
+    std::string magic;
+    int version = 0;
+    if (!(header >> magic >> version) || magic != kMagic || version != kVersion) {
+        return false;
+    }
+
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        ProxyIndexEntry e;
+        std::string width, height, bytes, lastUsed;
+        if (!std::getline(fields, e.key, '\t') || !std::getline(fields, width, '\t') ||
+            !std::getline(fields, height, '\t') || !std::getline(fields, e.codec, '\t') ||
+            !std::getline(fields, e.profile, '\t') || !std::getline(fields, bytes, '\t') ||
+            !std::getline(fields, lastUsed, '\t') || !std::getline(fields, e.sourcePath)) {
+            continue;
+        }
+        try {
+            e.width = std::stoi(width);
+            e.height = std::stoi(height);
+            e.bytes = std::stoull(bytes);
+            e.lastUsed = std::stoll(lastUsed);
+        } catch (const std::exception&) {
+            continue;
+        }
+        if (!e.key.empty()) {
+            put(std::move(e));
+        }
+    }
+    return true;
+}
+
+std::string ProxyIndex::serialize() const {
+    std::ostringstream out;
+    out << kMagic << ' ' << kVersion << '\n';
+    for (const auto& [key, e] : entries_) {
+        out << e.key << '\t' << e.width << '\t' << e.height << '\t' << e.codec << '\t'
+            << e.profile << '\t' << e.bytes << '\t' << e.lastUsed << '\t' << e.sourcePath
+            << '\n';
+    }
+    return out.str();
+}
+
+bool ProxyIndex::writeFile(const std::string& file, const std::string& data) {
+    const std::string tmp = file + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.write(data.data(), static_cast<std::streamsize>(data.size())) ||
+            !out.flush()) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmp, file, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+const ProxyIndexEntry* ProxyIndex::find(const std::string& key) const {
+    auto it = entries_.find(key);
+    return it == entries_.end() ? nullptr : &it->second;
+}
+
+const ProxyIndexEntry* ProxyIndex::findBySource(const std::string& sourcePath, int width,
+                                                const std::string& profile) const {
+    const ProxyIndexEntry* best = nullptr;
+    for (const auto& [key, e] : entries_) {
+        if (e.sourcePath == sourcePath && e.width == width && e.profile == profile &&
+            (!best || e.lastUsed > best->lastUsed)) {
+            best = &e;
+        }
+    }
+    return best;
+}
+
+void ProxyIndex::put(ProxyIndexEntry entry) {
+    entry.codec = sanitize(std::move(entry.codec));
+    entry.profile = sanitize(std::move(entry.profile));
+    entry.sourcePath = sanitize(std::move(entry.sourcePath));
+    erase(entry.key);
+    totalBytes_ += entry.bytes;
+    const std::string key = entry.key;
+    entries_.emplace(key, std::move(entry));
+}
+
+bool ProxyIndex::erase(const std::string& key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return false;
+    }
+    totalBytes_ -= it->second.bytes;
+    entries_.erase(it);
+    return true;
+}
+
+std::vector<ProxyIndexEntry> ProxyIndex::evict(std::uint64_t quota,
+                                               const std::string& keep) {
+    std::vector<ProxyIndexEntry> evicted;
+    if (totalBytes_ <= quota) {
+        return evicted;
+    }
+    std::vector<const ProxyIndexEntry*> byAge;
+    byAge.reserve(entries_.size());
+    for (const auto& [key, e] : entries_) {
+        if (key != keep) {
+            byAge.push_back(&e);
+        }
+    }
+    std::sort(byAge.begin(), byAge.end(),
+              [](const ProxyIndexEntry* a, const ProxyIndexEntry* b) {
+                  return a->lastUsed < b->lastUsed;
+              });
+    std::vector<std::string> victims;
+    std::uint64_t total = totalBytes_;
+    for (const ProxyIndexEntry* e : byAge) {
+        if (total <= quota) {
+            break;
+        }
+        total -= e->bytes;
+        victims.push_back(e->key);
+    }
+    for (const auto& key : victims) {
+        auto it = entries_.find(key);
+        evicted.push_back(std::move(it->second));
+        totalBytes_ -= evicted.back().bytes;
+        entries_.erase(it);
+    }
+    return evicted;
+}
+
+} // namespace cineforge::media
@@ -1,64 +1,671 @@
 #include "cineforge/media/ProxyManager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <filesystem>
+#include <system_error>
 
 namespace cineforge::media {
 
 namespace {
 namespace fs = std::filesystem;
+
+constexpr const char* kCodec = "h264";
+constexpr const char* kFfmpegProfile = "x264-veryfast-crf28-aac96k";
+
+std::int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+// Content address of a proxy: the source fingerprint plus everything that
+// changes the output.
+std::string proxyKey(const SourceFingerprint& fp, int targetWidth,
+                     const std::string& profile) {
+    std::uint64_t h = fnv1a64(&fp.size, sizeof(fp.size));
+    h = fnv1a64(&fp.mtime, sizeof(fp.mtime), h);
+    h = fnv1a64(&fp.sampleHash, sizeof(fp.sampleHash), h);
+    h = fnv1a64(&targetWidth, sizeof(targetWidth), h);
+    h = fnv1a64(kCodec, std::char_traits<char>::length(kCodec), h);
+    h = fnv1a64(profile.data(), profile.size(), h);
+    return toHex64(h);
+}
+
+// Size and modification time as fingerprintFile() records them.
+bool statFile(const std::string& path, std::uint64_t& size, std::int64_t& mtime) {
+    std::error_code ec;
+    size = fs::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    const auto time = fs::last_write_time(path, ec);
+    mtime = static_cast<std::int64_t>(time.time_since_epoch().count());
+    return !ec;
+}
+
+// The index can outlive its files (deleted by hand, disk cleaners, a
+// copied project folder), so hits are checked before they are trusted.
+bool proxyFileIntact(const std::string& path, std::uint64_t bytes) {
+    std::error_code ec;
+    const auto size = fs::file_size(path, ec);
+    return !ec && size == bytes;
+}
 }
 
 ProxyManager::ProxyManager(const std::string& ffmpegBinDir,
-                           const std::string& proxyRoot)
-    : ffmpegBinDir_(ffmpegBinDir), proxyRoot_(proxyRoot) {}
+                           const std::string& proxyRoot,
+                           std::size_t workers)
+    : ffmpegBinDir_(ffmpegBinDir), proxyRoot_(proxyRoot), profile_(kFfmpegProfile),
+      workerCount_(std::max<std::size_t>(workers, 1)) {
+    transcode_ = [this](const MediaSource& src, int targetWidth,
+                        const std::string& outputPath, const std::atomic<bool>&,
+                        int& height) {
+        return transcodeWithFfmpeg(src, targetWidth, outputPath, height);
+    };
+}
 
-ProxyInfo ProxyManager::ensureProxy(const MediaSource& src, int targetWidth) {
-    std::lock_guard<std::mutex> lock(mtx_);
+ProxyManager::~ProxyManager() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_ = true;
+    }
+    cancelAll();
+    workAvailable_.notify_all();
+    for (auto& t : workers_) {
+        t.join();
+    }
+    saveIndex();
+}
 
-    auto it = map_.find(src.id);
-    if (it != map_.end() && it->second.valid &&
-        it->second.width == targetWidth) {
-        return it->second;
+std::string ProxyManager::indexPath() const {
+    return (fs::path(proxyRoot_) / ProxyIndex::kFileName).string();
+}
+
+std::string ProxyManager::proxyPathFor(const std::string& indexKey) const {
+    return (fs::path(proxyRoot_) / (indexKey + ".mp4")).string();
+}
+
+ProxyInfo ProxyManager::infoFor(const ProxyIndexEntry& entry) const {
+    ProxyInfo info;
+    info.proxyPath = proxyPathFor(entry.key);
+    info.width = entry.width;
+    info.height = entry.height;
+    info.codec = entry.codec;
+    info.valid = true;
+    return info;
+}
+
+// Read once, on first use, so that constructing the engine does no I/O.
+void ProxyManager::loadIndex() const {
+    std::call_once(indexLoaded_, [this] {
+        ProxyIndex loaded;
+        loaded.load(indexPath());
+
+        // Partial outputs of a session that did not shut down cleanly.
+        std::error_code ec;
+        for (fs::directory_iterator it(proxyRoot_, ec), end; !ec && it != end;
+             it.increment(ec)) {
+            if (it->path().filename().string().find(".part") != std::string::npos) {
+                std::error_code rmEc;
+                fs::remove(it->path(), rmEc);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        index_ = std::move(loaded);
+    });
+}
+
+// Snapshots under the lock and writes outside it; the generation check
+// keeps a slow writer from replacing a newer snapshot with an older one.
+void ProxyManager::saveIndex() {
+    std::string data;
+    std::uint64_t gen;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!indexDirty_) {
+            return;
+        }
+        data = index_.serialize();
+        gen = ++indexGen_;
+        indexDirty_ = false;
+    }
+    std::lock_guard<std::mutex> fileLock(fileMtx_);
+    if (gen <= savedGen_) {
+        return;
+    }
+    std::error_code ec;
+    fs::create_directories(proxyRoot_, ec);
+    if (ProxyIndex::writeFile(indexPath(), data)) {
+        savedGen_ = gen;
+    } else {
+        std::lock_guard<std::mutex> lock(mtx_);
+        indexDirty_ = true;
+    }
+}
+
+void ProxyManager::forgetProxiesLocked(const std::vector<ProxyIndexEntry>& evicted) {
+    for (const auto& e : evicted) {
+        const std::string path = proxyPathFor(e.key);
+        for (auto src = map_.begin(); src != map_.end();) {
+            auto& tiers = src->second;
+            for (auto it = tiers.begin(); it != tiers.end();) {
+                it = it->second.proxyPath == path ? tiers.erase(it) : std::next(it);
+            }
+            src = tiers.empty() ? map_.erase(src) : std::next(src);
+        }
     }
+}
 
-    fs::create_directories(proxyRoot_);
+void ProxyManager::removeProxyFiles(const std::vector<ProxyIndexEntry>& evicted) const {
+    for (const auto& e : evicted) {
+        std::error_code ec;
+        fs::remove(proxyPathFor(e.key), ec);
+    }
+}
 
-    const auto original = fs::path(src.path).filename().string();
-    const std::string codec = "h264";
-    const std::string proxyName =
-        original + "__proxy_" + std::to_string(targetWidth) + "x" + codec + ".mp4";
-    const fs::path proxyPath = fs::path(proxyRoot_) / proxyName;
+// Fingerprinting reads three blocks of the file; a stat is enough to
+// tell whether the last fingerprint still holds.
+SourceFingerprint ProxyManager::fingerprintSource(const MediaSource& src) {
+    std::uint64_t size = 0;
+    std::int64_t mtime = 0;
+    if (!statFile(src.path, size, mtime)) {
+        return SourceFingerprint{};
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = sources_.find(src.id);
+        if (it != sources_.end() && it->second.path == src.path &&
+            it->second.fingerprint.size == size && it->second.fingerprint.mtime == mtime) {
+            return it->second.fingerprint;
+        }
+    }
+    const SourceFingerprint fp = fingerprintFile(src.path);
+    if (fp.valid) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        SourceState& state = sources_[src.id];
+        if (state.fingerprint != fp) {
+            state.failedWidths.clear(); // a new version deserves a new try
+        }
+        state.path = src.path;
+        state.fingerprint = fp;
+    }
+    return fp;
+}
 
+bool ProxyManager::transcodeFailed(const MediaSource& src, int width) {
+    auto failed = [&] {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = sources_.find(src.id);
+        return it != sources_.end() &&
+               std::find(it->second.failedWidths.begin(), it->second.failedWidths.end(),
+                         width) != it->second.failedWidths.end();
+    };
+    if (!failed()) {
+        return false;
+    }
+    // Only a recorded failure costs a stat; a changed file clears it.
+    fingerprintSource(src);
+    return failed();
+}
+
+bool ProxyManager::transcodeWithFfmpeg(const MediaSource& src, int targetWidth,
+                                       const std::string& outputPath, int& height) const {
     const fs::path ffmpegExe = fs::path(ffmpegBinDir_) / "ffmpeg";
+    const fs::path ffprobeExe = fs::path(ffmpegBinDir_) / "ffprobe";
 
-    // NOTE: escaping / quoting for spaces is omitted here for brevity.
+    // NOTE: escaping of quotes inside paths is omitted here for brevity.
+    // The output goes to a temporary name, so the explicit format is needed.
     std::string cmd = "\"" + ffmpegExe.string() + "\" -y -i \"" + src.path + "\" "
         "-vf scale=" + std::to_string(targetWidth) + ":-2 "
         "-c:v libx264 -preset veryfast -crf 28 "
-        "-c:a aac -b:a 96k \"" + proxyPath.string() + "\"";
+        "-c:a aac -b:a 96k -f mp4 \"" + outputPath + "\"";
 
-    std::system(cmd.c_str());
+    if (std::system(cmd.c_str()) != 0) {
+        return false;
+    }
 
-    ProxyInfo info;
-    info.proxyPath = proxyPath.string();
-    info.width = targetWidth;
-    info.codec = codec;
-    info.valid = fs::exists(proxyPath);
-    map_[src.id] = info;
-    return info;
+    // The height follows the source's aspect ratio, so it is read back
+    // from the output.
+    const std::string probe = "\"" + ffprobeExe.string() + "\" -v error "
+        "-select_streams v:0 -show_entries stream=height -of csv=p=0 \"" +
+        outputPath + "\"";
+    if (FILE* pipe = popen(probe.c_str(), "r")) {
+        int probed = 0;
+        if (std::fscanf(pipe, "%d", &probed) == 1 && probed > 0) {
+            height = probed;
+        }
+        pclose(pipe);
+    }
+    return true;
+}
+
+std::shared_future<ProxyInfo> ProxyManager::requestProxy(const MediaSource& src,
+                                                         int targetWidth,
+                                                         int priority,
+                                                         Callback done) {
+    loadIndex();
+    const SourceFingerprint fp = fingerprintSource(src);
+
+    auto resolved = [&](const ProxyInfo& info) {
+        std::promise<ProxyInfo> ready;
+        if (done) {
+            done(info);
+        }
+        ready.set_value(info);
+        return ready.get_future().share();
+    };
+
+    // Look for an existing proxy. Offline sources cannot be fingerprinted
+    // and fall back to whatever was last made from the same path.
+    std::string indexKey;
+    TranscodeFn transcode;
+    std::string profile;
+    ProxyIndexEntry hit;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        transcode = transcode_;
+        profile = profile_;
+        const ProxyIndexEntry* e = nullptr;
+        if (fp.valid) {
+            indexKey = proxyKey(fp, targetWidth, profile);
+            e = index_.find(indexKey);
+        } else {
+            e = index_.findBySource(src.path, targetWidth, profile);
+        }
+        if (e) {
+            hit = *e;
+            found = true;
+        }
+    }
+    if (found) {
+        const bool intact = proxyFileIntact(proxyPathFor(hit.key), hit.bytes);
+        const ProxyInfo info = infoFor(hit);
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (intact) {
+                // Recency (and a moved source's new path) is only flushed
+                // later; a cold start hitting every clip should not
+                // rewrite the index each time.
+                if (index_.find(hit.key)) {
+                    hit.lastUsed = std::max(hit.lastUsed, nowMs());
+                    hit.sourcePath = src.path;
+                    index_.put(hit);
+                }
+                map_[src.id][info.width] = info;
+            } else {
+                index_.erase(hit.key);
+            }
+            indexDirty_ = true;
+        }
+        if (intact) {
+            return resolved(info);
+        }
+        saveIndex();
+    }
+    if (!fp.valid) {
+        return resolved(ProxyInfo{});
+    }
+
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    const JobKey key{src.id, targetWidth};
+    auto it = jobs_.find(key);
+    if (it != jobs_.end()) {
+        Job& job = *it->second;
+        job.priority = std::max(job.priority, priority);
+        if (done) {
+            job.callbacks.push_back(std::move(done));
+        }
+        return job.future;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->key = key;
+    job->indexKey = indexKey;
+    job->fingerprint = fp;
+    job->source = src;
+    job->transcode = std::move(transcode);
+    job->profile = std::move(profile);
+    job->priority = priority;
+    job->seq = nextSeq_++;
+    job->future = job->promise.get_future().share();
+    if (done) {
+        job->callbacks.push_back(std::move(done));
+    }
+    if (stop_) {
+        lock.unlock();
+        finish(job, ProxyInfo{});
+        return job->future;
+    }
+    jobs_.emplace(key, job);
+    queue_.push_back(job);
+    // Threads are started on first use so that projects without proxies
+    // cost nothing.
+    while (workers_.size() < workerCount_) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+    lock.unlock();
+    workAvailable_.notify_one();
+    return job->future;
+}
+
+ProxyInfo ProxyManager::ensureProxy(const MediaSource& src, int targetWidth) {
+    return requestProxy(src, targetWidth, kBlockingPriority).get();
 }
 
-ProxyInfo ProxyManager::getProxy(const std::string& sourceId) const {
+void ProxyManager::boost(Symbol sourceId, int priority) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto& job : queue_) {
+        if (job->key.source == sourceId) {
+            job->priority = std::max(job->priority, priority);
+        }
+    }
+}
+
+bool ProxyManager::cancel(Symbol sourceId, int targetWidth) {
+    std::shared_ptr<Job> job;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = jobs_.find(JobKey{sourceId, targetWidth});
+        if (it == jobs_.end()) {
+            return false;
+        }
+        job = it->second;
+        job->cancelled.store(true);
+        jobs_.erase(it);
+        if (job->running) {
+            // The worker resolves it once the transcoder returns; a new
+            // request meanwhile starts a fresh job.
+            return true;
+        }
+        queue_.erase(std::find(queue_.begin(), queue_.end(), job));
+    }
+    finish(job, ProxyInfo{});
+    return true;
+}
+
+void ProxyManager::cancelAll() {
+    std::vector<std::shared_ptr<Job>> queued;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (auto& [key, job] : jobs_) {
+            job->cancelled.store(true);
+        }
+        jobs_.clear();
+        queued.swap(queue_);
+    }
+    for (const auto& job : queued) {
+        finish(job, ProxyInfo{});
+    }
+}
+
+std::size_t ProxyManager::pendingJobs() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return jobs_.size();
+}
+
+ProxySelection ProxyManager::selectProxy(const MediaSource& src, int viewportWidth,
+                                        double zoom, int priority) {
+    ProxySelection sel;
+    const double needed = std::max(1.0, viewportWidth * std::max(zoom, 0.0));
+
+    bool ready = false;
+    bool pending = false;
+    bool smallestPending = false;
+    int smallest = 0;
+    bool haveSmaller = false;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (tiers_.empty()) {
+            return sel;
+        }
+        sel.wantedWidth = tiers_.back();
+        for (int t : tiers_) {
+            if (t >= needed) {
+                sel.wantedWidth = t;
+                break;
+            }
+        }
+        smallest = tiers_.front();
+        auto it = map_.find(src.id);
+        if (it != map_.end()) {
+            ready = it->second.count(sel.wantedWidth) != 0;
+            haveSmaller = !it->second.empty() &&
+                          it->second.begin()->first < sel.wantedWidth;
+        }
+        pending = jobs_.count(JobKey{src.id, sel.wantedWidth}) != 0;
+        smallestPending = jobs_.count(JobKey{src.id, smallest}) != 0;
+    }
+
+    // This runs every frame while a tier is missing, so tiers already
+    // queued or known to fail are skipped before requestProxy() does any
+    // I/O. Both calls return at once; an indexed proxy even lands in map_
+    // before they do. The quick tier goes first so that an idle worker
+    // does not pick up the slow one ahead of it.
+    if (!ready && !haveSmaller && smallest < sel.wantedWidth && !smallestPending &&
+        !transcodeFailed(src, smallest)) {
+        requestProxy(src, smallest, priority + 1);
+    }
+    if (!ready && !pending && !transcodeFailed(src, sel.wantedWidth)) {
+        requestProxy(src, sel.wantedWidth, priority);
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = map_.find(src.id);
+    if (it != map_.end() && !it->second.empty()) {
+        const auto& tiers = it->second;
+        auto above = tiers.lower_bound(sel.wantedWidth);
+        if (above != tiers.end() && above->first == sel.wantedWidth) {
+            sel.proxy = above->second;
+        } else if (above != tiers.begin()) {
+            sel.proxy = std::prev(above)->second;
+        } else {
+            sel.proxy = above->second;
+        }
+    }
+    sel.upgrading = sel.proxy.width != sel.wantedWidth &&
+                    jobs_.count(JobKey{src.id, sel.wantedWidth}) != 0;
+    return sel;
+}
+
+void ProxyManager::setTiers(std::vector<int> widths) {
+    widths.erase(std::remove_if(widths.begin(), widths.end(), [](int w) { return w <= 0; }),
+                 widths.end());
+    std::sort(widths.begin(), widths.end());
+    widths.erase(std::unique(widths.begin(), widths.end()), widths.end());
+    std::lock_guard<std::mutex> lock(mtx_);
+    tiers_ = std::move(widths);
+}
+
+std::vector<int> ProxyManager::tiers() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return tiers_;
+}
+
+ProxyInfo ProxyManager::getProxy(Symbol sourceId) const {
     std::lock_guard<std::mutex> lock(mtx_);
     auto it = map_.find(sourceId);
-    return it == map_.end() ? ProxyInfo{} : it->second;
+    return it == map_.end() || it->second.empty() ? ProxyInfo{}
+                                                  : it->second.rbegin()->second;
 }
 
-void ProxyManager::setProxy(const std::string& sourceId, const ProxyInfo& info) {
+ProxyInfo ProxyManager::getProxy(Symbol sourceId, int width) const {
     std::lock_guard<std::mutex> lock(mtx_);
-    map_[sourceId] = info;
+    auto it = map_.find(sourceId);
+    if (it == map_.end()) {
+        return {};
+    }
+    auto tier = it->second.find(width);
+    return tier == it->second.end() ? ProxyInfo{} : tier->second;
 }
 
-} // namespace cineforge::media
+std::vector<ProxyInfo> ProxyManager::readyProxies(Symbol sourceId) const {
+    std::vector<ProxyInfo> out;
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = map_.find(sourceId);
+    if (it != map_.end()) {
+        for (const auto& [width, info] : it->second) {
+            out.push_back(info);
+        }
+    }
+    return out;
+}
+
+void ProxyManager::setProxy(Symbol sourceId, const ProxyInfo& info) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (info.valid) {
+        map_[sourceId][info.width] = info;
+    } else {
+        auto it = map_.find(sourceId);
+        if (it != map_.end()) {
+            it->second.erase(info.width);
+        }
+    }
+}
+
+void ProxyManager::setTranscoder(TranscodeFn fn, std::string profile) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    transcode_ = std::move(fn);
+    profile_ = std::move(profile);
+    // Another transcoder may well succeed where this one failed.
+    for (auto& [id, state] : sources_) {
+        state.failedWidths.clear();
+    }
+}
 
+void ProxyManager::setDiskQuota(std::uint64_t bytes) {
+    loadIndex();
+    std::vector<ProxyIndexEntry> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        diskQuota_ = bytes;
+        evicted = index_.evict(diskQuota_, {});
+        if (evicted.empty()) {
+            return;
+        }
+        forgetProxiesLocked(evicted);
+        indexDirty_ = true;
+    }
+    removeProxyFiles(evicted);
+    saveIndex();
+}
+
+std::uint64_t ProxyManager::diskQuota() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return diskQuota_;
+}
+
+std::uint64_t ProxyManager::diskUsage() const {
+    loadIndex();
+    std::lock_guard<std::mutex> lock(mtx_);
+    return index_.totalBytes();
+}
+
+void ProxyManager::flushIndex() {
+    saveIndex();
+}
+
+// Highest priority first, oldest first among equals. A linear scan keeps
+// boosts trivial and is cheap at the queue sizes imports produce.
+std::shared_ptr<ProxyManager::Job> ProxyManager::popJobLocked() {
+    auto best = std::max_element(queue_.begin(), queue_.end(),
+                                 [](const auto& a, const auto& b) {
+                                     if (a->priority != b->priority) {
+                                         return a->priority < b->priority;
+                                     }
+                                     return a->seq > b->seq;
+                                 });
+    auto job = *best;
+    queue_.erase(best);
+    job->running = true;
+    return job;
+}
+
+void ProxyManager::workerLoop() {
+    for (;;) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            workAvailable_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            job = popJobLocked();
+        }
+
+        const MediaSource& src = job->source;
+        const std::string proxyPath = proxyPathFor(job->indexKey);
+        const std::string partPath =
+            proxyPath + ".part" + std::to_string(job->seq);
+        std::error_code ec;
+        fs::create_directories(proxyRoot_, ec);
+
+        int height = 0;
+        bool ok = !job->cancelled.load() &&
+                  job->transcode(src, job->key.width, partPath, job->cancelled, height);
+        ok = ok && !job->cancelled.load();
+        if (ok) {
+            fs::rename(partPath, proxyPath, ec);
+            ok = !ec;
+        }
+        if (!ok) {
+            fs::remove(partPath, ec);
+        }
+
+        ProxyIndexEntry entry;
+        entry.key = job->indexKey;
+        entry.sourcePath = src.path;
+        entry.profile = job->profile;
+        entry.codec = kCodec;
+        entry.width = job->key.width;
+        entry.height = height;
+        entry.bytes = ok ? fs::file_size(proxyPath, ec) : 0;
+        entry.lastUsed = nowMs();
+        ProxyInfo info;
+        if (ok && !ec) {
+            info = infoFor(entry);
+        }
+
+        std::vector<ProxyIndexEntry> evicted;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            auto it = jobs_.find(job->key);
+            if (it != jobs_.end() && it->second == job) {
+                jobs_.erase(it);
+            }
+            if (info.valid) {
+                index_.put(entry);
+                evicted = index_.evict(diskQuota_, entry.key);
+                forgetProxiesLocked(evicted);
+                map_[src.id][info.width] = info;
+                indexDirty_ = true;
+            } else if (!job->cancelled.load()) {
+                auto state = sources_.find(src.id);
+                if (state != sources_.end() && state->second.fingerprint == job->fingerprint) {
+                    state->second.failedWidths.push_back(job->key.width);
+                }
+            }
+        }
+        if (info.valid) {
+            removeProxyFiles(evicted);
+            saveIndex();
+        }
+        finish(job, info);
+    }
+}
+
+// Resolves a job that is no longer reachable from jobs_, outside the lock.
+// Callbacks run first so that anyone woken by the future sees their effects.
+void ProxyManager::finish(const std::shared_ptr<Job>& job, const ProxyInfo& info) {
+    for (auto& cb : job->callbacks) {
+        cb(info);
+    }
+    job->promise.set_value(info);
+}
+
+} // namespace cineforge::media
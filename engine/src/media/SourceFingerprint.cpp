@@ -0,0 +1,73 @@
+#include "cineforge/media/SourceFingerprint.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace cineforge::media {
+
+namespace fs = std::filesystem;
+
+std::uint64_t fnv1a64(const void* data, std::size_t size, std::uint64_t seed) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    std::uint64_t h = seed;
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+std::string toHex64(std::uint64_t v) {
+    static constexpr char kDigits[] = "0123456789abcdef";
+    std::string s(16, '0');
+    for (int i = 15; i >= 0; --i, v >>= 4) {
+        s[static_cast<std::size_t>(i)] = kDigits[v & 0xF];
+    }
+    return s;
+}
+
+SourceFingerprint fingerprintFile(const std::string& path) {
+    SourceFingerprint fp;
+    std::error_code ec;
+    const auto size = fs::file_size(path, ec);
+    if (ec) {
+        return fp;
+    }
+    const auto mtime = fs::last_write_time(path, ec);
+    if (ec) {
+        return fp;
+    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return fp;
+    }
+
+    // Start, middle and end; small files are simply hashed whole.
+    const std::uint64_t block = kFingerprintBlockSize;
+    std::vector<std::uint64_t> offsets{0};
+    if (size > block) {
+        offsets.push_back(size / 2 - block / 2);
+        offsets.push_back(size - block);
+    }
+    std::vector<char> buf(static_cast<std::size_t>(std::min<std::uint64_t>(size, block)));
+    std::uint64_t h = fnv1a64(&size, sizeof(size));
+    for (std::uint64_t off : offsets) {
+        in.seekg(static_cast<std::streamoff>(off));
+        in.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+        if (in.gcount() != static_cast<std::streamsize>(buf.size())) {
+            return fp;
+        }
+        h = fnv1a64(buf.data(), buf.size(), h);
+    }
+
+    fp.size = size;
+    fp.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+    fp.sampleHash = h;
+    fp.valid = true;
+    return fp;
+}
+
+} // namespace cineforge::media
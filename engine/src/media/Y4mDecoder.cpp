@@ -0,0 +1,234 @@
+#include "cineforge/media/Y4mDecoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+namespace cineforge::media {
+
+namespace {
+
+constexpr std::string_view kMagic = "YUV4MPEG2";
+constexpr std::string_view kFrameTag = "FRAME";
+
+// Position just past the '\n' ending the line at `offset`, or npos.
+std::size_t lineEnd(const std::uint8_t* data, std::size_t size, std::size_t offset) {
+    const void* nl = std::memchr(data + offset, '\n', size - offset);
+    return nl ? static_cast<std::size_t>(static_cast<const std::uint8_t*>(nl) - data) + 1
+              : std::string_view::npos;
+}
+
+bool parseInt(std::string_view text, int& out) {
+    if (text.empty() || text.size() > 9) {
+        return false;
+    }
+    int value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    out = value;
+    return true;
+}
+
+} // namespace
+
+Y4mDecoder::Y4mDecoder(std::string path, int gopLength)
+    : path_(std::move(path)), gopLength_(std::max(gopLength, 1)) {}
+
+Y4mDecoder::~Y4mDecoder() {
+    close();
+}
+
+bool Y4mDecoder::open() {
+    close();
+    if (!file_.open(path_)) {
+        return false;
+    }
+    std::size_t offset = 0;
+    if (!parseHeader(offset)) {
+        close();
+        return false;
+    }
+
+    // Frame headers may carry parameters, so index the frames once rather
+    // than assume a fixed stride. A truncated last frame is dropped.
+    const auto w = static_cast<std::size_t>(width_);
+    const auto h = static_cast<std::size_t>(height_);
+    const std::size_t frameBytes = w * h + 2 * ((w + 1) / 2) * ((h + 1) / 2);
+    const std::uint8_t* data = file_.data();
+    const std::size_t size = file_.size();
+    while (offset + kFrameTag.size() <= size &&
+           std::memcmp(data + offset, kFrameTag.data(), kFrameTag.size()) == 0) {
+        const std::size_t planes = lineEnd(data, size, offset);
+        if (planes == std::string_view::npos || size - planes < frameBytes) {
+            break;
+        }
+        frames_.push_back(planes);
+        offset = planes + frameBytes;
+    }
+    return true;
+}
+
+void Y4mDecoder::close() {
+    file_.close();
+    frames_.clear();
+    width_ = height_ = 0;
+    fpsNum_ = 0;
+    fpsDen_ = 1;
+    range_ = render::YuvRange::Limited;
+    next_ = 0;
+    current_ = -1;
+    ended_ = false;
+}
+
+bool Y4mDecoder::parseHeader(std::size_t& offset) {
+    const std::uint8_t* data = file_.data();
+    if (file_.size() == 0) {
+        return false;
+    }
+    const std::size_t end = lineEnd(data, file_.size(), 0);
+    if (end == std::string_view::npos) {
+        return false;
+    }
+    std::string_view line(reinterpret_cast<const char*>(data), end - 1);
+    if (line.substr(0, kMagic.size()) != kMagic) {
+        return false;
+    }
+    line.remove_prefix(kMagic.size());
+
+    fpsNum_ = 25;
+    fpsDen_ = 1;
+    while (!line.empty()) {
+        const std::size_t space = line.find(' ');
+        const std::string_view token = line.substr(0, space);
+        line.remove_prefix(space == std::string_view::npos ? line.size() : space + 1);
+        if (token.empty()) {
+            continue;
+        }
+        const std::string_view value = token.substr(1);
+        switch (token[0]) {
+        case 'W':
+            if (!parseInt(value, width_)) {
+                return false;
+            }
+            break;
+        case 'H':
+            if (!parseInt(value, height_)) {
+                return false;
+            }
+            break;
+        case 'F': {
+            const std::size_t colon = value.find(':');
+            if (colon == std::string_view::npos || !parseInt(value.substr(0, colon), fpsNum_) ||
+                !parseInt(value.substr(colon + 1), fpsDen_) || fpsNum_ <= 0 || fpsDen_ <= 0) {
+                return false;
+            }
+            break;
+        }
+        case 'C':
+            // The 4:2:0 variants differ only in chroma siting.
+            if (value != "420" && value != "420jpeg" && value != "420paldv" &&
+                value != "420mpeg2") {
+                return false;
+            }
+            break;
+        case 'X':
+            if (value == "COLORRANGE=FULL") {
+                range_ = render::YuvRange::Full;
+            }
+            break;
+        default:
+            break; // interlacing, aspect ratio
+        }
+    }
+    offset = end;
+    return width_ > 0 && height_ > 0;
+}
+
+std::int64_t Y4mDecoder::syncFrameAt(std::int64_t timeUs) const {
+    // Last frame presented at or before timeUs, then back to its GOP start.
+    std::int64_t index = timeUs <= 0 ? 0
+                                     : timeUs * fpsNum_ /
+                                           (std::int64_t{1000000} * fpsDen_);
+    if (ptsOf(index + 1) <= timeUs) {
+        ++index; // ptsOf() rounds down
+    }
+    index = std::min(index, std::max<std::int64_t>(frameCount() - 1, 0));
+    return index - index % gopLength_;
+}
+
+bool Y4mDecoder::seekToUs(std::int64_t timeUs) {
+    if (!file_.isOpen()) {
+        return false;
+    }
+    next_ = syncFrameAt(timeUs);
+    current_ = -1;
+    ended_ = false;
+    return true;
+}
+
+std::int64_t Y4mDecoder::syncSampleUs(std::int64_t timeUs) {
+    return file_.isOpen() ? ptsOf(syncFrameAt(timeUs)) : -1;
+}
+
+bool Y4mDecoder::decodeNext(std::int64_t) {
+    if (!file_.isOpen() || ended_) {
+        return false;
+    }
+    if (next_ >= frameCount()) {
+        ended_ = true;
+        return false;
+    }
+    current_ = next_++;
+    return true;
+}
+
+std::int64_t Y4mDecoder::framePtsUs() const {
+    return current_ < 0 ? -1 : ptsOf(current_);
+}
+
+std::int64_t Y4mDecoder::ptsOf(std::int64_t index) const {
+    return fpsNum_ > 0 ? index * 1000000 * fpsDen_ / fpsNum_ : 0;
+}
+
+std::int64_t Y4mDecoder::durationUs() const {
+    return ptsOf(frameCount());
+}
+
+std::int64_t Y4mDecoder::frameDurationUs() const {
+    return ptsOf(1);
+}
+
+bool Y4mDecoder::readRgba(std::uint8_t* dst, int stride) {
+    if (current_ < 0 || !dst || stride < width_ * 4) {
+        return false;
+    }
+    const std::uint8_t* y = file_.data() + frames_[static_cast<std::size_t>(current_)];
+    const std::size_t lumaBytes = static_cast<std::size_t>(width_) * height_;
+    const int chromaWidth = (width_ + 1) / 2;
+
+    render::YuvImage image;
+    image.width = width_;
+    image.height = height_;
+    image.layout = render::YuvLayout::I420;
+    image.y = y;
+    image.u = y + lumaBytes;
+    image.v = image.u + static_cast<std::size_t>(chromaWidth) * ((height_ + 1) / 2);
+    image.yStride = width_;
+    image.uvStride = chromaWidth;
+
+    render::Frame out;
+    out.width = width_;
+    out.height = height_;
+    out.format = render::PixelFormat::RGBA8;
+    out.cpuData = dst;
+    out.cpuStride = stride;
+    render::yuvToRgba(image, render::YuvMatrix::BT601, range_, out, 0, height_);
+    return true;
+}
+
+} // namespace cineforge::media
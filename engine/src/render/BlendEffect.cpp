@@ -0,0 +1,108 @@
+#include "cineforge/render/BlendEffect.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace cineforge::render {
+
+namespace {
+
+bool hasCpuPixels(const Frame& f) {
+    return f.cpuData && (f.format == PixelFormat::RGBA8 ||
+                         f.format == PixelFormat::BGRA8);
+}
+
+float blendChannel(BlendMode mode, float dst, float src) {
+    switch (mode) {
+    case BlendMode::Add:
+        return std::min(dst + src, 1.0f);
+    case BlendMode::Multiply:
+        return dst * src;
+    case BlendMode::Screen:
+        return 1.0f - (1.0f - dst) * (1.0f - src);
+    case BlendMode::Normal:
+    case BlendMode::Dissolve:
+        break;
+    }
+    return src;
+}
+
+void blendRow(BlendMode mode, float opacity, std::uint8_t* dst,
+              const std::uint8_t* src, int width) {
+    constexpr float kInv = 1.0f / 255.0f;
+    for (int x = 0; x < width; ++x, dst += 4, src += 4) {
+        // Dissolve ignores alpha: both clips are opaque layers being mixed.
+        const float a = mode == BlendMode::Dissolve
+                            ? opacity
+                            : src[3] * kInv * opacity;
+        for (int c = 0; c < 3; ++c) {
+            const float d = dst[c] * kInv;
+            const float b = blendChannel(mode, d, src[c] * kInv);
+            dst[c] = static_cast<std::uint8_t>((d + (b - d) * a) * 255.0f + 0.5f);
+        }
+        const float da = dst[3] * kInv;
+        const float oa = mode == BlendMode::Dissolve ? da + (src[3] * kInv - da) * a
+                                                     : a + da * (1.0f - a);
+        dst[3] = static_cast<std::uint8_t>(oa * 255.0f + 0.5f);
+    }
+}
+
+} // namespace
+
+BlendEffect::BlendEffect(BlendMode mode, float opacity) : mode_(mode) {
+    setOpacity(opacity);
+}
+
+std::size_t BlendEffect::inputCount() const {
+    return mode_ == BlendMode::Dissolve ? 2 : 0;
+}
+
+void BlendEffect::setOpacity(float opacity) {
+    opacity = std::clamp(opacity, 0.0f, 1.0f);
+    if (opacity != opacity_) {
+        opacity_ = opacity;
+        paramsChanged();
+    }
+}
+
+void BlendEffect::setMode(BlendMode mode) {
+    if (mode != mode_) {
+        mode_ = mode;
+        paramsChanged();
+    }
+}
+
+void BlendEffect::process(const Frame* const* inputs, std::size_t count,
+                          Frame& output) {
+    if (count == 0 || !hasCpuPixels(output)) {
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!hasCpuPixels(*inputs[i]) || inputs[i]->format != output.format) {
+            return;
+        }
+    }
+
+    const int width = output.width;
+    const int height = output.height;
+    const auto rowBytes = static_cast<std::size_t>(width) * 4;
+    const Frame& base = *inputs[0];
+    for (int y = 0; y < std::min(height, base.height); ++y) {
+        std::uint8_t* dst = output.cpuData + static_cast<std::size_t>(y) * output.cpuStride;
+        const std::uint8_t* src = base.cpuData + static_cast<std::size_t>(y) * base.cpuStride;
+        std::memcpy(dst, src, std::min(rowBytes, static_cast<std::size_t>(base.width) * 4));
+    }
+
+    for (std::size_t i = 1; i < count; ++i) {
+        const Frame& layer = *inputs[i];
+        const int w = std::min(width, layer.width);
+        const int h = std::min(height, layer.height);
+        for (int y = 0; y < h; ++y) {
+            blendRow(mode_, opacity_,
+                     output.cpuData + static_cast<std::size_t>(y) * output.cpuStride,
+                     layer.cpuData + static_cast<std::size_t>(y) * layer.cpuStride, w);
+        }
+    }
+}
+
+} // namespace cineforge::render
@@ -0,0 +1,48 @@
+#include "cineforge/render/ColorGradeEffect.h"
+
+namespace cineforge::render {
+
+ColorGradeEffect::ColorGradeEffect(float brightness, float contrast, float saturation)
+    : brightness_(brightness), contrast_(contrast), saturation_(saturation) {}
+
+void ColorGradeEffect::setParams(float brightness, float contrast, float saturation) {
+    if (brightness == brightness_ && contrast == contrast_ && saturation == saturation_) {
+        return; // animation sets them every frame
+    }
+    brightness_ = brightness;
+    contrast_ = contrast;
+    saturation_ = saturation;
+    paramsChanged();
+}
+
+// The shader's three steps are affine, so they fold into one matrix:
+//   v   = c * brightness * contrast + 0.5 * (1 - contrast)
+//   out = v * sat + luma(v) * (1 - sat)
+// The luma weights sum to 1, so the saturation step keeps the constant
+// term unchanged.
+bool ColorGradeEffect::colorMatrix(ColorMatrix& out) const {
+    static constexpr float kLuma[3] = {0.299f, 0.587f, 0.114f};
+    const float mul = brightness_ * contrast_;
+    const float add = 0.5f * (1.0f - contrast_);
+
+    out = ColorMatrix::identity();
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            const float sat = (i == j ? saturation_ : 0.0f) +
+                              (1.0f - saturation_) * kLuma[j];
+            out.m[i][j] = mul * sat;
+        }
+        out.m[i][4] = add;
+    }
+    return true;
+}
+
+void ColorGradeEffect::process(const Frame& input, Frame& output) {
+    // GPU frames are graded by the backend's shader; applyColorMatrix()
+    // only touches CPU frames.
+    ColorMatrix m;
+    colorMatrix(m);
+    applyColorMatrix(input, output, m, 0, input.height);
+}
+
+} // namespace cineforge::render
@@ -0,0 +1,227 @@
+#include "cineforge/render/ColorMatrix.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+#if !defined(CINEFORGE_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CINEFORGE_MATRIX_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CINEFORGE_MATRIX_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace cineforge::render {
+
+namespace {
+
+// Matrix in memory channel order and 8-bit units:
+//   out[i] = k[i][0] * c0 + k[i][1] * c1 + k[i][2] * c2 + k[i][3] * c3 + k[i][4]
+// Results are clamped to [0, 255] and rounded half up. Every kernel below
+// uses the same operation order, so the paths agree byte for byte unless
+// the compiler contracts the scalar one into FMAs.
+struct Kernel {
+    float k[4][5];
+};
+
+Kernel makeKernel(const ColorMatrix& cm, PixelFormat fmt) {
+    // Memory channel -> RGBA channel.
+    static constexpr int kRgba[4] = {0, 1, 2, 3};
+    static constexpr int kBgra[4] = {2, 1, 0, 3};
+    const int* ch = fmt == PixelFormat::BGRA8 ? kBgra : kRgba;
+
+    Kernel kern{};
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            kern.k[i][j] = cm.m[ch[i]][ch[j]];
+        }
+        kern.k[i][4] = cm.m[ch[i]][4] * 255.0f;
+    }
+    return kern;
+}
+
+inline std::uint8_t toByte(float v) {
+    return static_cast<std::uint8_t>(std::min(std::max(v, 0.0f), 255.0f) + 0.5f);
+}
+
+void applyRowScalar(const std::uint8_t* src, std::uint8_t* dst, int width,
+                    const Kernel& kern) {
+    const auto& k = kern.k;
+    for (int x = 0; x < width; ++x, src += 4, dst += 4) {
+        const float c0 = src[0], c1 = src[1], c2 = src[2], c3 = src[3];
+        for (int i = 0; i < 4; ++i) {
+            dst[i] = toByte(k[i][0] * c0 + k[i][1] * c1 + k[i][2] * c2 +
+                            k[i][3] * c3 + k[i][4]);
+        }
+    }
+}
+
+#if defined(CINEFORGE_MATRIX_SSE2)
+
+// Four pixels per iteration: each 32-bit lane holds one pixel, so the
+// channels are split out with shifts and masks rather than shuffles.
+int applyRowSimd(const std::uint8_t* src, std::uint8_t* dst, int width,
+                 const Kernel& kern) {
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 maxv = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128 k[4][5];
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            k[i][j] = _mm_set1_ps(kern.k[i][j]);
+        }
+    }
+
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        const __m128i px =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+        const __m128 c0 = _mm_cvtepi32_ps(_mm_and_si128(px, byteMask));
+        const __m128 c1 = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 8), byteMask));
+        const __m128 c2 = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px, 16), byteMask));
+        const __m128 c3 = _mm_cvtepi32_ps(_mm_srli_epi32(px, 24));
+
+        __m128i out = _mm_setzero_si128();
+        for (int i = 0; i < 4; ++i) {
+            __m128 v = _mm_mul_ps(k[i][0], c0);
+            v = _mm_add_ps(v, _mm_mul_ps(k[i][1], c1));
+            v = _mm_add_ps(v, _mm_mul_ps(k[i][2], c2));
+            v = _mm_add_ps(v, _mm_mul_ps(k[i][3], c3));
+            v = _mm_add_ps(v, k[i][4]);
+            v = _mm_add_ps(_mm_min_ps(_mm_max_ps(v, zero), maxv), half);
+            const __m128i q = _mm_cvttps_epi32(v);
+            switch (i) {
+            case 0: out = q; break;
+            case 1: out = _mm_or_si128(out, _mm_slli_epi32(q, 8)); break;
+            case 2: out = _mm_or_si128(out, _mm_slli_epi32(q, 16)); break;
+            default: out = _mm_or_si128(out, _mm_slli_epi32(q, 24)); break;
+            }
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), out);
+    }
+    return x;
+}
+
+#elif defined(CINEFORGE_MATRIX_NEON)
+
+// Eight pixels per iteration, deinterleaved by vld4.
+int applyRowSimd(const std::uint8_t* src, std::uint8_t* dst, int width,
+                 const Kernel& kern) {
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t maxv = vdupq_n_f32(255.0f);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const auto& k = kern.k;
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        uint8x8x4_t px = vld4_u8(src + x * 4);
+        uint16x8_t wide[4];
+        for (int j = 0; j < 4; ++j) {
+            wide[j] = vmovl_u8(px.val[j]);
+        }
+        uint16x4_t res[4][2];
+        for (int h = 0; h < 2; ++h) {
+            float32x4_t c[4];
+            for (int j = 0; j < 4; ++j) {
+                c[j] = vcvtq_f32_u32(
+                    vmovl_u16(h ? vget_high_u16(wide[j]) : vget_low_u16(wide[j])));
+            }
+            for (int i = 0; i < 4; ++i) {
+                float32x4_t v = vmulq_n_f32(c[0], k[i][0]);
+                v = vaddq_f32(v, vmulq_n_f32(c[1], k[i][1]));
+                v = vaddq_f32(v, vmulq_n_f32(c[2], k[i][2]));
+                v = vaddq_f32(v, vmulq_n_f32(c[3], k[i][3]));
+                v = vaddq_f32(v, vdupq_n_f32(k[i][4]));
+                v = vaddq_f32(vminq_f32(vmaxq_f32(v, zero), maxv), half);
+                res[i][h] = vmovn_u32(vcvtq_u32_f32(v));
+            }
+        }
+        for (int i = 0; i < 4; ++i) {
+            px.val[i] = vmovn_u16(vcombine_u16(res[i][0], res[i][1]));
+        }
+        vst4_u8(dst + x * 4, px);
+    }
+    return x;
+}
+
+#else
+
+int applyRowSimd(const std::uint8_t*, std::uint8_t*, int, const Kernel&) {
+    return 0;
+}
+
+#endif
+
+} // namespace
+
+ColorMatrix ColorMatrix::identity() {
+    ColorMatrix cm{};
+    for (int i = 0; i < 4; ++i) {
+        cm.m[i][i] = 1.0f;
+    }
+    return cm;
+}
+
+ColorMatrix compose(const ColorMatrix& after, const ColorMatrix& before) {
+    ColorMatrix out{};
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            float v = j == 4 ? after.m[i][4] : 0.0f;
+            for (int k = 0; k < 4; ++k) {
+                v += after.m[i][k] * before.m[k][j];
+            }
+            out.m[i][j] = v;
+        }
+    }
+    return out;
+}
+
+void applyColorMatrix(const Frame& input, Frame& output, const ColorMatrix& m,
+                      int y0, int y1) {
+    const bool packed = input.format == PixelFormat::RGBA8 ||
+                        input.format == PixelFormat::BGRA8;
+    if (!packed || !input.cpuData || !output.cpuData ||
+        output.format != input.format) {
+        return;
+    }
+    const Kernel kern = makeKernel(m, input.format);
+    const int width = std::min(input.width, output.width);
+    y0 = std::max(y0, 0);
+    y1 = std::min({y1, input.height, output.height});
+    for (int y = y0; y < y1; ++y) {
+        const std::uint8_t* src =
+            input.cpuData + static_cast<std::size_t>(y) * input.cpuStride;
+        std::uint8_t* dst =
+            output.cpuData + static_cast<std::size_t>(y) * output.cpuStride;
+        const int done = applyRowSimd(src, dst, width, kern);
+        applyRowScalar(src + done * 4, dst + done * 4, width - done, kern);
+    }
+}
+
+std::string colorMatrixGlsl(const ColorMatrix& cm, const std::string& name) {
+    // GLSL matrices are column-major: column j holds input channel j's
+    // contribution to each output channel.
+    std::string s = "vec4 " + name + "(vec4 c) {\n    mat4 m = mat4(";
+    char buf[32];
+    for (int j = 0; j < 4; ++j) {
+        for (int i = 0; i < 4; ++i) {
+            std::snprintf(buf, sizeof(buf), "%s%.9g", (i | j) ? ", " : "",
+                          static_cast<double>(cm.m[i][j]));
+            s += buf;
+        }
+    }
+    s += ");\n    vec4 o = vec4(";
+    for (int i = 0; i < 4; ++i) {
+        std::snprintf(buf, sizeof(buf), "%s%.9g", i ? ", " : "",
+                      static_cast<double>(cm.m[i][4]));
+        s += buf;
+    }
+    s += ");\n    return clamp(m * c + o, 0.0, 1.0);\n}\n";
+    return s;
+}
+
+} // namespace cineforge::render
@@ -2,33 +2,26 @@
 
 namespace cineforge::render {
 
-void EffectGraph::addEffect(std::unique_ptr<Effect> effect) {
-  effects_.push_back(std::move(effect));
-}
+EffectGraph::EffectGraph() { clear(); }
 
-void EffectGraph::clear() { effects_.clear(); }
-
-void EffectGraph::process(const Frame &sourceFrame, Frame &outFrame) const {
-  if (effects_.empty()) {
-    outFrame = sourceFrame;
+void EffectGraph::addEffect(std::unique_ptr<Effect> effect) {
+  const auto node = graph_.addEffect(std::move(effect), tail_);
+  if (node == RenderGraph::kNoNode)
     return;
-  }
-
-  FrameBuffer tmpA(sourceFrame.width, sourceFrame.height, sourceFrame.format);
-  FrameBuffer tmpB(sourceFrame.width, sourceFrame.height, sourceFrame.format);
+  tail_ = node;
+  graph_.setOutput(tail_);
+}
 
-  const Frame *in = &sourceFrame;
-  Frame *out = &tmpA.frame();
+void EffectGraph::clear() {
+  graph_.clear();
+  tail_ = graph_.addSource(0);
+  graph_.setOutput(tail_);
+}
 
-  for (std::size_t i = 0; i < effects_.size(); ++i) {
-    if (i == effects_.size() - 1) {
-      effects_[i]->process(*in, outFrame);
-    } else {
-      effects_[i]->process(*in, *out);
-      in = out;
-      out = (out == &tmpA.frame()) ? &tmpB.frame() : &tmpA.frame();
-    }
-  }
+void EffectGraph::process(const Frame &sourceFrame, Frame &outFrame,
+                          FrameBufferPool *pool) const {
+  // A chain always compiles; with no effects the source passes through.
+  graph_.process(sourceFrame, outFrame, pool);
 }
 
 } // namespace cineforge::render
@@ -1,8 +1,13 @@
 #include "cineforge/render/FrameBuffer.h"
 
+#include <atomic>
+#include <cstring>
+
 namespace cineforge::render {
 
-FrameBuffer::FrameBuffer(int width, int height, PixelFormat fmt) {
+FrameBuffer::FrameBuffer(int width, int height, PixelFormat fmt,
+                         FrameBackend backend)
+    : backend_(backend) {
     frame_.width = width;
     frame_.height = height;
     frame_.format = fmt;
@@ -26,13 +31,35 @@ void FrameBuffer::resize(int width, int height) {
 void FrameBuffer::createTexture() {
     // GPU‑specific allocation is delegated to the backend; for now we only
     // track an opaque id.
-    static uint64_t nextId = 1;
-    frame_.texture.id = nextId++;
+    static std::atomic<uint64_t> nextId{1};
+    frame_.texture.id = nextId.fetch_add(1, std::memory_order_relaxed);
+
+    if (backend_ != FrameBackend::Cpu || frame_.width <= 0 || frame_.height <= 0) {
+        return;
+    }
+    // NV12 rows hold luma; the interleaved chroma plane follows at half
+    // height with the same stride.
+    const auto w = static_cast<std::size_t>(frame_.width);
+    const auto h = static_cast<std::size_t>(frame_.height);
+    const std::size_t rowBytes = frame_.format == PixelFormat::NV12 ? w : w * 4;
+    const std::size_t rows = frame_.format == PixelFormat::NV12 ? h + (h + 1) / 2 : h;
+    const std::size_t stride =
+        (rowBytes + kRowAlignment - 1) / kRowAlignment * kRowAlignment;
+
+    storage_.reset(new std::uint8_t[stride * rows + kRowAlignment - 1]);
+    auto addr = reinterpret_cast<std::uintptr_t>(storage_.get());
+    addr = (addr + kRowAlignment - 1) & ~(std::uintptr_t{kRowAlignment} - 1);
+    frame_.cpuData = reinterpret_cast<std::uint8_t*>(addr);
+    frame_.cpuStride = static_cast<int>(stride);
+    std::memset(frame_.cpuData, 0, stride * rows);
 }
 
 void FrameBuffer::destroyTexture() {
     // Backend should free real GPU resources associated with this handle.
     frame_.texture.id = 0;
+    frame_.cpuData = nullptr;
+    frame_.cpuStride = 0;
+    storage_.reset();
 }
 
 } // namespace cineforge::render
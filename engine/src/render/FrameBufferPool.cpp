@@ -0,0 +1,177 @@
+#include "cineforge/render/FrameBufferPool.h"
+
+#include <algorithm>
+
+namespace cineforge::render {
+
+namespace {
+
+std::size_t bytesOf(const FrameBuffer& fb) {
+    const Frame& f = fb.frame();
+    return frameByteSize(f.width, f.height, f.format);
+}
+
+} // namespace
+
+FrameBufferPool::Handle& FrameBufferPool::Handle::operator=(Handle&& other) noexcept {
+    if (this != &other) {
+        reset();
+        pool_ = other.pool_;
+        buffer_ = std::move(other.buffer_);
+        other.pool_ = nullptr;
+    }
+    return *this;
+}
+
+void FrameBufferPool::Handle::reset() {
+    if (buffer_ && pool_) {
+        pool_->release(std::move(buffer_));
+    }
+    buffer_.reset();
+    pool_ = nullptr;
+}
+
+std::size_t FrameBufferPool::BucketHash::operator()(const BucketKey& k) const noexcept {
+    std::size_t h = static_cast<std::size_t>(k.width) * 73856093u;
+    h ^= static_cast<std::size_t>(k.height) * 19349663u;
+    h ^= static_cast<std::size_t>(k.format) * 83492791u;
+    h ^= static_cast<std::size_t>(k.backend) << 1;
+    return h;
+}
+
+FrameBufferPool::FrameBufferPool(std::size_t memoryLimit, FrameBackend backend)
+    : limit_(memoryLimit), backend_(backend) {}
+
+FrameBufferPool::~FrameBufferPool() = default;
+
+FrameBufferPool& FrameBufferPool::shared() {
+    static FrameBufferPool pool;
+    return pool;
+}
+
+FrameBufferPool::Handle FrameBufferPool::acquire(int width, int height,
+                                                 PixelFormat fmt) {
+    FrameBackend backend;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        backend = backend_;
+        auto it = idle_.find(BucketKey{width, height, fmt, backend});
+        if (it != idle_.end() && !it->second.empty()) {
+            // Most recently released first: likeliest to still be warm.
+            std::unique_ptr<FrameBuffer> fb = std::move(it->second.back().buffer);
+            it->second.pop_back();
+            const std::size_t bytes = bytesOf(*fb);
+            stats_.bytesIdle -= bytes;
+            stats_.bytesInUse += bytes;
+            --stats_.buffersIdle;
+            ++stats_.buffersInUse;
+            ++stats_.reuses;
+            return Handle(this, std::move(fb));
+        }
+    }
+
+    // Allocate outside the lock; backends may be slow to create textures.
+    auto fb = std::make_unique<FrameBuffer>(width, height, fmt, backend);
+    const std::size_t bytes = bytesOf(*fb);
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    ++stats_.allocations;
+    stats_.bytesInUse += bytes;
+    ++stats_.buffersInUse;
+    // Make room among idle buffers before the new one pushes us over.
+    if (stats_.bytesInUse + stats_.bytesIdle > limit_) {
+        evictIdleLocked(limit_ > stats_.bytesInUse ? limit_ - stats_.bytesInUse : 0);
+    }
+    stats_.peakBytes = std::max(stats_.peakBytes, stats_.bytesInUse + stats_.bytesIdle);
+    return Handle(this, std::move(fb));
+}
+
+void FrameBufferPool::release(std::unique_ptr<FrameBuffer> buffer) {
+    const Frame& f = buffer->frame();
+    const BucketKey key{f.width, f.height, f.format, buffer->backend()};
+    const std::size_t bytes = bytesOf(*buffer);
+
+    std::unique_ptr<FrameBuffer> doomed;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stats_.bytesInUse -= bytes;
+        --stats_.buffersInUse;
+        if (stats_.bytesInUse + stats_.bytesIdle + bytes > limit_) {
+            evictIdleLocked(limit_ > stats_.bytesInUse + bytes
+                                ? limit_ - stats_.bytesInUse - bytes
+                                : 0);
+        }
+        // Buffers of a backend we have since switched away from are dropped.
+        if (key.backend == backend_ &&
+            stats_.bytesInUse + stats_.bytesIdle + bytes <= limit_) {
+            idle_[key].push_back(IdleBuffer{std::move(buffer), ++clock_});
+            stats_.bytesIdle += bytes;
+            ++stats_.buffersIdle;
+        } else {
+            doomed = std::move(buffer);
+            ++stats_.frees;
+        }
+    }
+    // `doomed` is destroyed here, outside the lock.
+}
+
+void FrameBufferPool::setBackend(FrameBackend backend) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (backend_ != backend) {
+        backend_ = backend;
+        evictIdleLocked(0);
+    }
+}
+
+FrameBackend FrameBufferPool::backend() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return backend_;
+}
+
+void FrameBufferPool::setMemoryLimit(std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    limit_ = bytes;
+    evictIdleLocked(limit_ > stats_.bytesInUse ? limit_ - stats_.bytesInUse : 0);
+}
+
+std::size_t FrameBufferPool::memoryLimit() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return limit_;
+}
+
+void FrameBufferPool::trim() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    evictIdleLocked(0);
+}
+
+FrameBufferPool::Stats FrameBufferPool::stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return stats_;
+}
+
+// Frees idle buffers, least recently released first, until the idle
+// footprint is at most `idleBudget` bytes.
+void FrameBufferPool::evictIdleLocked(std::size_t idleBudget) {
+    while (stats_.bytesIdle > idleBudget) {
+        std::vector<IdleBuffer>* oldestBucket = nullptr;
+        std::size_t oldestIndex = 0;
+        for (auto& [key, bucket] : idle_) {
+            for (std::size_t i = 0; i < bucket.size(); ++i) {
+                if (!oldestBucket ||
+                    bucket[i].releasedAt < (*oldestBucket)[oldestIndex].releasedAt) {
+                    oldestBucket = &bucket;
+                    oldestIndex = i;
+                }
+            }
+        }
+        if (!oldestBucket) {
+            break;
+        }
+        stats_.bytesIdle -= bytesOf(*(*oldestBucket)[oldestIndex].buffer);
+        --stats_.buffersIdle;
+        ++stats_.frees;
+        oldestBucket->erase(oldestBucket->begin() + static_cast<long>(oldestIndex));
+    }
+}
+
+} // namespace cineforge::render
@@ -0,0 +1,120 @@
+#include "cineforge/render/FrameCache.h"
+
+#include <cmath>
+
+namespace cineforge::render {
+
+FrameCache::FrameCache(std::size_t budgetBytes, double ticksPerSecond)
+    : budget_(budgetBytes),
+      ticksPerSecond_(ticksPerSecond > 0.0 ? ticksPerSecond : 1000.0),
+      pool_(&FrameBufferPool::shared()) {}
+
+void FrameCache::setFrameBufferPool(FrameBufferPool* pool) {
+    if (!pool || pool == pool_) {
+        return;
+    }
+    clear();
+    pool_ = pool;
+}
+
+std::size_t FrameCache::KeyHash::operator()(const Key& k) const noexcept {
+    std::uint64_t h = static_cast<std::uint64_t>(k.tick) * 0x9E3779B97F4A7C15ull;
+    h ^= (static_cast<std::uint64_t>(static_cast<std::uint32_t>(k.width)) << 32) |
+         static_cast<std::uint32_t>(k.height);
+    return static_cast<std::size_t>(h ^ (h >> 29));
+}
+
+void FrameCache::setBudget(std::size_t budgetBytes) {
+    budget_ = budgetBytes;
+    evictTo(budget_);
+}
+
+void FrameCache::setTicksPerSecond(double ticksPerSecond) {
+    if (ticksPerSecond <= 0.0 || ticksPerSecond == ticksPerSecond_) {
+        return;
+    }
+    // Existing ticks mean something else under the new quantum.
+    clear();
+    ticksPerSecond_ = ticksPerSecond;
+}
+
+std::int64_t FrameCache::tickFor(double time) const {
+    // The epsilon keeps exact frame times from flooring into the previous
+    // tick because of rounding in time * rate.
+    return static_cast<std::int64_t>(std::floor(time * ticksPerSecond_ + 1e-6));
+}
+
+FrameCache::Entry* FrameCache::lookup(double time, int width, int height) {
+    auto it = map_.find(Key{tickFor(time), width, height});
+    if (it == map_.end()) {
+        ++stats_.misses;
+        return nullptr;
+    }
+    ++stats_.hits;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return &*it->second;
+}
+
+FrameCache::Entry* FrameCache::insert(double time, int width, int height,
+                                      PixelFormat fmt, Revision revision) {
+    const std::size_t bytes = frameByteSize(width, height, fmt);
+    if (bytes == 0 || bytes > budget_) {
+        return nullptr;
+    }
+
+    const Key key{tickFor(time), width, height};
+    auto existing = map_.find(key);
+    if (existing != map_.end()) {
+        erase(existing->second);
+    }
+    evictTo(budget_ - bytes);
+
+    Entry e;
+    e.tick = key.tick;
+    e.width = width;
+    e.height = height;
+    e.revision = revision;
+    e.t0 = static_cast<double>(key.tick) / ticksPerSecond_;
+    e.t1 = static_cast<double>(key.tick + 1) / ticksPerSecond_;
+    e.buffer = pool_->acquire(width, height, fmt);
+    e.bytes = bytes;
+
+    lru_.push_front(std::move(e));
+    map_.emplace(key, lru_.begin());
+    stats_.bytes += bytes;
+    stats_.entries = lru_.size();
+    return &lru_.front();
+}
+
+void FrameCache::invalidate(double t0, double t1) {
+    for (auto it = lru_.begin(); it != lru_.end();) {
+        auto next = std::next(it);
+        if (t0 < it->t1 && it->t0 < t1) {
+            erase(it);
+        }
+        it = next;
+    }
+}
+
+void FrameCache::clear() {
+    lru_.clear();
+    map_.clear();
+    stats_.bytes = 0;
+    stats_.entries = 0;
+}
+
+void FrameCache::evictTo(std::size_t budget) {
+    while (!lru_.empty() && stats_.bytes > budget) {
+        erase(std::prev(lru_.end()));
+        ++stats_.evictions;
+    }
+}
+
+void FrameCache::erase(LruList::iterator it) {
+    stats_.bytes -= it->bytes;
+    map_.erase(Key{it->tick, it->width, it->height});
+    lru_.erase(it);
+    stats_.entries = lru_.size();
+}
+
+} // namespace cineforge::render
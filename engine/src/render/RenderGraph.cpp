@@ -0,0 +1,436 @@
+#include "cineforge/render/RenderGraph.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace cineforge::render {
+
+namespace {
+
+bool packedCpu(const Frame& f) {
+    return f.cpuData && (f.format == PixelFormat::RGBA8 ||
+                         f.format == PixelFormat::BGRA8);
+}
+
+} // namespace
+
+RenderGraph::NodeId RenderGraph::addSource(std::size_t slot) {
+    Node node;
+    node.kind = NodeKind::Source;
+    node.slot = slot;
+    nodes_.push_back(std::move(node));
+    edited();
+    return static_cast<NodeId>(nodes_.size() - 1);
+}
+
+RenderGraph::NodeId RenderGraph::addEffect(std::unique_ptr<Effect> effect,
+                                           NodeId input) {
+    if (!effect || input >= nodes_.size()) {
+        return kNoNode;
+    }
+    Node node;
+    node.kind = NodeKind::Effect;
+    node.effect = std::move(effect);
+    node.inputs.push_back(input);
+    nodes_.push_back(std::move(node));
+    edited();
+    return static_cast<NodeId>(nodes_.size() - 1);
+}
+
+RenderGraph::NodeId RenderGraph::addComposite(
+    std::unique_ptr<CompositeEffect> effect, std::vector<NodeId> inputs) {
+    if (!effect || inputs.empty() || !validInputs(inputs)) {
+        return kNoNode;
+    }
+    Node node;
+    node.kind = NodeKind::Composite;
+    node.composite = std::move(effect);
+    node.inputs = std::move(inputs);
+    nodes_.push_back(std::move(node));
+    edited();
+    return static_cast<NodeId>(nodes_.size() - 1);
+}
+
+bool RenderGraph::setInputs(NodeId node, std::vector<NodeId> inputs) {
+    if (node >= nodes_.size() || nodes_[node].kind == NodeKind::Source ||
+        !validInputs(inputs)) {
+        return false;
+    }
+    nodes_[node].inputs = std::move(inputs);
+    edited();
+    return true;
+}
+
+void RenderGraph::setOutput(NodeId node) {
+    output_ = node;
+    edited();
+}
+
+void RenderGraph::setFusion(bool enabled) {
+    if (fusion_ != enabled) {
+        fusion_ = enabled;
+        edited();
+    }
+}
+
+void RenderGraph::setThreadPool(ThreadPool* pool) {
+    threads_ = pool;
+    sharedThreads_ = false;
+}
+
+void RenderGraph::clear() {
+    nodes_.clear();
+    output_ = kNoNode;
+    edited();
+}
+
+void RenderGraph::edited() {
+    dirty_ = true;
+    editRevision_ = nextParamsRevision();
+}
+
+std::uint64_t RenderGraph::revision() const {
+    std::uint64_t newest = editRevision_;
+    for (const Node& node : nodes_) {
+        if (node.effect) {
+            newest = std::max(newest, node.effect->paramsRevision());
+        } else if (node.composite) {
+            newest = std::max(newest, node.composite->paramsRevision());
+        }
+    }
+    return newest;
+}
+
+bool RenderGraph::validInputs(const std::vector<NodeId>& inputs) const {
+    return std::all_of(inputs.begin(), inputs.end(),
+                       [this](NodeId id) { return id < nodes_.size(); });
+}
+
+// Depth-first post-order over the ancestors of the output node, so each
+// branch is finished (and its intermediates released) before the next one
+// starts. Returns false on a cycle.
+bool RenderGraph::schedule(std::vector<NodeId>& order) const {
+    enum : std::uint8_t { kUnvisited, kOnStack, kDone };
+    std::vector<std::uint8_t> state(nodes_.size(), kUnvisited);
+    std::vector<std::pair<NodeId, std::size_t>> stack;
+
+    stack.emplace_back(output_, 0);
+    state[output_] = kOnStack;
+    while (!stack.empty()) {
+        auto& [id, next] = stack.back();
+        const auto& inputs = nodes_[id].inputs;
+        if (next < inputs.size()) {
+            const NodeId child = inputs[next++];
+            if (state[child] == kOnStack) {
+                return false;
+            }
+            if (state[child] == kUnvisited) {
+                state[child] = kOnStack;
+                stack.emplace_back(child, 0);
+            }
+            continue;
+        }
+        state[id] = kDone;
+        order.push_back(id);
+        stack.pop_back();
+    }
+    return true;
+}
+
+bool RenderGraph::fusable(NodeId id) const {
+    const Node& node = nodes_[id];
+    ColorMatrix m;
+    return fusion_ && node.kind == NodeKind::Effect &&
+           node.effect->access() == EffectAccess::PerPixel &&
+           node.effect->colorMatrix(m);
+}
+
+bool RenderGraph::compile() const {
+    if (!dirty_) {
+        return valid_;
+    }
+    dirty_ = false;
+    valid_ = false;
+    steps_.clear();
+    operands_.clear();
+    fused_.clear();
+    registerCount_ = 0;
+    outputSource_ = 0;
+    maxSlot_ = 0;
+
+    if (output_ >= nodes_.size()) {
+        return false;
+    }
+    std::vector<NodeId> order;
+    if (!schedule(order)) {
+        return false;
+    }
+
+    std::vector<std::uint32_t> consumers(nodes_.size(), 0);
+    std::vector<NodeId> consumer(nodes_.size(), kNoNode);
+    for (NodeId id : order) {
+        const Node& node = nodes_[id];
+        if (node.kind == NodeKind::Source) {
+            maxSlot_ = std::max(maxSlot_, node.slot + 1);
+        } else if (node.kind == NodeKind::Effect) {
+            if (node.inputs.size() != 1) {
+                return false;
+            }
+        } else {
+            const std::size_t arity = node.composite->inputCount();
+            if (node.inputs.empty() ||
+                (arity != 0 && arity != node.inputs.size())) {
+                return false;
+            }
+        }
+        for (NodeId in : node.inputs) {
+            ++consumers[in];
+            consumer[in] = id;
+        }
+    }
+
+    const Node& out = nodes_[output_];
+    if (out.kind == NodeKind::Source) {
+        outputSource_ = -static_cast<Operand>(out.slot) - 1;
+        valid_ = true;
+        return true;
+    }
+
+    // A colour-matrix effect whose only reader is another one is folded
+    // into that reader: the pair (and so on up the chain) becomes a single
+    // step reading the chain head's input, and the result in between is
+    // never stored.
+    std::vector<bool> canFuse(nodes_.size(), false);
+    for (NodeId id : order) {
+        canFuse[id] = fusable(id);
+    }
+    auto absorbed = [&](NodeId id) {
+        return canFuse[id] && id != output_ && consumers[id] == 1 &&
+               canFuse[consumer[id]];
+    };
+
+    struct Pending {
+        NodeId node;
+        NodeId head; // first node of a fused chain, or `node`
+    };
+    std::vector<Pending> pending;
+    for (NodeId id : order) {
+        if (nodes_[id].kind == NodeKind::Source || absorbed(id)) {
+            continue;
+        }
+        NodeId head = id;
+        if (canFuse[id]) {
+            while (absorbed(nodes_[head].inputs[0])) {
+                head = nodes_[head].inputs[0];
+            }
+        }
+        pending.push_back({id, head});
+    }
+
+    // Index in `pending` of the last step reading each node's result.
+    constexpr std::size_t kReleased = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> lastUse(nodes_.size(), 0);
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        for (NodeId in : nodes_[pending[i].head].inputs) {
+            lastUse[in] = i;
+        }
+    }
+
+    std::vector<std::int32_t> reg(nodes_.size(), -1);
+    std::vector<std::int32_t> freeRegs;
+    std::size_t maxOperands = 0;
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        const NodeId id = pending[i].node;
+        const auto& inputs = nodes_[pending[i].head].inputs;
+
+        Step step{id, static_cast<std::uint32_t>(operands_.size()),
+                  static_cast<std::uint32_t>(inputs.size()), -1, 0, 0};
+        for (NodeId in : inputs) {
+            const Node& src = nodes_[in];
+            operands_.push_back(src.kind == NodeKind::Source
+                                    ? -static_cast<Operand>(src.slot) - 1
+                                    : reg[in]);
+        }
+        if (pending[i].head != id) {
+            step.firstFused = static_cast<std::uint32_t>(fused_.size());
+            const std::size_t base = fused_.size();
+            for (NodeId n = id;; n = nodes_[n].inputs[0]) {
+                fused_.push_back(n);
+                if (n == pending[i].head) {
+                    break;
+                }
+            }
+            std::reverse(fused_.begin() + static_cast<long>(base), fused_.end());
+            step.fusedCount = static_cast<std::uint32_t>(fused_.size() - base);
+        }
+
+        // Pick the target before freeing this step's inputs so that an
+        // effect never reads and writes the same buffer.
+        if (id != output_) {
+            if (freeRegs.empty()) {
+                step.target = static_cast<std::int32_t>(registerCount_++);
+            } else {
+                step.target = freeRegs.back();
+                freeRegs.pop_back();
+            }
+            reg[id] = step.target;
+        }
+        for (NodeId in : inputs) {
+            if (lastUse[in] == i && reg[in] >= 0) {
+                freeRegs.push_back(reg[in]);
+                lastUse[in] = kReleased;
+            }
+        }
+        steps_.push_back(step);
+        maxOperands = std::max<std::size_t>(maxOperands, step.operandCount);
+    }
+
+    regs_.resize(registerCount_);
+    inputs_.reserve(maxOperands);
+    valid_ = true;
+    return true;
+}
+
+bool RenderGraph::process(const Frame* const* sources, std::size_t sourceCount,
+                          Frame& outFrame, FrameBufferPool* pool) const {
+    if (!compile() || maxSlot_ > sourceCount) {
+        return false;
+    }
+    if (outputSource_ < 0) {
+        outFrame = *sources[-outputSource_ - 1];
+        return true;
+    }
+    if (!pool) {
+        pool = &FrameBufferPool::shared();
+    }
+
+    // Sized by compile(), so steady-state rendering allocates nothing here.
+    for (const Step& step : steps_) {
+        inputs_.clear();
+        for (std::uint32_t k = 0; k < step.operandCount; ++k) {
+            const Operand op = operands_[step.firstOperand + k];
+            inputs_.push_back(op >= 0 ? &regs_[op].frame() : sources[-op - 1]);
+        }
+
+        Frame* target = &outFrame;
+        if (step.target >= 0) {
+            auto& handle = regs_[step.target];
+            if (!handle) {
+                handle = pool->acquire(outFrame.width, outFrame.height,
+                                       outFrame.format);
+            }
+            target = &handle.frame();
+        }
+
+        if (step.fusedCount > 0) {
+            runFused(step, *inputs_[0], *target, *pool);
+        } else {
+            run(nodes_[step.node], inputs_.data(), inputs_.size(), *target);
+        }
+    }
+    // Intermediates go back to the pool between frames.
+    for (auto& handle : regs_) {
+        handle.reset();
+    }
+    return true;
+}
+
+int RenderGraph::stripesFor(const Frame* const* inputs, std::size_t count,
+                            const Frame& target, ThreadPool* pool) const {
+    if (!pool || pool->size() == 0 || !packedCpu(target)) {
+        return 1;
+    }
+    // Split only when every frame is a packed CPU image covering the
+    // target's rows.
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!packedCpu(*inputs[i]) || inputs[i]->format != target.format ||
+            inputs[i]->height < target.height) {
+            return 1;
+        }
+    }
+    const auto pixels = static_cast<std::size_t>(target.width) *
+                        static_cast<std::size_t>(target.height);
+    // More stripes than threads lets fast workers steal from slow ones.
+    return static_cast<int>(std::max<std::size_t>(
+        1, std::min<std::size_t>(
+               {static_cast<std::size_t>(target.height / kMinStripeRows),
+                pixels / kMinStripePixels, (pool->size() + 1) * 4})));
+}
+
+void RenderGraph::run(const Node& node, const Frame* const* inputs,
+                      std::size_t count, Frame& target) const {
+    const bool single = node.kind == NodeKind::Effect;
+    const EffectAccess access =
+        single ? node.effect->access() : node.composite->access();
+
+    ThreadPool* pool = sharedThreads_ ? &ThreadPool::shared() : threads_;
+    int stripes = 1;
+    if (access != EffectAccess::WholeFrame &&
+        (single || count <= CompositeEffect::kMaxRowInputs)) {
+        stripes = stripesFor(inputs, count, target, pool);
+    }
+
+    if (stripes <= 1) {
+        if (single) {
+            node.effect->process(*inputs[0], target);
+        } else {
+            node.composite->process(inputs, count, target);
+        }
+        return;
+    }
+
+    const int height = target.height;
+    pool->parallelFor(static_cast<std::size_t>(stripes), [&](std::size_t i) {
+        const int y0 = static_cast<int>(height * i / stripes);
+        const int y1 = static_cast<int>(height * (i + 1) / stripes);
+        if (single) {
+            node.effect->processRows(*inputs[0], target, y0, y1);
+        } else {
+            node.composite->processRows(inputs, count, target, y0, y1);
+        }
+    });
+}
+
+void RenderGraph::runFused(const Step& step, const Frame& input, Frame& target,
+                           FrameBufferPool& buffers) const {
+    const NodeId* chain = fused_.data() + step.firstFused;
+    const Frame* inputs[] = {&input};
+    ThreadPool* pool = sharedThreads_ ? &ThreadPool::shared() : threads_;
+
+    if (!packedCpu(input) || !packedCpu(target) || input.format != target.format) {
+        // GPU frames: run the chain unfused, alternating between the target
+        // and one scratch buffer so that the last effect lands in the target.
+        // A GPU backend would instead compile colorMatrixGlsl() of the
+        // composed matrix into a single pass.
+        FrameBufferPool::Handle scratch =
+            buffers.acquire(target.width, target.height, target.format);
+        const Frame* in = &input;
+        for (std::uint32_t k = 0; k < step.fusedCount; ++k) {
+            const bool toTarget = (step.fusedCount - 1 - k) % 2 == 0;
+            Frame& out = toTarget ? target : scratch.frame();
+            nodes_[chain[k]].effect->process(*in, out);
+            in = &out;
+        }
+        return;
+    }
+
+    ColorMatrix m = ColorMatrix::identity();
+    for (std::uint32_t k = 0; k < step.fusedCount; ++k) {
+        ColorMatrix next;
+        nodes_[chain[k]].effect->colorMatrix(next);
+        m = compose(next, m);
+    }
+
+    const int stripes = stripesFor(inputs, 1, target, pool);
+    if (stripes <= 1) {
+        applyColorMatrix(input, target, m, 0, target.height);
+        return;
+    }
+    const int height = target.height;
+    pool->parallelFor(static_cast<std::size_t>(stripes), [&](std::size_t i) {
+        applyColorMatrix(input, target, m, static_cast<int>(height * i / stripes),
+                         static_cast<int>(height * (i + 1) / stripes));
+    });
+}
+
+} // namespace cineforge::render
@@ -5,13 +5,33 @@ namespace cineforge::render {
 Renderer::Renderer() = default;
 
 void Renderer::setEffectGraph(const EffectGraph* graph) {
+    if (graph_ != graph) {
+        cache_.clear();
+    }
     graph_ = graph;
 }
 
+void Renderer::setChangeQuery(ChangeQuery query) {
+    changeQuery_ = std::move(query);
+}
+
+void Renderer::setFrameBufferPool(FrameBufferPool* pool) {
+    if (!pool || pool == pool_) {
+        return;
+    }
+    ping_.reset();
+    pong_.reset();
+    pool_ = pool;
+    cache_.setFrameBufferPool(pool);
+}
+
 void Renderer::ensureBuffers(int w, int h) {
     if (!ping_ || ping_->frame().width != w || ping_->frame().height != h) {
-        ping_ = std::make_unique<FrameBuffer>(w, h, PixelFormat::RGBA8);
-        pong_ = std::make_unique<FrameBuffer>(w, h, PixelFormat::RGBA8);
+        // Release first so a size we return to can reuse these buffers.
+        ping_.reset();
+        pong_.reset();
+        ping_ = pool_->acquire(w, h, PixelFormat::RGBA8);
+        pong_ = pool_->acquire(w, h, PixelFormat::RGBA8);
     }
 }
 
@@ -22,13 +42,43 @@ Frame Renderer::renderPreview(const RenderContext& ctx) {
     // from the media subsystem. For now we just clear/return an empty frame.
     Frame source = ping_->frame();
 
-    if (graph_) {
-        graph_->process(source, pong_->frame());
-        return pong_->frame();
+    if (!graph_) {
+        return source;
     }
 
-    return source;
+    // Effect parameters apply across the whole timeline, so any change to
+    // the graph makes every cached frame stale.
+    const std::uint64_t graphRevision = graph_->graph().revision();
+    if (graphRevision != graphRevision_) {
+        cache_.clear();
+        graphRevision_ = graphRevision;
+    }
+
+    FrameBuffer* target = pong_.get();
+    if (ctx.revision != 0) {
+        FrameCache::Entry* entry =
+            cache_.lookup(ctx.timeSeconds, ctx.targetWidth, ctx.targetHeight);
+        if (entry) {
+            if (entry->revision == ctx.revision ||
+                (changeQuery_ &&
+                 !changeQuery_(entry->revision, entry->t0, entry->t1))) {
+                entry->revision = ctx.revision;
+                return entry->buffer->frame();
+            }
+            // Stale: re-render in place, reusing the entry's buffer.
+            entry->revision = ctx.revision;
+        } else {
+            entry = cache_.insert(ctx.timeSeconds, ctx.targetWidth,
+                                  ctx.targetHeight, PixelFormat::RGBA8,
+                                  ctx.revision);
+        }
+        if (entry) {
+            target = entry->buffer.get();
+        }
+    }
+
+    graph_->process(source, target->frame(), pool_);
+    return target->frame();
 }
 
 } // namespace cineforge::render
-
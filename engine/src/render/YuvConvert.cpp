@@ -0,0 +1,363 @@
+#include "cineforge/render/YuvConvert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if !defined(CINEFORGE_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CINEFORGE_YUV_SSE2 1
+#include <emmintrin.h>
+// AVX2 is compiled per function and picked at run time, so the library
+// still runs on SSE2-only CPUs.
+#if defined(__GNUC__) || defined(__clang__)
+#define CINEFORGE_YUV_AVX2 1
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CINEFORGE_YUV_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace cineforge::render {
+
+namespace {
+
+// Fixed point with 6 fractional bits, as in
+//   R = ((Y - yOff) * yScale + 32 + vr * (V - 128)) >> 6
+//   G = ((Y - yOff) * yScale + 32 - ug * (U - 128) - vg * (V - 128)) >> 6
+//   B = ((Y - yOff) * yScale + 32 + ub * (U - 128)) >> 6
+// clamped to [0, 255]. Every product fits in 16 bits, and the only sums
+// that can leave 16 bits are far outside [0, 255], so the SIMD kernels'
+// saturating 16-bit adds clamp to the same bytes as the scalar path.
+struct Coeffs {
+    int yOff, yScale, vr, ug, vg, ub;
+};
+
+Coeffs makeCoeffs(YuvMatrix matrix, YuvRange range) {
+    const double kr = matrix == YuvMatrix::BT709 ? 0.2126 : 0.299;
+    const double kb = matrix == YuvMatrix::BT709 ? 0.0722 : 0.114;
+    const double kg = 1.0 - kr - kb;
+    const bool limited = range == YuvRange::Limited;
+    const double ys = limited ? 255.0 / 219.0 : 1.0;
+    const double cs = limited ? 255.0 / 224.0 : 1.0;
+    auto q = [](double v) { return static_cast<int>(std::lround(v * 64.0)); };
+    return {limited ? 16 : 0,
+            q(ys),
+            q(2.0 * (1.0 - kr) * cs),
+            q(2.0 * kb * (1.0 - kb) / kg * cs),
+            q(2.0 * kr * (1.0 - kr) / kg * cs),
+            q(2.0 * (1.0 - kb) * cs)};
+}
+
+// One output row. Chroma for pixel x is u[(x / 2) * cstep] and likewise
+// for v; cstep is 2 for the interleaved layouts.
+struct Row {
+    const std::uint8_t* y;
+    const std::uint8_t* u;
+    const std::uint8_t* v;
+    int cstep;
+    std::uint8_t* dst;
+};
+
+inline std::uint8_t clampByte(int v) {
+    return static_cast<std::uint8_t>(std::min(std::max(v, 0), 255));
+}
+
+void rowScalar(const Row& row, int x0, int width, const Coeffs& k) {
+    for (int x = x0; x < width; ++x) {
+        const int c = (x >> 1) * row.cstep;
+        const int yc = (row.y[x] - k.yOff) * k.yScale + 32;
+        const int u = row.u[c] - 128;
+        const int v = row.v[c] - 128;
+        std::uint8_t* d = row.dst + static_cast<std::size_t>(x) * 4;
+        d[0] = clampByte((yc + k.vr * v) >> 6);
+        d[1] = clampByte((yc - k.ug * u - k.vg * v) >> 6);
+        d[2] = clampByte((yc + k.ub * u) >> 6);
+        d[3] = 255;
+    }
+}
+
+#if defined(CINEFORGE_YUV_SSE2)
+
+// Sixteen pixels per iteration. `u` and `v` hold one chroma sample per
+// pixel pair in their low 8 bytes.
+inline void convert16Sse2(__m128i y, __m128i u, __m128i v, std::uint8_t* dst,
+                          const Coeffs& k) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i yOff = _mm_set1_epi16(static_cast<short>(k.yOff));
+    const __m128i yScale = _mm_set1_epi16(static_cast<short>(k.yScale));
+    const __m128i bias = _mm_set1_epi16(32);
+    const __m128i mid = _mm_set1_epi16(128);
+    const __m128i ud = _mm_unpacklo_epi8(u, u);
+    const __m128i vd = _mm_unpacklo_epi8(v, v);
+
+    __m128i rgb[3][2];
+    for (int h = 0; h < 2; ++h) {
+        const __m128i y16 = h ? _mm_unpackhi_epi8(y, zero) : _mm_unpacklo_epi8(y, zero);
+        const __m128i u16 = _mm_sub_epi16(
+            h ? _mm_unpackhi_epi8(ud, zero) : _mm_unpacklo_epi8(ud, zero), mid);
+        const __m128i v16 = _mm_sub_epi16(
+            h ? _mm_unpackhi_epi8(vd, zero) : _mm_unpacklo_epi8(vd, zero), mid);
+        const __m128i yc =
+            _mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(y16, yOff), yScale), bias);
+        rgb[0][h] = _mm_srai_epi16(
+            _mm_adds_epi16(yc, _mm_mullo_epi16(v16, _mm_set1_epi16(static_cast<short>(k.vr)))), 6);
+        rgb[1][h] = _mm_srai_epi16(
+            _mm_subs_epi16(
+                _mm_subs_epi16(yc, _mm_mullo_epi16(u16, _mm_set1_epi16(static_cast<short>(k.ug)))),
+                _mm_mullo_epi16(v16, _mm_set1_epi16(static_cast<short>(k.vg)))),
+            6);
+        rgb[2][h] = _mm_srai_epi16(
+            _mm_adds_epi16(yc, _mm_mullo_epi16(u16, _mm_set1_epi16(static_cast<short>(k.ub)))), 6);
+    }
+    const __m128i r = _mm_packus_epi16(rgb[0][0], rgb[0][1]);
+    const __m128i g = _mm_packus_epi16(rgb[1][0], rgb[1][1]);
+    const __m128i b = _mm_packus_epi16(rgb[2][0], rgb[2][1]);
+    const __m128i a = _mm_set1_epi8(-1);
+
+    __m128i rg = _mm_unpacklo_epi8(r, g);
+    __m128i ba = _mm_unpacklo_epi8(b, a);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(rg, ba));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi16(rg, ba));
+    rg = _mm_unpackhi_epi8(r, g);
+    ba = _mm_unpackhi_epi8(b, a);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_unpacklo_epi16(rg, ba));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), _mm_unpackhi_epi16(rg, ba));
+}
+
+int rowSse2(const Row& row, int width, const Coeffs& k) {
+    const __m128i lowBytes = _mm_set1_epi16(0xFF);
+    const __m128i zero = _mm_setzero_si128();
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row.y + x));
+        __m128i u, v;
+        if (row.cstep == 2) {
+            const std::uint8_t* base = std::min(row.u, row.v);
+            const __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + x));
+            const __m128i even = _mm_packus_epi16(_mm_and_si128(uv, lowBytes), zero);
+            const __m128i odd = _mm_packus_epi16(_mm_srli_epi16(uv, 8), zero);
+            u = row.u < row.v ? even : odd;
+            v = row.u < row.v ? odd : even;
+        } else {
+            u = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row.u + x / 2));
+            v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row.v + x / 2));
+        }
+        convert16Sse2(y, u, v, row.dst + static_cast<std::size_t>(x) * 4, k);
+    }
+    return x;
+}
+
+#endif
+
+#if defined(CINEFORGE_YUV_AVX2)
+
+#define CINEFORGE_AVX2_TARGET __attribute__((target("avx2")))
+
+// Converts 16 pixels held as 16-bit lanes into R, G, B lanes.
+CINEFORGE_AVX2_TARGET inline void rgb16Avx2(__m256i y16, __m256i u16, __m256i v16,
+                                            const Coeffs& k, __m256i out[3]) {
+    const __m256i mid = _mm256_set1_epi16(128);
+    u16 = _mm256_sub_epi16(u16, mid);
+    v16 = _mm256_sub_epi16(v16, mid);
+    const __m256i yc = _mm256_add_epi16(
+        _mm256_mullo_epi16(_mm256_sub_epi16(y16, _mm256_set1_epi16(static_cast<short>(k.yOff))),
+                           _mm256_set1_epi16(static_cast<short>(k.yScale))),
+        _mm256_set1_epi16(32));
+    out[0] = _mm256_srai_epi16(
+        _mm256_adds_epi16(yc, _mm256_mullo_epi16(v16, _mm256_set1_epi16(static_cast<short>(k.vr)))),
+        6);
+    out[1] = _mm256_srai_epi16(
+        _mm256_subs_epi16(
+            _mm256_subs_epi16(yc,
+                              _mm256_mullo_epi16(u16, _mm256_set1_epi16(static_cast<short>(k.ug)))),
+            _mm256_mullo_epi16(v16, _mm256_set1_epi16(static_cast<short>(k.vg)))),
+        6);
+    out[2] = _mm256_srai_epi16(
+        _mm256_adds_epi16(yc, _mm256_mullo_epi16(u16, _mm256_set1_epi16(static_cast<short>(k.ub)))),
+        6);
+}
+
+// Thirty-two pixels per iteration. The 256-bit unpacks work within
+// 128-bit lanes, so pixel order is restored by the final lane permutes.
+CINEFORGE_AVX2_TARGET int rowAvx2(const Row& row, int width, const Coeffs& k) {
+    const __m256i lowBytes = _mm256_set1_epi16(0xFF);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i a = _mm256_set1_epi8(-1);
+    int x = 0;
+    for (; x + 32 <= width; x += 32) {
+        const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row.y + x));
+        __m128i u, v;
+        if (row.cstep == 2) {
+            const std::uint8_t* base = std::min(row.u, row.v);
+            const __m256i uv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + x));
+            const __m128i even = _mm256_castsi256_si128(_mm256_permute4x64_epi64(
+                _mm256_packus_epi16(_mm256_and_si256(uv, lowBytes), zero), 0xD8));
+            const __m128i odd = _mm256_castsi256_si128(_mm256_permute4x64_epi64(
+                _mm256_packus_epi16(_mm256_srli_epi16(uv, 8), zero), 0xD8));
+            u = row.u < row.v ? even : odd;
+            v = row.u < row.v ? odd : even;
+        } else {
+            u = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row.u + x / 2));
+            v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row.v + x / 2));
+        }
+
+        __m256i lo[3], hi[3];
+        rgb16Avx2(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(y)),
+                  _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(u, u)),
+                  _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(v, v)), k, lo);
+        rgb16Avx2(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(y, 1)),
+                  _mm256_cvtepu8_epi16(_mm_unpackhi_epi8(u, u)),
+                  _mm256_cvtepu8_epi16(_mm_unpackhi_epi8(v, v)), k, hi);
+        // Lanes: [px 0-7, 16-23 | px 8-15, 24-31].
+        const __m256i r = _mm256_packus_epi16(lo[0], hi[0]);
+        const __m256i g = _mm256_packus_epi16(lo[1], hi[1]);
+        const __m256i b = _mm256_packus_epi16(lo[2], hi[2]);
+
+        std::uint8_t* dst = row.dst + static_cast<std::size_t>(x) * 4;
+        for (int half = 0; half < 2; ++half) {
+            const __m256i rg = half ? _mm256_unpackhi_epi8(r, g) : _mm256_unpacklo_epi8(r, g);
+            const __m256i ba = half ? _mm256_unpackhi_epi8(b, a) : _mm256_unpacklo_epi8(b, a);
+            const __m256i p0 = _mm256_unpacklo_epi16(rg, ba);
+            const __m256i p1 = _mm256_unpackhi_epi16(rg, ba);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + half * 64),
+                                _mm256_permute2x128_si256(p0, p1, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + half * 64 + 32),
+                                _mm256_permute2x128_si256(p0, p1, 0x31));
+        }
+    }
+    return x;
+}
+
+bool cpuHasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+
+#endif
+
+#if defined(CINEFORGE_YUV_NEON)
+
+// Sixteen pixels per iteration; vld2 splits interleaved chroma and vst4
+// interleaves the output.
+int rowNeon(const Row& row, int width, const Coeffs& k) {
+    const int16x8_t yOff = vdupq_n_s16(static_cast<int16_t>(k.yOff));
+    const int16x8_t yScale = vdupq_n_s16(static_cast<int16_t>(k.yScale));
+    const int16x8_t bias = vdupq_n_s16(32);
+    const int16x8_t mid = vdupq_n_s16(128);
+    const int16x8_t vr = vdupq_n_s16(static_cast<int16_t>(k.vr));
+    const int16x8_t ug = vdupq_n_s16(static_cast<int16_t>(k.ug));
+    const int16x8_t vg = vdupq_n_s16(static_cast<int16_t>(k.vg));
+    const int16x8_t ub = vdupq_n_s16(static_cast<int16_t>(k.ub));
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16_t y = vld1q_u8(row.y + x);
+        uint8x8_t u, v;
+        if (row.cstep == 2) {
+            const uint8x8x2_t uv = vld2_u8(std::min(row.u, row.v) + x);
+            u = row.u < row.v ? uv.val[0] : uv.val[1];
+            v = row.u < row.v ? uv.val[1] : uv.val[0];
+        } else {
+            u = vld1_u8(row.u + x / 2);
+            v = vld1_u8(row.v + x / 2);
+        }
+        const uint8x8x2_t ud = vzip_u8(u, u);
+        const uint8x8x2_t vd = vzip_u8(v, v);
+
+        int16x8_t rgb[3][2];
+        for (int h = 0; h < 2; ++h) {
+            const int16x8_t y16 =
+                vreinterpretq_s16_u16(vmovl_u8(h ? vget_high_u8(y) : vget_low_u8(y)));
+            const int16x8_t u16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(ud.val[h])), mid);
+            const int16x8_t v16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vd.val[h])), mid);
+            const int16x8_t yc = vaddq_s16(vmulq_s16(vsubq_s16(y16, yOff), yScale), bias);
+            rgb[0][h] = vshrq_n_s16(vqaddq_s16(yc, vmulq_s16(v16, vr)), 6);
+            rgb[1][h] = vshrq_n_s16(
+                vqsubq_s16(vqsubq_s16(yc, vmulq_s16(u16, ug)), vmulq_s16(v16, vg)), 6);
+            rgb[2][h] = vshrq_n_s16(vqaddq_s16(yc, vmulq_s16(u16, ub)), 6);
+        }
+        uint8x16x4_t out;
+        for (int c = 0; c < 3; ++c) {
+            out.val[c] = vcombine_u8(vqmovun_s16(rgb[c][0]), vqmovun_s16(rgb[c][1]));
+        }
+        out.val[3] = vdupq_n_u8(255);
+        vst4q_u8(row.dst + static_cast<std::size_t>(x) * 4, out);
+    }
+    return x;
+}
+
+#endif
+
+using RowFn = int (*)(const Row&, int, const Coeffs&);
+
+RowFn rowKernel(YuvKernel kernel) {
+    switch (kernel) {
+#if defined(CINEFORGE_YUV_SSE2)
+    case YuvKernel::Sse2: return rowSse2;
+#endif
+#if defined(CINEFORGE_YUV_AVX2)
+    case YuvKernel::Avx2: return cpuHasAvx2() ? rowAvx2 : nullptr;
+#endif
+#if defined(CINEFORGE_YUV_NEON)
+    case YuvKernel::Neon: return rowNeon;
+#endif
+    case YuvKernel::Scalar:
+        return [](const Row&, int, const Coeffs&) { return 0; };
+    default: return nullptr;
+    }
+}
+
+RowFn bestKernel() {
+    for (YuvKernel k : {YuvKernel::Avx2, YuvKernel::Sse2, YuvKernel::Neon}) {
+        if (RowFn fn = rowKernel(k)) {
+            return fn;
+        }
+    }
+    return rowKernel(YuvKernel::Scalar);
+}
+
+} // namespace
+
+bool yuvKernelAvailable(YuvKernel kernel) {
+    return kernel == YuvKernel::Auto || rowKernel(kernel) != nullptr;
+}
+
+void yuvToRgba(const YuvImage& src, YuvMatrix matrix, YuvRange range, Frame& output,
+               int y0, int y1, YuvKernel kernel) {
+    const bool planar = src.layout == YuvLayout::I420;
+    if (!src.y || !src.u || (planar && !src.v) || !output.cpuData ||
+        output.format != PixelFormat::RGBA8) {
+        return;
+    }
+    RowFn simd = kernel == YuvKernel::Auto ? nullptr : rowKernel(kernel);
+    if (!simd) {
+        static const RowFn best = bestKernel();
+        simd = best;
+    }
+    const Coeffs k = makeCoeffs(matrix, range);
+    const int width = std::min(src.width, output.width);
+    y0 = std::max(y0, 0);
+    y1 = std::min({y1, src.height, output.height});
+    for (int y = y0; y < y1; ++y) {
+        const std::uint8_t* chroma = src.u + static_cast<std::size_t>(y / 2) * src.uvStride;
+        Row row;
+        row.y = src.y + static_cast<std::size_t>(y) * src.yStride;
+        row.dst = output.cpuData + static_cast<std::size_t>(y) * output.cpuStride;
+        if (planar) {
+            row.u = chroma;
+            row.v = src.v + static_cast<std::size_t>(y / 2) * src.uvStride;
+            row.cstep = 1;
+        } else {
+            const bool nv21 = src.layout == YuvLayout::NV21;
+            row.u = nv21 ? chroma + 1 : chroma;
+            row.v = nv21 ? chroma : chroma + 1;
+            row.cstep = 2;
+        }
+        const int done = simd(row, width, k);
+        rowScalar(row, done, width, k);
+    }
+}
+
+} // namespace cineforge::render
@@ -0,0 +1,59 @@
+#include "cineforge/timeline/IntervalIndex.h"
+
+#include <algorithm>
+
+#include "cineforge/timeline/Timeline.h"
+
+namespace cineforge::timeline {
+
+void IntervalIndex::build(const std::vector<Clip>& clips) {
+    const std::size_t n = clips.size();
+    starts_.resize(n);
+    ends_.resize(n);
+    maxEnds_.resize(n);
+    rootLevel_ = -1;
+    if (n == 0) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        starts_[i] = clips[i].start;
+        ends_[i] = clips[i].end;
+    }
+
+    // Leaves sit at even positions; node i at level k has its children at
+    // i -/+ 2^(k-1). `last` tracks the max end of the right‑most, possibly
+    // incomplete, subtree so that missing right children are accounted for.
+    std::size_t lastI = 0;
+    double last = 0.0;
+    for (std::size_t i = 0; i < n; i += 2) {
+        lastI = i;
+        last = maxEnds_[i] = ends_[i];
+    }
+
+    int k = 1;
+    for (; (std::size_t{1} << k) <= n; ++k) {
+        const std::size_t x = std::size_t{1} << (k - 1);
+        const std::size_t i0 = (x << 1) - 1;
+        const std::size_t step = x << 2;
+        for (std::size_t i = i0; i < n; i += step) {
+            const double el = maxEnds_[i - x];
+            const double er = (i + x < n) ? maxEnds_[i + x] : last;
+            maxEnds_[i] = std::max({ends_[i], el, er});
+        }
+        lastI = ((lastI >> k) & 1) ? lastI - x : lastI + x;
+        if (lastI < n && maxEnds_[lastI] > last) {
+            last = maxEnds_[lastI];
+        }
+    }
+    rootLevel_ = k - 1;
+}
+
+void IntervalIndex::clear() {
+    starts_.clear();
+    ends_.clear();
+    maxEnds_.clear();
+    rootLevel_ = -1;
+}
+
+} // namespace cineforge::timeline
@@ -1,44 +1,263 @@
 #include "cineforge/timeline/Keyframe.h"
 
 #include <algorithm>
+#include <cmath>
 
 namespace cineforge::timeline {
 
-double KeyframeCurve::evaluate(double time) const {
-    if (keys.empty()) {
-        return 0.0;
+namespace {
+
+struct EaseCurve {
+    double x1, y1, x2, y2;
+};
+
+// CSS timing-function control points for the preset eases.
+constexpr EaseCurve kEaseIn{0.42, 0.0, 1.0, 1.0};
+constexpr EaseCurve kEaseOut{0.0, 0.0, 0.58, 1.0};
+constexpr EaseCurve kEaseInOut{0.42, 0.0, 0.58, 1.0};
+
+constexpr int kNewtonIterations = 4;
+constexpr int kBisectionIterations = 20;
+constexpr double kSolveEpsilon = 1e-7;
+constexpr double kMinSlope = 1e-6;
+
+bool keyBefore(const Keyframe& a, const Keyframe& b) { return a.time < b.time; }
+
+} // namespace
+
+void KeyframeCurve::setKeys(std::vector<Keyframe> keys) {
+    keys_ = std::move(keys);
+    if (!std::is_sorted(keys_.begin(), keys_.end(), keyBefore)) {
+        std::stable_sort(keys_.begin(), keys_.end(), keyBefore);
     }
-    if (time <= keys.front().time) {
-        return keys.front().value;
+    rebuildSegments();
+}
+
+void KeyframeCurve::addKey(const Keyframe& key) {
+    auto it = std::upper_bound(keys_.begin(), keys_.end(), key, keyBefore);
+    keys_.insert(it, key);
+    rebuildSegments();
+}
+
+void KeyframeCurve::clearKeys() {
+    keys_.clear();
+    segments_.clear();
+    sampleValues_.clear();
+    sampleHeld_.clear();
+}
+
+bool KeyframeCurve::bake(double sampleRate) {
+    sampleRate_ = sampleRate > 0.0 ? sampleRate : 0.0;
+    rebake();
+    return sampleRate_ == 0.0 || isBaked();
+}
+
+void KeyframeCurve::rebake() {
+    sampleValues_.clear();
+    sampleHeld_.clear();
+    if (sampleRate_ <= 0.0 || keys_.empty()) {
+        return;
     }
-    if (time >= keys.back().time) {
-        return keys.back().value;
+
+    // Align the grid to absolute multiples of the sample period so that
+    // frame times hit samples exactly.
+    const double first = std::floor(keys_.front().time * sampleRate_);
+    const double last = std::ceil(keys_.back().time * sampleRate_);
+    const double count = last - first + 1.0;
+    if (!(count <= static_cast<double>(kMaxSamples))) {
+        return;
     }
 
-    auto it = std::upper_bound(
-        keys.begin(), keys.end(), time,
-        [](double t, const Keyframe& k) { return t < k.time; });
+    sampleOrigin_ = first;
+    sampleValues_.resize(static_cast<std::size_t>(count));
+    for (std::size_t i = 0; i < sampleValues_.size(); ++i) {
+        sampleValues_[i] =
+            evaluateKeys((first + static_cast<double>(i)) / sampleRate_);
+    }
+
+    // Interpolating out of a Hold segment would turn its step into a ramp
+    // one sample long, so samples taken inside one are flagged and held.
+    const bool hasHold =
+        std::any_of(segments_.begin(), segments_.end(),
+                    [](const Segment& s) { return s.interp == InterpolationType::Hold; });
+    if (!hasHold) {
+        return;
+    }
+    sampleHeld_.assign(sampleValues_.size(), 0);
+    std::size_t seg = 0;
+    for (std::size_t i = 0; i < sampleValues_.size(); ++i) {
+        const double time = (first + static_cast<double>(i)) / sampleRate_;
+        while (seg + 1 < keys_.size() && keys_[seg + 1].time <= time) {
+            ++seg;
+        }
+        sampleHeld_[i] = seg < segments_.size() && keys_[seg].time <= time &&
+                         segments_[seg].interp == InterpolationType::Hold;
+    }
+}
+
+void KeyframeCurve::rebuildSegments() {
+    segments_.clear();
+    if (keys_.size() < 2) {
+        rebake();
+        return;
+    }
+    segments_.resize(keys_.size() - 1);
+
+    for (std::size_t i = 0; i + 1 < keys_.size(); ++i) {
+        const Keyframe& k1 = keys_[i];
+        const Keyframe& k2 = keys_[i + 1];
+        Segment& seg = segments_[i];
 
-    const Keyframe& k1 = *(it - 1);
-    const Keyframe& k2 = *it;
+        const double dt = k2.time - k1.time;
+        const double dv = k2.value - k1.value;
+        seg.interp = k1.interp;
+        seg.invDuration = dt > 0.0 ? 1.0 / dt : 0.0;
 
-    double dt = k2.time - k1.time;
-    double localT = (dt > 0.0) ? (time - k1.time) / dt : 0.0;
+        // Normalized control points (x1, x2) and value control points
+        // (y1, y2) of the segment's cubic.
+        double x1 = 0.0, x2 = 1.0;
+        double y1 = k1.value, y2 = k2.value;
+        switch (k1.interp) {
+        case InterpolationType::Hold:
+        case InterpolationType::Linear:
+            continue;
+        case InterpolationType::Bezier: {
+            const BezierHandles out = k1.bezier.value_or(
+                BezierHandles{0.0f, 0.0f, static_cast<float>(dt / 3.0), 0.0f});
+            const BezierHandles in = k2.bezier.value_or(
+                BezierHandles{static_cast<float>(-dt / 3.0), 0.0f, 0.0f, 0.0f});
+            // Handles are clamped into the segment so that x(s) stays
+            // monotonic and every time maps to exactly one value.
+            x1 = std::clamp(out.outX * seg.invDuration, 0.0, 1.0);
+            x2 = std::clamp(1.0 + in.inX * seg.invDuration, 0.0, 1.0);
+            y1 = k1.value + out.outY;
+            y2 = k2.value + in.inY;
+            break;
+        }
+        case InterpolationType::EaseIn:
+        case InterpolationType::EaseOut:
+        case InterpolationType::EaseInOut: {
+            const EaseCurve& e = k1.interp == InterpolationType::EaseIn  ? kEaseIn
+                               : k1.interp == InterpolationType::EaseOut ? kEaseOut
+                                                                          : kEaseInOut;
+            x1 = e.x1;
+            x2 = e.x2;
+            y1 = k1.value + e.y1 * dv;
+            y2 = k1.value + e.y2 * dv;
+            break;
+        }
+        }
 
-    switch (k1.interp) {
+        seg.cx = 3.0 * x1;
+        seg.bx = 3.0 * (x2 - x1) - seg.cx;
+        seg.ax = 1.0 - seg.cx - seg.bx;
+
+        seg.dy = k1.value;
+        seg.cy = 3.0 * (y1 - k1.value);
+        seg.by = 3.0 * (y2 - y1) - seg.cy;
+        seg.ay = k2.value - k1.value - seg.cy - seg.by;
+
+        for (int j = 0; j < kSplineSamples; ++j) {
+            const double s = static_cast<double>(j) / (kSplineSamples - 1);
+            seg.xSamples[j] = ((seg.ax * s + seg.bx) * s + seg.cx) * s;
+        }
+    }
+    rebake();
+}
+
+double KeyframeCurve::evaluateSegment(std::size_t i, double time) const {
+    const Keyframe& k1 = keys_[i];
+    const Segment& seg = segments_[i];
+    const double x = (time - k1.time) * seg.invDuration;
+
+    switch (seg.interp) {
     case InterpolationType::Hold:
         return k1.value;
     case InterpolationType::Linear:
-        return k1.value + (k2.value - k1.value) * localT;
-    case InterpolationType::Bezier:
-    case InterpolationType::EaseIn:
-    case InterpolationType::EaseOut:
-    case InterpolationType::EaseInOut:
+        return k1.value + (keys_[i + 1].value - k1.value) * x;
     default:
-        // For now, fall back to linear; proper bezier evaluation can be added later.
-        return k1.value + (k2.value - k1.value) * localT;
+        break;
+    }
+
+    // Seed s from the precomputed samples of x(s), refine with a few Newton
+    // steps and fall back to a fixed number of bisection steps when the
+    // curve is too flat for Newton to converge.
+    int j = 0;
+    while (j < kSplineSamples - 2 && seg.xSamples[j + 1] <= x) {
+        ++j;
+    }
+    const double step = 1.0 / (kSplineSamples - 1);
+    const double lo = j * step;
+    const double span = seg.xSamples[j + 1] - seg.xSamples[j];
+    double s = lo + (span > 0.0 ? (x - seg.xSamples[j]) / span : 0.0) * step;
+
+    bool solved = false;
+    for (int it = 0; it < kNewtonIterations; ++it) {
+        const double err = ((seg.ax * s + seg.bx) * s + seg.cx) * s - x;
+        if (std::abs(err) < kSolveEpsilon) {
+            solved = true;
+            break;
+        }
+        const double slope = (3.0 * seg.ax * s + 2.0 * seg.bx) * s + seg.cx;
+        if (std::abs(slope) < kMinSlope) {
+            break;
+        }
+        s -= err / slope;
+    }
+    if (!solved) {
+        double a = lo;
+        double b = lo + step;
+        for (int it = 0; it < kBisectionIterations; ++it) {
+            s = 0.5 * (a + b);
+            if (((seg.ax * s + seg.bx) * s + seg.cx) * s < x) {
+                a = s;
+            } else {
+                b = s;
+            }
+        }
+        s = 0.5 * (a + b);
     }
+
+    return ((seg.ay * s + seg.by) * s + seg.cy) * s + seg.dy;
 }
 
-} // namespace cineforge::timeline
+double KeyframeCurve::evaluate(double time) const {
+    if (!sampleValues_.empty()) {
+        const double pos = time * sampleRate_ - sampleOrigin_;
+        if (pos <= 0.0) {
+            return sampleValues_.front();
+        }
+        const double lastIndex = static_cast<double>(sampleValues_.size() - 1);
+        if (pos >= lastIndex) {
+            return sampleValues_.back();
+        }
+        const auto i = static_cast<std::size_t>(pos);
+        if (!sampleHeld_.empty() && sampleHeld_[i]) {
+            return sampleValues_[i];
+        }
+        const double frac = pos - static_cast<double>(i);
+        return sampleValues_[i] + (sampleValues_[i + 1] - sampleValues_[i]) * frac;
+    }
+    return evaluateKeys(time);
+}
+
+double KeyframeCurve::evaluateKeys(double time) const {
+    if (keys_.empty()) {
+        return 0.0;
+    }
+    if (time <= keys_.front().time) {
+        return keys_.front().value;
+    }
+    if (time >= keys_.back().time) {
+        return keys_.back().value;
+    }
 
+    auto it = std::upper_bound(
+        keys_.begin(), keys_.end(), time,
+        [](double t, const Keyframe& k) { return t < k.time; });
+
+    return evaluateSegment(static_cast<std::size_t>(it - keys_.begin()) - 1,
+                           time);
+}
+
+} // namespace cineforge::timeline
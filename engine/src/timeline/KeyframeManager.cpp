@@ -1,24 +1,223 @@
 #include "cineforge/timeline/KeyframeManager.h"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
 namespace cineforge::timeline {
 
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+// Range of time whose evaluated value can differ between two versions of
+// a curve. Curves hold their end values forever, so a change to either end
+// value reaches all the way to -inf / +inf.
+void changedRange(const KeyframeCurve* before, const KeyframeCurve* after,
+                  double& t0, double& t1) {
+    if (!before || !after || before->keys().empty() || after->keys().empty()) {
+        t0 = -kInf;
+        t1 = kInf;
+        return;
+    }
+    const Keyframe& b0 = before->keys().front();
+    const Keyframe& b1 = before->keys().back();
+    const Keyframe& a0 = after->keys().front();
+    const Keyframe& a1 = after->keys().back();
+    t0 = b0.value == a0.value ? std::min(b0.time, a0.time) : -kInf;
+    t1 = b1.value == a1.value ? std::max(b1.time, a1.time) : kInf;
+}
+
+} // namespace
+
+std::uint64_t KeyframeManager::newLayout() {
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
 void KeyframeManager::registerCurve(const KeyframeCurve& curve) {
-    curves_[curve.id] = curve;
+    auto [it, inserted] =
+        slots_.emplace(curve.id, static_cast<std::uint32_t>(curves_.size()));
+    double t0 = 0.0, t1 = 0.0;
+    if (inserted) {
+        changedRange(nullptr, &curve, t0, t1);
+        curves_.push_back(curve);
+        layout_ = newLayout();
+    } else {
+        changedRange(&curves_[it->second], &curve, t0, t1);
+        curves_[it->second] = curve;
+    }
+    changes_.markDirty(t0, t1);
+
+    KeyframeCurve& stored = curves_[it->second];
+    if (stored.sampleRate() != sampleRate_) {
+        stored.bake(sampleRate_);
+    }
+    batchDirty_ = true;
+    if (listener_) {
+        CurveEdit edit;
+        edit.kind = CurveEdit::Kind::Set;
+        edit.id = stored.id;
+        edit.curve = &stored;
+        listener_(edit);
+    }
+}
+
+void KeyframeManager::removeCurve(Symbol id) {
+    auto it = slots_.find(id);
+    if (it == slots_.end()) {
+        return;
+    }
+
+    const std::uint32_t slot = it->second;
+    slots_.erase(it);
+    changes_.markAllDirty();
+    if (slot + 1 != curves_.size()) {
+        curves_[slot] = std::move(curves_.back());
+        slots_[curves_[slot].id] = slot;
+    }
+    curves_.pop_back();
+    layout_ = newLayout();
+    batchDirty_ = true;
+    if (listener_) {
+        CurveEdit edit;
+        edit.kind = CurveEdit::Kind::Remove;
+        edit.id = id;
+        listener_(edit);
+    }
 }
 
-void KeyframeManager::removeCurve(const std::string& id) {
-    curves_.erase(id);
+void KeyframeManager::clear() {
+    curves_.clear();
+    slots_.clear();
+    changes_.markAllDirty();
+    layout_ = newLayout();
+    batchDirty_ = true;
+    if (listener_) {
+        CurveEdit edit;
+        edit.kind = CurveEdit::Kind::Clear;
+        listener_(edit);
+    }
 }
 
-const KeyframeCurve* KeyframeManager::getCurve(const std::string& id) const {
-    auto it = curves_.find(id);
-    return it == curves_.end() ? nullptr : &it->second;
+const KeyframeCurve* KeyframeManager::getCurve(Symbol id) const {
+    auto it = slots_.find(id);
+    return it == slots_.end() ? nullptr : &curves_[it->second];
 }
 
-double KeyframeManager::eval(const std::string& id, double time) const {
+double KeyframeManager::eval(Symbol id, double time) const {
     auto* c = getCurve(id);
     return c ? c->evaluate(time) : 0.0;
 }
 
-} // namespace cineforge::timeline an dthis thing
+void KeyframeManager::setSampleRate(double sampleRate) {
+    sampleRate = sampleRate > 0.0 ? sampleRate : 0.0;
+    if (sampleRate == sampleRate_) {
+        return;
+    }
+    sampleRate_ = sampleRate;
+    for (auto& curve : curves_) {
+        curve.bake(sampleRate_);
+    }
+    changes_.markAllDirty();
+    batchDirty_ = true;
+}
+
+const KeyframeManager::BatchTable& KeyframeManager::batchTable() const {
+    if (!batchDirty_) {
+        return batch_;
+    }
+
+    const std::size_t n = curves_.size();
+    batch_.rate.assign(n, 0.0);
+    batch_.origin.assign(n, 0.0);
+    batch_.maxPos.assign(n, 0.0);
+    batch_.samples.assign(n, nullptr);
+    batch_.held.assign(n, nullptr);
+    batch_.sampled.assign(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& samples = curves_[i].samples();
+        // Single-sample caches have no interval to lerp over; they are
+        // cheap enough on the scalar path.
+        if (samples.size() >= 2) {
+            batch_.rate[i] = curves_[i].sampleRate();
+            batch_.origin[i] = curves_[i].sampleOrigin();
+            batch_.maxPos[i] = static_cast<double>(samples.size() - 1);
+            batch_.samples[i] = samples.data();
+            if (!curves_[i].heldSamples().empty()) {
+                batch_.held[i] = curves_[i].heldSamples().data();
+            }
+            batch_.sampled[i] = 1;
+        }
+    }
+    batchDirty_ = false;
+    return batch_;
+}
+
+// `pos` is the clamped sample position computed by the caller.
+double KeyframeManager::evalSlot(std::uint32_t slot, double pos) const {
+    if (!batch_.sampled[slot]) {
+        return 0.0;
+    }
+    const double* d = batch_.samples[slot];
+    const double lastInterval = batch_.maxPos[slot] - 1.0;
+    const double base = std::min(static_cast<double>(static_cast<std::size_t>(pos)),
+                                 lastInterval);
+    const auto i = static_cast<std::size_t>(base);
+    const double frac = pos - base;
+    const std::uint8_t* held = batch_.held[slot];
+    if (held && held[i] && frac < 1.0) {
+        return d[i];
+    }
+    return d[i] + (d[i + 1] - d[i]) * frac;
+}
+
+void KeyframeManager::evalAll(double time, double* out) const {
+    const BatchTable& t = batchTable();
+    const std::size_t n = curves_.size();
+    const double* rate = t.rate.data();
+    const double* origin = t.origin.data();
+    const double* maxPos = t.maxPos.data();
+
+    // Pass 1: sample positions for every slot. Pure arithmetic over the
+    // SoA columns, so the compiler vectorizes it; `out` doubles as
+    // scratch to avoid a temporary.
+    for (std::size_t i = 0; i < n; ++i) {
+        const double pos = time * rate[i] - origin[i];
+        out[i] = std::clamp(pos, 0.0, maxPos[i]);
+    }
+
+    // Pass 2: gather + lerp, with the scalar path for unbaked curves.
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = t.sampled[i] ? evalSlot(static_cast<std::uint32_t>(i), out[i])
+                              : curves_[i].evaluate(time);
+    }
+}
+
+void KeyframeManager::evalSet(const EvalSet& set, double time,
+                              double* out) const {
+    if (set.layout_ != layout_) {
+        set.slots_.resize(set.ids_.size());
+        for (std::size_t i = 0; i < set.ids_.size(); ++i) {
+            auto it = slots_.find(set.ids_[i]);
+            set.slots_[i] = it == slots_.end() ? kNoSlot : it->second;
+        }
+        set.layout_ = layout_;
+    }
+
+    const BatchTable& t = batchTable();
+    const std::size_t n = set.slots_.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t slot = set.slots_[i];
+        if (slot == kNoSlot) {
+            out[i] = 0.0;
+        } else if (t.sampled[slot]) {
+            const double pos = time * t.rate[slot] - t.origin[slot];
+            out[i] = evalSlot(slot, std::clamp(pos, 0.0, t.maxPos[slot]));
+        } else {
+            out[i] = curves_[slot].evaluate(time);
+        }
+    }
+}
 
+} // namespace cineforge::timeline
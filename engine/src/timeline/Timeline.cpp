@@ -1,60 +1,261 @@
 #include "cineforge/timeline/Timeline.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace cineforge::timeline {
 
-void Timeline::addTrack(const Track &track) { tracks_.push_back(track); }
-
-void Timeline::addClip(const std::string &trackId, const Clip &clip) {
-  for (auto &t : tracks_) {
-    if (t.id == trackId) {
-      // Basic check: don't allow duplicate clip IDs
-      for (const auto &c : t.clips) {
-        if (c.id == clip.id)
-          return;
-      }
-      t.clips.push_back(clip);
-      return;
-    }
+namespace {
+
+bool startsBefore(const Clip &a, const Clip &b) { return a.start < b.start; }
+
+// Position at which a clip starting at `start` keeps `clips` sorted; ties
+// go after existing clips so insertion order is preserved.
+std::size_t insertionPoint(const std::vector<Clip> &clips, double start) {
+  auto it = std::upper_bound(
+      clips.begin(), clips.end(), start,
+      [](double t, const Clip &c) { return t < c.start; });
+  return static_cast<std::size_t>(it - clips.begin());
+}
+
+} // namespace
+
+void Timeline::addTrack(const Track &track) {
+  const auto ti = static_cast<std::uint32_t>(tracks_.size());
+  if (!trackById_.emplace(track.id, ti).second)
+    return;
+
+  tracks_.push_back(track);
+  index_.emplace_back();
+
+  // Drop clips whose ids are already taken, matching addClip().
+  auto &clips = tracks_.back().clips;
+  clips.erase(std::remove_if(clips.begin(), clips.end(),
+                             [this](const Clip &c) {
+                               return !clipById_.emplace(c.id, ClipLocation{})
+                                           .second;
+                             }),
+              clips.end());
+  if (!std::is_sorted(clips.begin(), clips.end(), startsBefore)) {
+    std::stable_sort(clips.begin(), clips.end(), startsBefore);
+  }
+  if (clips.empty()) {
+    changes_.markDirty(0.0, 0.0);
+  } else {
+    relocate(ti, 0, clips.size() - 1);
+
+    double hi = clips.front().end;
+    for (const auto &c : clips)
+      hi = std::max(hi, c.end);
+    changes_.markDirty(clips.front().start, hi);
+  }
+  TimelineEdit edit;
+  edit.kind = TimelineEdit::Kind::AddTrack;
+  edit.target = track.id;
+  edit.track = &tracks_.back();
+  notify(edit);
+}
+
+void Timeline::addClip(Symbol trackId, const Clip &clip) {
+  auto track = trackById_.find(trackId);
+  if (track == trackById_.end() || clipById_.count(clip.id))
+    return;
+  insertClip(track->second, clip);
+  changes_.markDirty(clip.start, clip.end);
+  TimelineEdit edit;
+  edit.kind = TimelineEdit::Kind::AddClip;
+  edit.target = trackId;
+  edit.clip = &clip;
+  notify(edit);
+}
+
+void Timeline::clear() {
+  tracks_.clear();
+  index_.clear();
+  trackById_.clear();
+  clipById_.clear();
+  changes_.markAllDirty();
+  TimelineEdit edit;
+  edit.kind = TimelineEdit::Kind::Clear;
+  notify(edit);
+}
+
+const Track *Timeline::findTrack(Symbol trackId) const {
+  auto it = trackById_.find(trackId);
+  return it == trackById_.end() ? nullptr : &tracks_[it->second];
+}
+
+const Clip *Timeline::findClip(Symbol clipId) const {
+  const auto *loc = locate(clipId);
+  return loc ? &tracks_[loc->track].clips[loc->index] : nullptr;
+}
+
+void Timeline::splitClip(Symbol clipId, double time) {
+  const auto *loc = locate(clipId);
+  if (!loc)
+    return;
+
+  const std::size_t ti = loc->track;
+  auto &c = tracks_[ti].clips[loc->index];
+  if (time <= c.start || time >= c.end)
+    return;
+
+  double mid = time;
+  Clip second = c;
+  second.id = intern(nameOf(c.id) + "_b");
+  if (clipById_.count(second.id))
+    return;
+  second.start = mid;
+  second.inPoint = c.inPoint + (mid - c.start);
+
+  const double start = c.start;
+  const double end = c.end;
+  c.end = mid;
+  // c.outPoint should also be updated if it exists in the struct
+  // In Timeline.h, we have inPoint and outPoint.
+  c.outPoint = c.inPoint + (mid - c.start);
+
+  insertClip(ti, std::move(second));
+  changes_.markDirty(start, end);
+  TimelineEdit edit;
+  edit.kind = TimelineEdit::Kind::SplitClip;
+  edit.target = clipId;
+  edit.time = time;
+  notify(edit);
+}
+
+void Timeline::moveClip(Symbol clipId, double newStart) {
+  const auto *loc = locate(clipId);
+  if (!loc)
+    return;
+
+  const std::size_t ti = loc->track;
+  const std::size_t i = loc->index;
+  auto &clips = tracks_[ti].clips;
+  auto &c = clips[i];
+  double duration = c.end - c.start;
+  changes_.markDirty(c.start, c.end);
+  c.start = newStart;
+  c.end = newStart + duration;
+  changes_.markDirty(c.start, c.end);
+
+  // Rotate the clip into its new sorted slot instead of erasing and
+  // re‑inserting, which would shift the tail twice.
+  const auto first = clips.begin();
+  const auto at = first + static_cast<long>(i);
+  auto dest = std::upper_bound(
+      first, at, newStart,
+      [](double t, const Clip &other) { return t < other.start; });
+  std::size_t to = i;
+  if (dest != at) {
+    std::rotate(dest, at, at + 1);
+    to = static_cast<std::size_t>(dest - first);
+  } else {
+    dest = std::upper_bound(
+        at + 1, clips.end(), newStart,
+        [](double t, const Clip &other) { return t < other.start; });
+    std::rotate(at, at + 1, dest);
+    to = static_cast<std::size_t>(dest - first) - 1;
+  }
+  relocate(ti, i, to);
+  index_[ti].dirty = true;
+  TimelineEdit edit;
+  edit.kind = TimelineEdit::Kind::MoveClip;
+  edit.target = clipId;
+  edit.time = newStart;
+  notify(edit);
+}
+
+void Timeline::removeClip(Symbol clipId) {
+  auto it = clipById_.find(clipId);
+  if (it == clipById_.end())
+    return;
+
+  const std::size_t ti = it->second.track;
+  const std::size_t i = it->second.index;
+  clipById_.erase(it);
+
+  auto &clips = tracks_[ti].clips;
+  changes_.markDirty(clips[i].start, clips[i].end);
+  clips.erase(clips.begin() + static_cast<long>(i));
+  if (i < clips.size())
+    relocate(ti, i, clips.size() - 1);
+  index_[ti].dirty = true;
+  TimelineEdit edit;
+  edit.kind = TimelineEdit::Kind::RemoveClip;
+  edit.target = clipId;
+  notify(edit);
+}
+
+const Timeline::ClipLocation *Timeline::locate(Symbol clipId) const {
+  auto it = clipById_.find(clipId);
+  return it == clipById_.end() ? nullptr : &it->second;
+}
+
+void Timeline::insertClip(std::size_t track, Clip clip) {
+  auto &clips = tracks_[track].clips;
+  const std::size_t pos = insertionPoint(clips, clip.start);
+  clipById_.emplace(clip.id, ClipLocation{});
+  clips.insert(clips.begin() + static_cast<long>(pos), std::move(clip));
+  relocate(track, pos, clips.size() - 1);
+  index_[track].dirty = true;
+}
+
+// Rewrites the stored positions of the clips between `from` and `to`
+// (inclusive, in either order) after they have shifted within `track`.
+void Timeline::relocate(std::size_t track, std::size_t from, std::size_t to) {
+  const auto &clips = tracks_[track].clips;
+  const std::size_t lo = std::min(from, to);
+  const std::size_t hi = std::max(from, to);
+  for (std::size_t i = lo; i <= hi; ++i) {
+    clipById_[clips[i].id] = {static_cast<std::uint32_t>(track),
+                              static_cast<std::uint32_t>(i)};
   }
 }
 
-void Timeline::splitClip(const std::string &clipId, double time) {
-  for (auto &t : tracks_) {
-    for (std::size_t i = 0; i < t.clips.size(); ++i) {
-      auto &c = t.clips[i];
-      if (c.id == clipId) {
-        if (time <= c.start || time >= c.end)
-          return;
-
-        double mid = time;
-        Clip second = c;
-        second.id = c.id + "_b";
-        second.start = mid;
-        second.inPoint = c.inPoint + (mid - c.start);
-
-        c.end = mid;
-        // c.outPoint should also be updated if it exists in the struct
-        // In Timeline.h, we have inPoint and outPoint.
-        c.outPoint = c.inPoint + (mid - c.start);
-
-        t.clips.insert(t.clips.begin() + static_cast<long>(i + 1), second);
-        return;
-      }
-    }
+const IntervalIndex &Timeline::intervalsFor(std::size_t track) const {
+  auto &idx = index_[track];
+  if (idx.dirty) {
+    idx.intervals.build(tracks_[track].clips);
+    idx.dirty = false;
   }
+  return idx.intervals;
 }
 
-void Timeline::moveClip(const std::string &clipId, double newStart) {
-  for (auto &t : tracks_) {
-    for (auto &c : t.clips) {
-      if (c.id == clipId) {
-        double duration = c.end - c.start;
-        c.start = newStart;
-        c.end = newStart + duration;
-        return;
-      }
-    }
+void Timeline::collect(double lo, double hi,
+                       std::vector<const Clip *> &out) const {
+  for (std::size_t ti = 0; ti < tracks_.size(); ++ti) {
+    const auto &clips = tracks_[ti].clips;
+    intervalsFor(ti).forEachOverlap(
+        lo, hi, [&](std::size_t i) { out.push_back(&clips[i]); });
   }
 }
 
+void Timeline::clipsAt(double time, std::vector<const Clip *> &out) const {
+  // start <= time is start < nextafter(time), which lets point queries share
+  // the half‑open range walk.
+  collect(time, std::nextafter(time, std::numeric_limits<double>::infinity()),
+          out);
+}
+
+std::vector<const Clip *> Timeline::clipsAt(double time) const {
+  std::vector<const Clip *> out;
+  clipsAt(time, out);
+  return out;
+}
+
+void Timeline::clipsInRange(double t0, double t1,
+                            std::vector<const Clip *> &out) const {
+  if (t1 <= t0)
+    return;
+  collect(t0, t1, out);
+}
+
+std::vector<const Clip *> Timeline::clipsInRange(double t0, double t1) const {
+  std::vector<const Clip *> out;
+  clipsInRange(t0, t1, out);
+  return out;
+}
+
 } // namespace cineforge::timeline
@@ -0,0 +1,121 @@
+// Binary project format: save and load give back exactly the project that
+// was saved, and truncated or corrupted files are rejected rather than
+// read out of bounds.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ProjectTestSupport.h"
+#include "TestSupport.h"
+#include "cineforge/io/BinaryProject.h"
+
+using namespace cineforge;
+
+namespace {
+
+// Layout offsets from BinaryProject.cpp.
+constexpr std::size_t kVersionOffset = 8;
+constexpr std::size_t kSectionCountOffset = 16;
+constexpr std::size_t kDirectoryOffset = 32;
+constexpr std::size_t kEntrySize = 24;
+constexpr std::uint32_t kStringsId = 1;
+constexpr std::uint32_t kClipsId = 4;
+
+template <typename T>
+T read(const std::vector<std::uint8_t>& bytes, std::size_t at) {
+    T v;
+    std::memcpy(&v, bytes.data() + at, sizeof(v));
+    return v;
+}
+
+template <typename T>
+std::vector<std::uint8_t> patched(std::vector<std::uint8_t> bytes, std::size_t at, T v) {
+    std::memcpy(bytes.data() + at, &v, sizeof(v));
+    return bytes;
+}
+
+// Directory entry of section `id`: {id, record size, offset, count}.
+std::size_t entryOf(const std::vector<std::uint8_t>& bytes, std::uint32_t id) {
+    const auto count = read<std::uint32_t>(bytes, kSectionCountOffset);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const std::size_t at = kDirectoryOffset + i * kEntrySize;
+        if (read<std::uint32_t>(bytes, at) == id) {
+            return at;
+        }
+    }
+    return 0;
+}
+
+bool decodes(const std::vector<std::uint8_t>& bytes) {
+    io::ProjectData out;
+    return io::decodeBinaryProject(bytes.data(), bytes.size(), out);
+}
+
+} // namespace
+
+int main() {
+    const auto dir = test::scratchDir("binaryproject");
+    const io::ProjectData project = test::sampleProject("bin");
+
+    // In memory and through a file, doubles and escapes included.
+    const std::vector<std::uint8_t> bytes = io::encodeBinaryProject(project);
+    CF_CHECK(io::isBinaryProject(bytes.data(), bytes.size()));
+    io::ProjectData decoded;
+    CF_CHECK(io::decodeBinaryProject(bytes.data(), bytes.size(), decoded));
+    CF_CHECK(test::sameProject(project, decoded));
+
+    const std::string path = (dir / "project.cfp").string();
+    CF_CHECK(io::saveBinaryProject(path, project));
+    io::ProjectData loaded;
+    CF_CHECK(io::loadBinaryProject(path, loaded));
+    CF_CHECK(test::sameProject(project, loaded));
+    CF_CHECK(!std::filesystem::exists(path + ".tmp"));
+
+    // Saving again replaces the file.
+    const io::ProjectData other = test::sampleProject("bin-other", 2);
+    CF_CHECK(io::saveBinaryProject(path, other));
+    CF_CHECK(io::loadBinaryProject(path, loaded));
+    CF_CHECK(test::sameProject(other, loaded));
+
+    const io::ProjectData empty;
+    const std::vector<std::uint8_t> emptyBytes = io::encodeBinaryProject(empty);
+    CF_CHECK(io::decodeBinaryProject(emptyBytes.data(), emptyBytes.size(), decoded));
+    CF_CHECK(test::sameProject(empty, decoded));
+
+    // The last section runs to the end of the file, so every shorter
+    // prefix cuts off part of a record.
+    int truncatedAccepted = 0;
+    for (std::size_t n = 0; n < bytes.size(); ++n) {
+        const std::vector<std::uint8_t> prefix(bytes.begin(), bytes.begin() + n);
+        truncatedAccepted += decodes(prefix) ? 1 : 0;
+    }
+    CF_CHECK(truncatedAccepted == 0);
+    CF_CHECK(!io::loadBinaryProject((dir / "missing.cfp").string(), loaded));
+
+    // Header damage.
+    CF_CHECK(!decodes(patched<char>(bytes, 0, 'X')));
+    CF_CHECK(!io::isBinaryProject(patched<char>(bytes, 0, 'X').data(), bytes.size()));
+    CF_CHECK(!decodes(patched<std::uint32_t>(bytes, kVersionOffset, 0)));
+    CF_CHECK(!decodes(
+        patched<std::uint32_t>(bytes, kVersionOffset, io::kBinaryProjectVersion + 1)));
+    CF_CHECK(!decodes(patched<std::uint32_t>(bytes, kSectionCountOffset, 1u << 30)));
+
+    // Directory entries pointing outside the file.
+    const std::size_t clips = entryOf(bytes, kClipsId);
+    CF_CHECK(clips != 0);
+    CF_CHECK(!decodes(patched<std::uint64_t>(bytes, clips + 8, bytes.size() + 8)));
+    CF_CHECK(!decodes(patched<std::uint64_t>(bytes, clips + 16, std::uint64_t{1} << 40)));
+    CF_CHECK(!decodes(patched<std::uint32_t>(bytes, clips + 4, 0)));
+
+    // Records referring past the end of their tables: a clip name that is
+    // not a string, and a string that runs past the string data.
+    const auto clipsAt = static_cast<std::size_t>(read<std::uint64_t>(bytes, clips + 8));
+    CF_CHECK(!decodes(patched<std::uint32_t>(bytes, clipsAt, 0xffffffffu)));
+    const std::size_t strings = entryOf(bytes, kStringsId);
+    const auto stringsAt = static_cast<std::size_t>(read<std::uint64_t>(bytes, strings + 8));
+    CF_CHECK(!decodes(patched<std::uint32_t>(bytes, stringsAt + 8 + 4, 0x7fffffffu)));
+
+    return test::finish("BinaryProjectTest");
+}
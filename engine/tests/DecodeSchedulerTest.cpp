@@ -0,0 +1,78 @@
+// DecodeScheduler: playback decodes forward with a single seek, jumps go
+// through seekExactUs(), and a seek still waiting on a slow backend is
+// resumed rather than reissued.
+
+#include <cstdint>
+#include <string>
+
+#include "MediaTestSupport.h"
+#include "TestSupport.h"
+#include "cineforge/media/DecodeScheduler.h"
+
+using namespace cineforge;
+
+namespace {
+
+constexpr int kFrames = 300; // 10 s at 30 fps
+
+} // namespace
+
+int main() {
+    const auto dir = test::scratchDir("decodescheduler");
+    const std::string path = (dir / "clip.y4m").string();
+    CF_CHECK(test::writePatternClip(path, 32, 18, kFrames, 30, 1));
+
+    test::CountingDecoder decoder(path, 30);
+    CF_CHECK(decoder.open());
+    media::DecodeScheduler scheduler;
+
+    // 60 Hz playback of a 30 fps clip: one seek to start, no sync-sample
+    // lookups, every frame decoded once and shown at the right time.
+    int wrong = 0;
+    int steps = 0;
+    for (std::int64_t t = 0; t < decoder.durationUs(); t += 16667, ++steps) {
+        CF_CHECK(scheduler.advance(decoder, t, 0));
+        if (decoder.framePtsUs() != decoder.ptsOf(t * 30 / 1'000'000)) {
+            ++wrong;
+        }
+    }
+    CF_CHECK(wrong == 0);
+    CF_CHECK(decoder.seeks == 1);
+    CF_CHECK(decoder.probes == 0);
+    CF_CHECK(decoder.decodes == kFrames);
+    CF_CHECK(scheduler.stats().discontinuities == 1);
+    CF_CHECK(scheduler.stats().sequential == static_cast<std::uint64_t>(steps - 1));
+
+    // Scrubbing back is a discontinuity.
+    decoder.resetCounts();
+    CF_CHECK(scheduler.advance(decoder, 2'000'000, 0));
+    CF_CHECK(decoder.seeks == 1);
+    CF_CHECK(decoder.framePtsUs() == decoder.ptsOf(60));
+    CF_CHECK(scheduler.stats().discontinuities == 2);
+
+    // A backend that needs several calls before the first frame after a
+    // seek: later calls keep waiting on that seek as the playhead moves.
+    decoder.latency = 5;
+    decoder.resetCounts();
+    bool ready = false;
+    int calls = 0;
+    for (std::int64_t t = 7'000'000; !ready && calls < 20; t += 16667, ++calls) {
+        ready = scheduler.advance(decoder, t, 0);
+    }
+    CF_CHECK(ready);
+    CF_CHECK(calls == 6);
+    CF_CHECK(decoder.seeks == 1);
+    CF_CHECK(decoder.framePtsUs() == decoder.ptsOf(212)); // 7.083 s
+    decoder.latency = 0;
+
+    // After reset() the next call is treated as a jump again; the stats
+    // keep counting.
+    scheduler.reset();
+    const media::DecodeScheduler::Stats before = scheduler.stats();
+    CF_CHECK(scheduler.advance(decoder, decoder.ptsOf(213), 0));
+    CF_CHECK(decoder.framePtsUs() == decoder.ptsOf(213));
+    CF_CHECK(scheduler.stats().discontinuities == before.discontinuities + 1);
+    CF_CHECK(scheduler.stats().sequential == before.sequential);
+
+    return test::finish("DecodeSchedulerTest");
+}
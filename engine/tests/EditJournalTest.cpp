@@ -0,0 +1,253 @@
+// EditJournal crash recovery. Each scenario runs in a child process that
+// journals edits and then dies with _exit(), skipping every destructor
+// and any snapshot still waiting for the background writer; the parent
+// recovers the directory and compares it with the same edits applied in
+// memory.
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+
+#include "ProjectTestSupport.h"
+#include "TestSupport.h"
+#include "cineforge/io/EditJournal.h"
+
+using namespace cineforge;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// A deterministic run of edits of every journaled kind, given the same
+// starting project.
+void applyEdits(timeline::Timeline& tl, timeline::KeyframeManager& km, const std::string& tag,
+                int count) {
+    std::mt19937 rng(static_cast<std::uint32_t>(std::hash<std::string>()(tag)));
+    auto pick = [&](std::size_t n) { return static_cast<std::size_t>(rng() % n); };
+    auto anyClip = [&]() -> const timeline::Clip* {
+        const auto& track = tl.tracks()[pick(tl.tracks().size())];
+        return track.clips.empty() ? nullptr : &track.clips[pick(track.clips.size())];
+    };
+    for (int i = 0; i < count; ++i) {
+        const std::string name = tag + "-" + std::to_string(i);
+        switch (rng() % 7) {
+        case 0: {
+            timeline::Track track;
+            track.id = intern(name + "-track");
+            track.type = timeline::TrackType::Video;
+            timeline::Clip clip;
+            clip.id = intern(name + "-clip");
+            clip.start = i * 0.25;
+            clip.end = clip.start + 1.0 / 3.0;
+            track.clips.push_back(clip);
+            tl.addTrack(track);
+            break;
+        }
+        case 1: {
+            timeline::Clip clip;
+            clip.id = intern(name);
+            clip.start = (rng() % 1000) / 7.0;
+            clip.end = clip.start + 0.5;
+            clip.outPoint = 0.5;
+            tl.addClip(tl.tracks()[pick(tl.tracks().size())].id, clip);
+            break;
+        }
+        case 2:
+            if (const auto* clip = anyClip()) {
+                tl.splitClip(clip->id, (clip->start + clip->end) / 2.0);
+            }
+            break;
+        case 3:
+            if (const auto* clip = anyClip()) {
+                tl.moveClip(clip->id, clip->start + 0.1);
+            }
+            break;
+        case 4:
+            if (const auto* clip = anyClip()) {
+                tl.removeClip(clip->id);
+            }
+            break;
+        case 5: {
+            timeline::KeyframeCurve curve;
+            curve.id = intern(tag + "-curve" + std::to_string(rng() % 8));
+            curve.target = intern("param:" + name);
+            std::vector<timeline::Keyframe> keys(1 + rng() % 4);
+            for (std::size_t k = 0; k < keys.size(); ++k) {
+                keys[k].time = k * 0.5;
+                keys[k].value = static_cast<double>(rng()) / 3.0;
+                keys[k].interp = static_cast<timeline::InterpolationType>(rng() % 6);
+            }
+            curve.setKeys(std::move(keys));
+            km.registerCurve(curve);
+            break;
+        }
+        default:
+            if (km.curveCount() > 0) {
+                km.removeCurve(km.curveAt(pick(km.curveCount())));
+            }
+            break;
+        }
+    }
+}
+
+// An autosaving project, set up as Engine does it.
+struct Session {
+    io::ProjectData base;
+    timeline::Timeline tl;
+    timeline::KeyframeManager km;
+    io::EditJournal journal;
+
+    void listen(bool on) {
+        if (!on) {
+            tl.setEditListener(nullptr);
+            km.setEditListener(nullptr);
+            return;
+        }
+        tl.setEditListener([this](const timeline::TimelineEdit& e) { journal.record(e); });
+        km.setEditListener([this](const timeline::CurveEdit& e) { journal.record(e); });
+    }
+
+    bool open(const std::string& dir, io::ProjectData project) {
+        base = std::move(project);
+        test::loadProject(base, tl, km);
+        if (!journal.open(dir, [this] { return test::projectOf(tl, km, base); })) {
+            return false;
+        }
+        listen(true);
+        return true;
+    }
+
+    // Engine::apply() for a loaded or recovered project.
+    bool replace(io::ProjectData project) {
+        listen(false);
+        base = std::move(project);
+        test::loadProject(base, tl, km);
+        if (!journal.restart()) {
+            return false;
+        }
+        listen(true);
+        return true;
+    }
+};
+
+// Runs `body` in a child process that then dies without cleaning up.
+// False if the child reported a failure.
+template <typename Body>
+bool crashAfter(Body body) {
+    std::fflush(nullptr);
+    const pid_t pid = fork();
+    if (pid == 0) {
+        _exit(body() ? 0 : 1);
+    }
+    int status = 0;
+    return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+           WEXITSTATUS(status) == 0;
+}
+
+io::ProjectData expected(const io::ProjectData& start, const std::string& tag, int count) {
+    timeline::Timeline tl;
+    timeline::KeyframeManager km;
+    test::loadProject(start, tl, km);
+    applyEdits(tl, km, tag, count);
+    return test::projectOf(tl, km, start);
+}
+
+} // namespace
+
+int main() {
+    const io::ProjectData a = test::sampleProject("a");
+    const io::ProjectData b = test::sampleProject("b");
+
+    // Record, crash, recover, with compactions along the way whose
+    // snapshots may or may not have reached the disk.
+    {
+        const std::string dir = test::scratchDir("journal-record").string();
+        CF_CHECK(crashAfter([&] {
+            Session s;
+            if (!s.open(dir, a)) {
+                return false;
+            }
+            s.journal.setCompactThreshold(2048);
+            applyEdits(s.tl, s.km, "r", 400);
+            return true;
+        }));
+        const io::ProjectData want = expected(a, "r", 400);
+        io::ProjectData got;
+        CF_CHECK(io::EditJournal::recover(dir, got));
+        CF_CHECK(test::sameProject(got, want));
+
+        // A record torn by the crash ends the replay without harm.
+        std::uint64_t newest = 0;
+        for (const auto& entry : fs::directory_iterator(dir)) {
+            const std::string name = entry.path().filename().string();
+            if (name.rfind("journal-", 0) == 0) {
+                newest = std::max<std::uint64_t>(newest, std::stoull(name.substr(8)));
+            }
+        }
+        const fs::path journal = fs::path(dir) / ("journal-" + std::to_string(newest) + ".log");
+        if (std::FILE* f = std::fopen(journal.string().c_str(), "ab")) {
+            const unsigned char torn[] = {0x40, 0, 0, 0, 0x12, 0x34, 0x56, 0x78, 1, 2, 3};
+            std::fwrite(torn, 1, sizeof(torn), f);
+            std::fclose(f);
+        }
+        io::ProjectData afterTear;
+        CF_CHECK(io::EditJournal::recover(dir, afterTear));
+        CF_CHECK(test::sameProject(afterTear, want));
+    }
+
+    // Replacing the project (a load), editing and crashing gives the new
+    // project with the new edits.
+    {
+        const std::string dir = test::scratchDir("journal-replace").string();
+        CF_CHECK(crashAfter([&] {
+            Session s;
+            if (!s.open(dir, a)) {
+                return false;
+            }
+            applyEdits(s.tl, s.km, "before", 50);
+            if (!s.replace(b)) {
+                return false;
+            }
+            applyEdits(s.tl, s.km, "after", 50);
+            return true;
+        }));
+        io::ProjectData got;
+        CF_CHECK(io::EditJournal::recover(dir, got));
+        CF_CHECK(test::sameProject(got, expected(b, "after", 50)));
+    }
+
+    // The same, but the new project's snapshot never reaches the disk, as
+    // if the process died before writing it. Recovery must not replay the
+    // new project's edits onto the old one; the last consistent state is
+    // the old project with its own edits.
+    {
+        const std::string dir = test::scratchDir("journal-unsaved").string();
+        CF_CHECK(crashAfter([&] {
+            Session s;
+            if (!s.open(dir, a)) {
+                return false;
+            }
+            applyEdits(s.tl, s.km, "before", 50);
+            // Generation 1 is open; its successor's snapshot cannot be
+            // written while a directory holds its temporary name.
+            std::error_code ec;
+            fs::create_directories(fs::path(dir) / "snapshot-2.cfp.tmp", ec);
+            if (s.replace(b) || s.journal.isOpen()) {
+                return false; // the failed write must stop journaling
+            }
+            applyEdits(s.tl, s.km, "after", 50);
+            s.journal.compact();
+            return true;
+        }));
+        io::ProjectData got;
+        CF_CHECK(io::EditJournal::recover(dir, got));
+        CF_CHECK(test::sameProject(got, expected(a, "before", 50)));
+    }
+
+    return test::finish("EditJournalTest");
+}
@@ -0,0 +1,153 @@
+// TestPatternSource -> Exporter (several render workers) -> Y4mSink, end
+// to end: frames arrive in order, the file is a well-formed y4m identical
+// to one written frame by frame, and the stats add up. A cancel() made
+// before run() still stops it.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TestSupport.h"
+#include "cineforge/exporter/Exporter.h"
+#include "cineforge/exporter/TestPatternSource.h"
+#include "cineforge/exporter/Y4mSink.h"
+
+using namespace cineforge;
+using namespace cineforge::exporter;
+
+namespace {
+
+// Records the order frames reach the sink in.
+class RecordingSink : public FrameSink {
+public:
+    explicit RecordingSink(std::string path) : y4m_(std::move(path)) {}
+
+    bool open(const ExportSettings& settings) override { return y4m_.open(settings); }
+    bool write(std::int64_t frame, const render::Frame& image) override {
+        frames.push_back(frame);
+        return y4m_.write(frame, image);
+    }
+    bool close() override { return y4m_.close(); }
+
+    std::vector<std::int64_t> frames;
+
+private:
+    Y4mSink y4m_;
+};
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+int main() {
+    const auto dir = test::scratchDir("export");
+    const std::string path = (dir / "out.y4m").string();
+    const std::string referencePath = (dir / "reference.y4m").string();
+
+    ExportSettings settings;
+    settings.width = 96;
+    settings.height = 54;
+    settings.fpsNum = 30000;
+    settings.fpsDen = 1001;
+    settings.firstFrame = 5;
+    settings.frameCount = 40;
+    settings.renderWorkers = 4;
+
+    Exporter exporter;
+    auto sink = std::make_shared<RecordingSink>(path);
+    exporter.setSource(std::make_shared<TestPatternSource>());
+    exporter.setSink(sink);
+    // Uneven per-frame work makes the workers finish out of order.
+    exporter.setRenderFactory([] {
+        return [](std::int64_t frame, double, const render::Frame& source, render::Frame& out) {
+            std::this_thread::sleep_for(std::chrono::microseconds((frame * 7919) % 3000));
+            for (int y = 0; y < source.height; ++y) {
+                std::copy_n(source.cpuData + static_cast<std::size_t>(y) * source.cpuStride,
+                            static_cast<std::size_t>(source.width) * 4,
+                            out.cpuData + static_cast<std::size_t>(y) * out.cpuStride);
+            }
+            return true;
+        };
+    });
+
+    ExportStats stats;
+    CF_CHECK(exporter.run(settings, &stats));
+
+    // Order.
+    CF_CHECK(sink->frames.size() == 40);
+    for (std::size_t i = 0; i < sink->frames.size(); ++i) {
+        CF_CHECK(sink->frames[i] == settings.firstFrame + static_cast<std::int64_t>(i));
+    }
+
+    // Stats.
+    CF_CHECK(stats.framesEncoded == 40);
+    CF_CHECK(stats.decode.frames == 40);
+    CF_CHECK(stats.render.frames == 40);
+    CF_CHECK(stats.encode.frames == 40);
+    CF_CHECK(stats.render.threads == 4);
+    CF_CHECK(stats.wallSeconds > 0.0);
+    CF_CHECK(stats.fps > 0.0);
+    CF_CHECK(stats.render.busySeconds > 0.0);
+    CF_CHECK(!stats.cancelled);
+
+    // Header and frame sizes.
+    const std::string file = readFile(path);
+    const std::string header =
+        "YUV4MPEG2 W96 H54 F30000:1001 Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n";
+    CF_CHECK(file.compare(0, header.size(), header) == 0);
+    const std::size_t frameBytes = 96 * 54 + 2 * 48 * 27;
+    CF_CHECK(file.size() == header.size() + 40 * (6 + frameBytes));
+    for (std::size_t i = 0; i < 40; ++i) {
+        CF_CHECK(file.compare(header.size() + i * (6 + frameBytes), 6, "FRAME\n") == 0);
+    }
+
+    // Content: the same frames written one by one on this thread.
+    {
+        Y4mSink reference(referencePath);
+        CF_CHECK(reference.open(settings));
+        TestPatternSource source;
+        std::vector<std::uint8_t> pixels(96 * 54 * 4);
+        render::Frame frame;
+        frame.width = 96;
+        frame.height = 54;
+        frame.cpuData = pixels.data();
+        frame.cpuStride = 96 * 4;
+        for (std::int64_t f = 5; f < 45; ++f) {
+            CF_CHECK(source.decode(f, settings.timeOf(f), frame));
+            CF_CHECK(reference.write(f, frame));
+        }
+        CF_CHECK(reference.close());
+    }
+    CF_CHECK(file == readFile(referencePath));
+
+    // A cancel() issued before run() stops that run before any frame is
+    // written, and is not carried over to the run after it.
+    {
+        auto cancelledSink = std::make_shared<RecordingSink>((dir / "cancelled.y4m").string());
+        exporter.setSink(cancelledSink);
+        exporter.cancel();
+        ExportStats cancelledStats;
+        CF_CHECK(!exporter.run(settings, &cancelledStats));
+        CF_CHECK(cancelledStats.cancelled);
+        CF_CHECK(cancelledStats.framesEncoded == 0);
+        CF_CHECK(cancelledSink->frames.empty());
+
+        auto nextSink = std::make_shared<RecordingSink>((dir / "next.y4m").string());
+        exporter.setSink(nextSink);
+        ExportStats nextStats;
+        CF_CHECK(exporter.run(settings, &nextStats));
+        CF_CHECK(!nextStats.cancelled);
+        CF_CHECK(nextSink->frames.size() == 40);
+    }
+
+    return test::finish("ExportTest");
+}
@@ -0,0 +1,175 @@
+// FramePrefetcher: playback from the ring, recovery from jumps while the
+// ring is full, scrubbing back after the end of the stream, and a decode
+// thread racing the consumer.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MediaTestSupport.h"
+#include "TestSupport.h"
+#include "cineforge/media/FramePrefetcher.h"
+
+using namespace cineforge;
+
+namespace {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 36;
+constexpr int kFrames = 240; // 8 s at 30 fps
+
+// What a decode thread does: decode only while the prefetcher asks for it.
+// Bounded, so a prefetcher that never settles fails instead of hanging.
+int pump(media::FramePrefetcher& frames) {
+    int steps = 0;
+    while (frames.wantsDecode() && steps < 1000) {
+        frames.decodeStep(0);
+        ++steps;
+    }
+    return steps;
+}
+
+std::int64_t ptsOf(std::int64_t index) { return index * 1'000'000 / 30; }
+
+// Frame frameAt() should give for `timeUs`: the one with the nearest PTS.
+std::int64_t nearestFrame(std::int64_t timeUs) {
+    std::int64_t index = 0;
+    while (index + 1 < kFrames && ptsOf(index + 1) - timeUs < timeUs - ptsOf(index)) {
+        ++index;
+    }
+    return index;
+}
+
+} // namespace
+
+int main() {
+    const auto dir = test::scratchDir("frameprefetcher");
+    const std::string path = (dir / "clip.y4m").string();
+    CF_CHECK(test::writePatternClip(path, kWidth, kHeight, kFrames, 30, 1));
+
+    std::vector<std::vector<std::uint8_t>> reference(kFrames);
+    {
+        media::Y4mDecoder decoder(path, 30);
+        CF_CHECK(decoder.open());
+        for (auto& rgba : reference) {
+            rgba.resize(kWidth * kHeight * 4);
+            CF_CHECK(decoder.decodeNext());
+            CF_CHECK(decoder.readRgba(rgba.data(), kWidth * 4));
+        }
+    }
+    auto shows = [&](const media::DecodedFrame* frame, std::int64_t timeUs) {
+        const std::int64_t index = nearestFrame(timeUs);
+        return frame != nullptr && frame->ptsUs == ptsOf(index) &&
+               frame->rgba == reference[index];
+    };
+
+    auto owned = std::make_unique<test::CountingDecoder>(path, 30);
+    CF_CHECK(owned->open());
+    test::CountingDecoder& decoder = *owned;
+    media::FramePrefetcher frames(std::move(owned), 6);
+    CF_CHECK(!frames.wantsDecode()); // nothing wanted yet
+
+    // Priming fills the ring, then decoding stops.
+    frames.prime(0);
+    pump(frames);
+    CF_CHECK(frames.queued() == 6);
+    CF_CHECK(!frames.wantsDecode());
+
+    // 60 Hz playback, decoding between display ticks, never misses.
+    int wrong = 0;
+    for (std::int64_t t = 0; t < 2'000'000; t += 16667) {
+        pump(frames);
+        if (!shows(frames.frameAt(t), t)) {
+            ++wrong;
+        }
+    }
+    CF_CHECK(wrong == 0);
+    pump(frames);
+    CF_CHECK(frames.queued() == 6);
+
+    // A jump while the ring is full drops it and decodes at the target.
+    decoder.resetCounts();
+    CF_CHECK(frames.frameAt(5'000'000) == nullptr);
+    CF_CHECK(frames.wantsDecode());
+    pump(frames);
+    CF_CHECK(shows(frames.frameAt(5'000'000), 5'000'000));
+    CF_CHECK(decoder.seeks == 1);
+    // And back.
+    CF_CHECK(frames.frameAt(1'000'000) == nullptr);
+    pump(frames);
+    CF_CHECK(shows(frames.frameAt(1'000'000), 1'000'000));
+    // A jump announced with prime() is ready before it is shown, even
+    // though the ring was full and the consumer holds one of its slots.
+    frames.prime(3'000'000);
+    pump(frames);
+    CF_CHECK(shows(frames.frameAt(3'000'000), 3'000'000));
+
+    // Playing into the end holds the last frame without decoding on.
+    const std::int64_t lastUs = ptsOf(kFrames - 1);
+    frames.prime(lastUs - 100'000);
+    pump(frames);
+    for (std::int64_t t = lastUs - 100'000; t < lastUs + 500'000; t += 16667) {
+        pump(frames);
+        CF_CHECK(shows(frames.frameAt(t), t));
+    }
+    decoder.resetCounts();
+    CF_CHECK(!frames.wantsDecode());
+    CF_CHECK(pump(frames) == 0);
+    CF_CHECK(decoder.seeks == 0);
+
+    // Scrubbing back from the end decodes again.
+    CF_CHECK(frames.frameAt(2'000'000) == nullptr);
+    CF_CHECK(frames.wantsDecode());
+    pump(frames);
+    CF_CHECK(shows(frames.frameAt(2'000'000), 2'000'000));
+
+    // trim() empties the ring and stops decoding until wanted again.
+    frames.trim();
+    CF_CHECK(frames.queued() == 0);
+    CF_CHECK(!frames.wantsDecode());
+    CF_CHECK(frames.frameAt(4'000'000) == nullptr);
+    pump(frames);
+    CF_CHECK(shows(frames.frameAt(4'000'000), 4'000'000));
+
+    // A decode thread racing the consumer, which jumps around without
+    // waiting: every frame it is given is intact, and each jump is
+    // displayed again shortly after.
+    std::atomic<bool> stop{false};
+    std::thread producer([&] {
+        while (!stop) {
+            if (!frames.wantsDecode() || !frames.decodeStep(1000)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+    });
+    int corrupt = 0;
+    int stalled = 0;
+    for (std::int64_t start : {0, 6'000'000, 1'000'000, 7'900'000, 500'000}) {
+        bool recovered = false;
+        for (int tick = 0; tick < 200; ++tick) {
+            const std::int64_t t = start + (tick / 4) * 16667; // 4 ticks per step
+            const media::DecodedFrame* frame = frames.frameAt(t);
+            if (frame != nullptr) {
+                const std::int64_t index = nearestFrame(frame->ptsUs);
+                if (index < 0 || index >= kFrames || frame->rgba != reference[index]) {
+                    ++corrupt;
+                }
+                recovered = recovered || shows(frame, t);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (!recovered) {
+            ++stalled;
+        }
+    }
+    stop = true;
+    producer.join();
+    CF_CHECK(corrupt == 0);
+    CF_CHECK(stalled == 0);
+
+    return test::finish("FramePrefetcherTest");
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cineforge/exporter/TestPatternSource.h"
+#include "cineforge/exporter/Y4mSink.h"
+#include "cineforge/media/Y4mDecoder.h"
+
+namespace cineforge::test {
+
+// Writes `frames` frames of exporter::TestPatternSource to a y4m file.
+inline bool writePatternClip(const std::string& path, int width, int height, int frames,
+                             int fpsNum, int fpsDen) {
+    exporter::ExportSettings settings;
+    settings.width = width;
+    settings.height = height;
+    settings.fpsNum = fpsNum;
+    settings.fpsDen = fpsDen;
+    exporter::Y4mSink sink(path);
+    if (!sink.open(settings)) {
+        return false;
+    }
+    exporter::TestPatternSource source;
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * height * 4);
+    render::Frame frame;
+    frame.width = width;
+    frame.height = height;
+    frame.cpuData = pixels.data();
+    frame.cpuStride = width * 4;
+    for (int f = 0; f < frames; ++f) {
+        if (!source.decode(f, settings.timeOf(f), frame) || !sink.write(f, frame)) {
+            return false;
+        }
+    }
+    return sink.close();
+}
+
+/**
+ * Y4mDecoder that counts the calls seek policy is judged by. With
+ * `latency` set, the first that many decodeNext() calls after each seek
+ * report nothing ready, like a hardware decoder refilling its pipeline.
+ */
+class CountingDecoder : public media::Y4mDecoder {
+public:
+    using Y4mDecoder::Y4mDecoder;
+
+    int seeks = 0;
+    int decodes = 0;
+    int probes = 0;
+    int latency = 0;
+
+    void resetCounts() { seeks = decodes = probes = 0; }
+
+    bool seekToUs(std::int64_t timeUs) override {
+        ++seeks;
+        stall_ = latency;
+        return Y4mDecoder::seekToUs(timeUs);
+    }
+    bool decodeNext(std::int64_t timeoutUs = 0) override {
+        if (stall_ > 0) {
+            --stall_;
+            return false;
+        }
+        ++decodes;
+        return Y4mDecoder::decodeNext(timeoutUs);
+    }
+    std::int64_t syncSampleUs(std::int64_t timeUs) override {
+        ++probes;
+        return Y4mDecoder::syncSampleUs(timeUs);
+    }
+
+private:
+    int stall_ = 0;
+};
+
+} // namespace cineforge::test
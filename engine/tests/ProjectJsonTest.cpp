@@ -0,0 +1,150 @@
+// JSON: doubles written by JsonWriter read back from JsonReader with the
+// same bits, whatever the chunk boundaries, and projects round-trip
+// exactly through text and files. Damaged or newer documents are rejected.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ProjectTestSupport.h"
+#include "TestSupport.h"
+#include "cineforge/io/ProjectJson.h"
+
+using namespace cineforge;
+
+namespace {
+
+// Collects the numbers of a flat array, and counts nulls.
+class NumberCollector : public io::JsonHandler {
+public:
+    std::vector<double> numbers;
+    int nulls = 0;
+
+    bool startObject() override { return false; }
+    bool endObject() override { return false; }
+    bool startArray() override { return true; }
+    bool endArray() override { return true; }
+    bool key(std::string_view) override { return false; }
+    bool string(std::string_view) override { return false; }
+    bool number(double value) override {
+        numbers.push_back(value);
+        return true;
+    }
+    bool boolean(bool) override { return false; }
+    bool null() override {
+        ++nulls;
+        return true;
+    }
+};
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// Feeds `text` `step` bytes at a time.
+io::JsonReader::RefillFn chunked(const std::string& text, std::size_t step) {
+    auto pos = std::make_shared<std::size_t>(0);
+    return [&text, step, pos](char* buffer, std::size_t capacity) {
+        const std::size_t n = std::min({step, capacity, text.size() - *pos});
+        std::memcpy(buffer, text.data() + *pos, n);
+        *pos += n;
+        return n;
+    };
+}
+
+} // namespace
+
+int main() {
+    const auto dir = test::scratchDir("projectjson");
+
+    // Values that need all 17 digits, sit at the ends of the range or
+    // carry a sign in a zero, plus random bit patterns.
+    std::vector<double> values = {0.0, -0.0, 0.1, 1.0 / 3.0, 2.0 / 3.0, 1e23, 9007199254740993.0,
+                                  DBL_MIN, DBL_MAX, -DBL_MAX, DBL_EPSILON,
+                                  std::numeric_limits<double>::denorm_min(),
+                                  5e-324, 1.7976931348623157e308, 123456789012345678.0,
+                                  0.30000000000000004, -1e-7};
+    std::mt19937_64 rng(20240601);
+    while (values.size() < 5000) {
+        const std::uint64_t bits = rng();
+        double v;
+        std::memcpy(&v, &bits, sizeof(v));
+        if (std::isfinite(v)) {
+            values.push_back(v);
+        }
+    }
+
+    std::string text;
+    {
+        io::JsonWriter writer(text, 0);
+        writer.startArray();
+        for (double v : values) {
+            writer.number(v);
+        }
+        writer.null();
+        writer.number(std::numeric_limits<double>::quiet_NaN());
+        writer.number(std::numeric_limits<double>::infinity());
+        writer.endArray();
+        CF_CHECK(writer.finish());
+    }
+    for (std::size_t step : {std::size_t{1}, std::size_t{7}, text.size()}) {
+        NumberCollector numbers;
+        io::JsonReader reader;
+        CF_CHECK(reader.parse(chunked(text, step), numbers));
+        CF_CHECK(numbers.numbers.size() == values.size());
+        CF_CHECK(numbers.nulls == 3); // non-finite values are written as null
+        int differing = 0;
+        for (std::size_t i = 0; i < std::min(values.size(), numbers.numbers.size()); ++i) {
+            differing += sameBits(values[i], numbers.numbers[i]) ? 0 : 1;
+        }
+        CF_CHECK(differing == 0);
+    }
+
+    // A project through a string, a streamed parse and a file.
+    const io::ProjectData project = test::sampleProject("json");
+    const std::string json = io::projectToJson(project);
+    io::ProjectData parsed;
+    std::string error;
+    CF_CHECK(io::projectFromJson(json, parsed, &error));
+    CF_CHECK(error.empty());
+    CF_CHECK(test::sameProject(project, parsed));
+
+    io::ProjectData streamed;
+    CF_CHECK(io::readProjectJson(chunked(json, 13), streamed));
+    CF_CHECK(test::sameProject(project, streamed));
+
+    const std::string path = (dir / "project.json").string();
+    CF_CHECK(io::saveProjectJson(path, project));
+    io::ProjectData loaded;
+    CF_CHECK(io::loadProjectJson(path, loaded));
+    CF_CHECK(test::sameProject(project, loaded));
+
+    // Writing what was read gives the same text.
+    CF_CHECK(io::projectToJson(loaded) == json);
+
+    // Truncated documents fail with a message; so does a newer version.
+    int truncatedAccepted = 0;
+    for (std::size_t n = 0; n < json.size(); n += 97) {
+        io::ProjectData out;
+        std::string why;
+        if (io::projectFromJson(std::string_view(json).substr(0, n), out, &why) || why.empty()) {
+            ++truncatedAccepted;
+        }
+    }
+    CF_CHECK(truncatedAccepted == 0);
+    io::ProjectData out;
+    CF_CHECK(!io::projectFromJson("{\"version\": " + std::to_string(io::kJsonProjectVersion + 1) +
+                                      "}",
+                                  out));
+    CF_CHECK(!io::loadProjectJson((dir / "missing.json").string(), out));
+
+    return test::finish("ProjectJsonTest");
+}
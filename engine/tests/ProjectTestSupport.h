@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cineforge/io/ProjectData.h"
+#include "cineforge/timeline/KeyframeManager.h"
+#include "cineforge/timeline/Timeline.h"
+
+namespace cineforge::test {
+
+// A project exercising every field the project formats store: awkward
+// doubles, every interpolation type, Bezier handles, all track types and
+// names needing escapes in JSON. `tag` keeps ids of several projects
+// apart.
+inline io::ProjectData sampleProject(const std::string& tag, int clipsPerTrack = 6) {
+    std::mt19937 rng(static_cast<std::uint32_t>(std::hash<std::string>()(tag)));
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    io::ProjectData project;
+    project.previewTime = 12.345678901234567;
+    for (int i = 0; i < 3; ++i) {
+        media::MediaSource src;
+        src.id = intern(tag + "-src" + std::to_string(i));
+        src.path = "/media/" + tag + "/clip \"" + std::to_string(i) + "\"\\ünï.mov";
+        src.proxyPath = i == 0 ? std::string() : "/proxies/" + std::to_string(i) + ".mp4";
+        src.mediaType = i == 2 ? "audio" : "video";
+        src.duration = 10.0 / 3.0 * (i + 1);
+        project.media.push_back(src);
+    }
+    const timeline::TrackType types[] = {timeline::TrackType::Video, timeline::TrackType::Audio,
+                                         timeline::TrackType::Subtitle,
+                                         timeline::TrackType::Adjustment,
+                                         timeline::TrackType::Unknown};
+    int clipNo = 0;
+    for (int t = 0; t < 5; ++t) {
+        timeline::Track track;
+        track.id = intern(tag + "-track" + std::to_string(t));
+        track.type = types[t];
+        double at = unit(rng);
+        for (int c = 0; c < clipsPerTrack; ++c) {
+            timeline::Clip clip;
+            clip.id = intern(tag + "-clip" + std::to_string(clipNo++));
+            clip.sourceId = project.media[static_cast<std::size_t>(c) % 3].id;
+            clip.start = at;
+            clip.end = at + 0.1 + unit(rng) * 3.0;
+            clip.inPoint = unit(rng) / 7.0;
+            clip.outPoint = clip.inPoint + (clip.end - clip.start);
+            at = clip.end + unit(rng) * 1e-9;
+            track.clips.push_back(clip);
+        }
+        project.tracks.push_back(track);
+    }
+    for (int c = 0; c < 6; ++c) {
+        io::CurveData curve;
+        curve.id = intern(tag + "-curve" + std::to_string(c));
+        curve.target = intern("clip:" + tag + ":param:" + std::to_string(c));
+        for (int k = 0; k < 5; ++k) {
+            timeline::Keyframe key;
+            key.time = k * 0.7 + unit(rng) * 0.1;
+            key.value = (unit(rng) - 0.5) * 1e6;
+            key.interp = static_cast<timeline::InterpolationType>((c + k) % 6);
+            if (key.interp == timeline::InterpolationType::Bezier && k % 2 == 0) {
+                key.bezier = timeline::BezierHandles{-0.1f, 0.25f, 0.3f, -1.5f};
+            }
+            curve.keys.push_back(key);
+        }
+        project.curves.push_back(curve);
+    }
+    return project;
+}
+
+inline bool sameKey(const timeline::Keyframe& a, const timeline::Keyframe& b) {
+    if (a.time != b.time || a.value != b.value || a.interp != b.interp ||
+        a.bezier.has_value() != b.bezier.has_value()) {
+        return false;
+    }
+    return !a.bezier || (a.bezier->inX == b.bezier->inX && a.bezier->inY == b.bezier->inY &&
+                         a.bezier->outX == b.bezier->outX && a.bezier->outY == b.bezier->outY);
+}
+
+// Field-by-field and exact, doubles included.
+inline bool sameProject(const io::ProjectData& a, const io::ProjectData& b) {
+    if (a.previewTime != b.previewTime || a.media.size() != b.media.size() ||
+        a.tracks.size() != b.tracks.size() || a.curves.size() != b.curves.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.media.size(); ++i) {
+        const auto& x = a.media[i];
+        const auto& y = b.media[i];
+        if (x.id != y.id || x.path != y.path || x.proxyPath != y.proxyPath ||
+            x.mediaType != y.mediaType || x.duration != y.duration) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i < a.tracks.size(); ++i) {
+        const auto& x = a.tracks[i];
+        const auto& y = b.tracks[i];
+        if (x.id != y.id || x.type != y.type || x.clips.size() != y.clips.size()) {
+            return false;
+        }
+        for (std::size_t c = 0; c < x.clips.size(); ++c) {
+            const auto& p = x.clips[c];
+            const auto& q = y.clips[c];
+            if (p.id != q.id || p.sourceId != q.sourceId || p.start != q.start ||
+                p.end != q.end || p.inPoint != q.inPoint || p.outPoint != q.outPoint) {
+                return false;
+            }
+        }
+    }
+    for (std::size_t i = 0; i < a.curves.size(); ++i) {
+        const auto& x = a.curves[i];
+        const auto& y = b.curves[i];
+        if (x.id != y.id || x.target != y.target || x.keys.size() != y.keys.size()) {
+            return false;
+        }
+        for (std::size_t k = 0; k < x.keys.size(); ++k) {
+            if (!sameKey(x.keys[k], y.keys[k])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Loads `project` the way Engine applies one: tracks and curves whole.
+inline void loadProject(const io::ProjectData& project, timeline::Timeline& tl,
+                        timeline::KeyframeManager& km) {
+    tl.clear();
+    km.clear();
+    for (const auto& track : project.tracks) {
+        tl.addTrack(track);
+    }
+    for (const auto& data : project.curves) {
+        timeline::KeyframeCurve curve;
+        curve.id = data.id;
+        curve.target = data.target;
+        curve.setKeys(data.keys);
+        km.registerCurve(curve);
+    }
+}
+
+// The project `tl` and `km` hold, with media and preview time from `base`.
+inline io::ProjectData projectOf(const timeline::Timeline& tl, const timeline::KeyframeManager& km,
+                                 const io::ProjectData& base) {
+    io::ProjectData project;
+    project.previewTime = base.previewTime;
+    project.media = base.media;
+    project.tracks = tl.tracks();
+    for (std::size_t slot = 0; slot < km.curveCount(); ++slot) {
+        const auto* curve = km.getCurve(km.curveAt(slot));
+        project.curves.push_back({curve->id, curve->target, curve->keys()});
+    }
+    return project;
+}
+
+} // namespace cineforge::test
@@ -0,0 +1,266 @@
+// ProxyManager with a scripted transcoder: concurrent requests share a
+// job, cancelling a running job discards its output, the disk quota evicts
+// the least recently used proxy, a new session reuses the index until the
+// source changes, and selectProxy() does not requeue pending or failed
+// tiers.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TestSupport.h"
+#include "cineforge/media/ProxyManager.h"
+
+using namespace cineforge;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::uint64_t kProxyBytes = 1000;
+
+// Stands in for FFmpeg. Transcodes wait while the gate is closed (or until
+// cancelled) and then write kProxyBytes, except for widths set to fail.
+struct FakeTranscoder {
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool open = true;
+    std::vector<int> calls; // widths, in the order transcodes started
+    std::vector<int> failWidths;
+
+    media::ProxyManager::TranscodeFn fn() {
+        return [this](const media::MediaSource&, int width, const std::string& out,
+                      const std::atomic<bool>& cancelled, int& height) {
+            std::unique_lock<std::mutex> lock(mtx);
+            calls.push_back(width);
+            cv.notify_all();
+            while (!open && !cancelled.load()) {
+                cv.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            if (std::find(failWidths.begin(), failWidths.end(), width) != failWidths.end()) {
+                return false;
+            }
+            lock.unlock();
+            // Finishes even when cancelled, as a transcoder that does not
+            // poll would; the manager has to drop the result itself.
+            std::ofstream(out, std::ios::binary) << std::string(kProxyBytes, 'p');
+            height = width * 9 / 16;
+            return true;
+        };
+    }
+
+    void setOpen(bool on) {
+        std::lock_guard<std::mutex> lock(mtx);
+        open = on;
+        cv.notify_all();
+    }
+
+    bool waitStarted(std::size_t count) {
+        std::unique_lock<std::mutex> lock(mtx);
+        return cv.wait_for(lock, std::chrono::seconds(5),
+                           [&] { return calls.size() >= count; });
+    }
+
+    int callsFor(int width) {
+        std::lock_guard<std::mutex> lock(mtx);
+        return static_cast<int>(std::count(calls.begin(), calls.end(), width));
+    }
+};
+
+bool waitIdle(const media::ProxyManager& pm) {
+    for (int i = 0; i < 5000; ++i) {
+        if (pm.pendingJobs() == 0) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+media::MediaSource writeSource(const fs::path& dir, const std::string& name,
+                               std::size_t bytes) {
+    media::MediaSource src;
+    src.id = intern("proxytest-" + name);
+    src.path = (dir / (name + ".mov")).string();
+    src.mediaType = "video";
+    std::ofstream(src.path, std::ios::binary) << std::string(bytes, name[0]);
+    return src;
+}
+
+} // namespace
+
+int main() {
+    const auto dir = test::scratchDir("proxymanager");
+    const media::MediaSource a = writeSource(dir, "a", 4096);
+    const media::MediaSource b = writeSource(dir, "b", 4097);
+    const media::MediaSource c = writeSource(dir, "c", 4098);
+    const media::MediaSource d = writeSource(dir, "d", 4099);
+
+    // Requests for the same source and width while the job runs join it.
+    {
+        FakeTranscoder fake;
+        media::ProxyManager pm("", (dir / "dedup").string(), 2);
+        pm.setTranscoder(fake.fn(), "fake");
+        fake.setOpen(false);
+        auto first = pm.requestProxy(a, 480);
+        CF_CHECK(fake.waitStarted(1));
+        int callbacks = 0;
+        auto second = pm.requestProxy(a, 480, 5, [&](const media::ProxyInfo&) { ++callbacks; });
+        CF_CHECK(pm.pendingJobs() == 1);
+        fake.setOpen(true);
+        const media::ProxyInfo one = first.get();
+        const media::ProxyInfo two = second.get();
+        CF_CHECK(one.valid && two.valid);
+        CF_CHECK(one.proxyPath == two.proxyPath);
+        CF_CHECK(one.width == 480 && one.height == 270);
+        CF_CHECK(callbacks == 1);
+        CF_CHECK(fake.callsFor(480) == 1);
+
+        // A ready proxy resolves at once.
+        CF_CHECK(pm.requestProxy(a, 480).get().proxyPath == one.proxyPath);
+        CF_CHECK(fake.callsFor(480) == 1);
+    }
+
+    // Cancelling a running job resolves it invalid and keeps nothing,
+    // even though the transcoder went on to write its output.
+    {
+        FakeTranscoder fake;
+        const fs::path root = dir / "cancel";
+        media::ProxyManager pm("", root.string(), 1);
+        pm.setTranscoder(fake.fn(), "fake");
+        fake.setOpen(false);
+        auto running = pm.requestProxy(a, 960);
+        CF_CHECK(fake.waitStarted(1));
+        CF_CHECK(pm.cancel(a.id, 960));
+        CF_CHECK(!pm.cancel(a.id, 960));
+        CF_CHECK(pm.pendingJobs() == 0);
+        CF_CHECK(!running.get().valid);
+        CF_CHECK(!pm.getProxy(a.id, 960).valid);
+        CF_CHECK(pm.diskUsage() == 0);
+        bool leftovers = false;
+        for (const auto& entry : fs::directory_iterator(root)) {
+            leftovers = leftovers || entry.path().extension() != ".txt";
+        }
+        CF_CHECK(!leftovers);
+
+        // A new request after the cancel starts over.
+        fake.setOpen(true);
+        CF_CHECK(pm.ensureProxy(a, 960).valid);
+        CF_CHECK(fake.callsFor(960) == 2);
+    }
+
+    // Over quota, the least recently used proxy goes: a is used again
+    // after c is made, so b is the one evicted when d arrives.
+    {
+        FakeTranscoder fake;
+        media::ProxyManager pm("", (dir / "quota").string(), 1);
+        pm.setTranscoder(fake.fn(), "fake");
+        pm.setDiskQuota(3 * kProxyBytes);
+        const auto pause = [] { std::this_thread::sleep_for(std::chrono::milliseconds(3)); };
+        const media::ProxyInfo pa = pm.ensureProxy(a, 480);
+        pause();
+        const media::ProxyInfo pb = pm.ensureProxy(b, 480);
+        pause();
+        CF_CHECK(pm.ensureProxy(c, 480).valid);
+        pause();
+        CF_CHECK(pm.requestProxy(a, 480).get().valid);
+        pause();
+        CF_CHECK(pm.ensureProxy(d, 480).valid);
+        CF_CHECK(pm.diskUsage() == 3 * kProxyBytes);
+        CF_CHECK(!pm.getProxy(b.id, 480).valid);
+        CF_CHECK(!fs::exists(pb.proxyPath));
+        CF_CHECK(pm.getProxy(a.id, 480).valid);
+        CF_CHECK(fs::exists(pa.proxyPath));
+        CF_CHECK(fake.calls.size() == 4);
+
+        // Lowering the quota evicts at once, keeping the newest.
+        pm.setDiskQuota(kProxyBytes);
+        CF_CHECK(pm.diskUsage() == kProxyBytes);
+        CF_CHECK(pm.getProxy(d.id, 480).valid);
+        CF_CHECK(!pm.getProxy(a.id, 480).valid);
+    }
+
+    // A new session finds earlier proxies through the index, with their
+    // height, until the source's contents change.
+    {
+        const fs::path root = dir / "reload";
+        media::MediaSource src = writeSource(dir, "e", 5000);
+        media::ProxyInfo made;
+        {
+            FakeTranscoder fake;
+            media::ProxyManager pm("", root.string(), 1);
+            pm.setTranscoder(fake.fn(), "fake");
+            made = pm.ensureProxy(src, 480);
+            CF_CHECK(made.valid);
+        }
+        FakeTranscoder fake;
+        media::ProxyManager pm("", root.string(), 1);
+        pm.setTranscoder(fake.fn(), "fake");
+        const media::ProxyInfo reused = pm.ensureProxy(src, 480);
+        CF_CHECK(reused.valid);
+        CF_CHECK(reused.proxyPath == made.proxyPath);
+        CF_CHECK(reused.height == 270);
+        CF_CHECK(fake.calls.empty());
+
+        // Moving the source keeps the match; changing it does not.
+        const std::string moved = (dir / "e-moved.mov").string();
+        fs::rename(src.path, moved);
+        src.path = moved;
+        CF_CHECK(pm.ensureProxy(src, 480).proxyPath == made.proxyPath);
+        CF_CHECK(fake.calls.empty());
+        std::ofstream(src.path, std::ios::binary | std::ios::app) << "more";
+        const media::ProxyInfo remade = pm.ensureProxy(src, 480);
+        CF_CHECK(remade.valid);
+        CF_CHECK(remade.proxyPath != made.proxyPath);
+        CF_CHECK(fake.calls.size() == 1);
+    }
+
+    // selectProxy() asks for the quick tier and the wanted one once, and
+    // leaves them alone while they are queued and after the wanted one
+    // fails, until the source changes.
+    {
+        FakeTranscoder fake;
+        media::ProxyManager pm("", (dir / "select").string(), 1);
+        pm.setTranscoder(fake.fn(), "fake");
+        pm.setTiers({480, 960});
+        fake.failWidths = {960};
+        fake.setOpen(false);
+
+        media::ProxySelection sel = pm.selectProxy(c, 900);
+        CF_CHECK(sel.wantedWidth == 960);
+        CF_CHECK(!sel.proxy.valid);
+        CF_CHECK(sel.upgrading);
+        CF_CHECK(fake.waitStarted(1));
+        CF_CHECK(fake.calls.front() == 480); // the quick tier goes first
+        for (int i = 0; i < 10; ++i) {
+            sel = pm.selectProxy(c, 900);
+        }
+        CF_CHECK(pm.pendingJobs() == 2);
+        fake.setOpen(true);
+        CF_CHECK(waitIdle(pm));
+        CF_CHECK(fake.callsFor(480) == 1);
+        CF_CHECK(fake.callsFor(960) == 1);
+
+        for (int i = 0; i < 10; ++i) {
+            sel = pm.selectProxy(c, 900);
+        }
+        CF_CHECK(sel.proxy.valid && sel.proxy.width == 480);
+        CF_CHECK(!sel.upgrading);
+        CF_CHECK(pm.pendingJobs() == 0);
+        CF_CHECK(fake.callsFor(960) == 1);
+
+        std::ofstream(c.path, std::ios::binary | std::ios::app) << "changed";
+        sel = pm.selectProxy(c, 900);
+        CF_CHECK(waitIdle(pm));
+        CF_CHECK(fake.callsFor(960) == 2);
+    }
+
+    return test::finish("ProxyManagerTest");
+}
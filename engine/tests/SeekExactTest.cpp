@@ -0,0 +1,84 @@
+// Decoder::seekExactUs() over a Y4mDecoder: lands on the frame shown at
+// the target, and decodes on rather than seeking within a GOP.
+
+#include <cstdint>
+#include <string>
+
+#include "MediaTestSupport.h"
+#include "TestSupport.h"
+
+using namespace cineforge;
+
+namespace {
+
+constexpr int kFrames = 300;
+constexpr int kGop = 30;
+
+} // namespace
+
+int main() {
+    const auto dir = test::scratchDir("seekexact");
+    const std::string path = (dir / "clip.y4m").string();
+    CF_CHECK(test::writePatternClip(path, 32, 18, kFrames, 30000, 1001));
+
+    test::CountingDecoder decoder(path, kGop);
+    CF_CHECK(decoder.open());
+
+    // Index of the last frame presented at or before `timeUs`.
+    auto floorFrame = [&](std::int64_t timeUs) {
+        std::int64_t index = 0;
+        while (index + 1 < kFrames && decoder.ptsOf(index + 1) <= timeUs) {
+            ++index;
+        }
+        return index;
+    };
+
+    // Frame-accurate from anywhere: on a frame, inside one, and just
+    // before the next. A zero timeout still finishes the decode work.
+    int mismatches = 0;
+    for (int i = 0; i < kFrames; ++i) {
+        for (std::int64_t t : {decoder.ptsOf(i), decoder.ptsOf(i) + 10000, decoder.ptsOf(i + 1) - 2}) {
+            CF_CHECK(decoder.seekExactUs(t, 0));
+            if (decoder.framePtsUs() != decoder.ptsOf(floorFrame(t))) {
+                ++mismatches;
+            }
+        }
+    }
+    CF_CHECK(mismatches == 0);
+
+    // 60 Hz playback from a fresh open seeks once, for the first frame.
+    decoder.close();
+    CF_CHECK(decoder.open());
+    decoder.resetCounts();
+    for (std::int64_t t = 0; t < decoder.durationUs(); t += 16667) {
+        CF_CHECK(decoder.seekExactUs(t, 0));
+    }
+    CF_CHECK(decoder.seeks == 1);
+    CF_CHECK(decoder.decodes == kFrames);
+
+    // Backwards seeks.
+    decoder.resetCounts();
+    CF_CHECK(decoder.seekExactUs(decoder.ptsOf(100), 0));
+    CF_CHECK(decoder.seeks == 1);
+    CF_CHECK(decoder.framePtsUs() == decoder.ptsOf(100));
+
+    // Ahead within the same GOP decodes on.
+    decoder.resetCounts();
+    CF_CHECK(decoder.seekExactUs(decoder.ptsOf(115), 0));
+    CF_CHECK(decoder.seeks == 0);
+    CF_CHECK(decoder.decodes == 15);
+    CF_CHECK(decoder.framePtsUs() == decoder.ptsOf(115));
+
+    // Ahead by whole GOPs seeks, then decodes only from the sync sample.
+    decoder.resetCounts();
+    CF_CHECK(decoder.seekExactUs(decoder.ptsOf(215), 0));
+    CF_CHECK(decoder.seeks == 1);
+    CF_CHECK(decoder.decodes == 215 - 210 + 1);
+    CF_CHECK(decoder.framePtsUs() == decoder.ptsOf(215));
+
+    // Past the end holds the last frame.
+    CF_CHECK(decoder.seekExactUs(decoder.durationUs() + 5'000'000, 0));
+    CF_CHECK(decoder.framePtsUs() == decoder.ptsOf(kFrames - 1));
+
+    return test::finish("SeekExactTest");
+}
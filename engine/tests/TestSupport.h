@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace cineforge::test {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+// Fresh directory for files a test writes, removed by the next run.
+inline std::filesystem::path scratchDir(const std::string& name) {
+    const auto dir = std::filesystem::temp_directory_path() / ("cineforge-" + name);
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+inline int finish(const char* name) {
+    if (failures() != 0) {
+        std::fprintf(stderr, "%s: %d check(s) failed\n", name, failures());
+        return 1;
+    }
+    std::printf("%s: ok\n", name);
+    return 0;
+}
+
+} // namespace cineforge::test
+
+// Records a failure and carries on, so one run reports every broken check.
+#define CF_CHECK(cond)                                                              \
+    do {                                                                            \
+        if (!(cond)) {                                                              \
+            ++::cineforge::test::failures();                                        \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                           \
+    } while (0)
@@ -0,0 +1,91 @@
+// Y4mSink -> Y4mDecoder round trip: geometry, timing, coarse seeking to
+// GOP starts, decoded pixels and end of stream.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "MediaTestSupport.h"
+#include "TestSupport.h"
+
+using namespace cineforge;
+
+namespace {
+
+constexpr int kWidth = 67; // odd, so chroma rounds up
+constexpr int kHeight = 39;
+constexpr int kFrames = 50;
+constexpr int kGop = 12;
+
+} // namespace
+
+int main() {
+    const auto dir = test::scratchDir("y4mdecoder");
+    const std::string path = (dir / "clip.y4m").string();
+    CF_CHECK(test::writePatternClip(path, kWidth, kHeight, kFrames, 30000, 1001));
+
+    media::Y4mDecoder decoder(path, kGop);
+    CF_CHECK(decoder.open());
+    CF_CHECK(decoder.width() == kWidth);
+    CF_CHECK(decoder.height() == kHeight);
+    CF_CHECK(decoder.frameCount() == kFrames);
+    CF_CHECK(decoder.ptsOf(1) == 33366); // 1001/30000 s, rounded down
+    CF_CHECK(decoder.frameDurationUs() == decoder.ptsOf(1));
+    CF_CHECK(decoder.framePtsUs() == -1);
+
+    // Seeking lands on the GOP start at or before the frame shown then.
+    for (int i = 0; i < kFrames; ++i) {
+        const std::int64_t gopStart = decoder.ptsOf(i - i % kGop);
+        CF_CHECK(decoder.syncSampleUs(decoder.ptsOf(i)) == gopStart);
+        CF_CHECK(decoder.seekToUs(decoder.ptsOf(i)));
+        CF_CHECK(decoder.framePtsUs() == -1);
+        CF_CHECK(decoder.decodeNext());
+        CF_CHECK(decoder.framePtsUs() == gopStart);
+
+        const int before = i == 0 ? 0 : i - 1;
+        CF_CHECK(decoder.seekToUs(decoder.ptsOf(i) - 1));
+        CF_CHECK(decoder.decodeNext());
+        CF_CHECK(decoder.framePtsUs() == decoder.ptsOf(before - before % kGop));
+    }
+
+    // Every frame decodes back to the pattern, within 4:2:0 and rounding
+    // error.
+    CF_CHECK(decoder.seekToUs(0));
+    std::vector<std::uint8_t> rgba(kWidth * kHeight * 4);
+    int decoded = 0;
+    int maxError = 0;
+    while (decoder.decodeNext()) {
+        CF_CHECK(decoder.framePtsUs() == decoder.ptsOf(decoded));
+        CF_CHECK(decoder.readRgba(rgba.data(), kWidth * 4));
+        for (int y = 0; y < kHeight; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                std::uint8_t expected[4];
+                exporter::TestPatternSource::pixel(decoded, x, y, expected);
+                const std::uint8_t* got = &rgba[(y * kWidth + x) * 4];
+                for (int c = 0; c < 3; ++c) {
+                    maxError = std::max(maxError, std::abs(expected[c] - got[c]));
+                }
+                CF_CHECK(got[3] == 255);
+            }
+        }
+        ++decoded;
+    }
+    CF_CHECK(decoded == kFrames);
+    CF_CHECK(maxError <= 4);
+    CF_CHECK(decoder.endOfStream());
+    CF_CHECK(decoder.framePtsUs() == decoder.ptsOf(kFrames - 1)); // last frame kept
+
+    // Past the end seeks to the last GOP.
+    CF_CHECK(decoder.seekToUs(10'000'000));
+    CF_CHECK(!decoder.endOfStream());
+    CF_CHECK(decoder.decodeNext());
+    CF_CHECK(decoder.framePtsUs() == decoder.ptsOf((kFrames - 1) / kGop * kGop));
+
+    // Not a y4m file.
+    media::Y4mDecoder bad((dir / "missing.y4m").string());
+    CF_CHECK(!bad.open());
+
+    return test::finish("Y4mDecoderTest");
+}
@@ -0,0 +1,161 @@
+// Every SIMD kernel against the scalar reference, byte for byte, over
+// random images; plus the scalar path against an exact float conversion.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "TestSupport.h"
+#include "cineforge/render/YuvConvert.h"
+
+using namespace cineforge::render;
+
+namespace {
+
+struct Planes {
+    std::vector<std::uint8_t> y, u, v;
+    YuvImage image;
+};
+
+Planes randomImage(std::mt19937& rng, int width, int height, YuvLayout layout, int padding) {
+    std::uniform_int_distribution<int> byte(0, 255);
+    auto fill = [&](std::vector<std::uint8_t>& plane, std::size_t size) {
+        plane.resize(size);
+        for (auto& b : plane) {
+            b = static_cast<std::uint8_t>(byte(rng));
+        }
+    };
+    Planes p;
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    p.image.width = width;
+    p.image.height = height;
+    p.image.layout = layout;
+    p.image.yStride = width + padding;
+    fill(p.y, static_cast<std::size_t>(p.image.yStride) * height);
+    if (layout == YuvLayout::I420) {
+        p.image.uvStride = chromaWidth + padding;
+        fill(p.u, static_cast<std::size_t>(p.image.uvStride) * chromaHeight);
+        fill(p.v, static_cast<std::size_t>(p.image.uvStride) * chromaHeight);
+        p.image.v = p.v.data();
+    } else {
+        p.image.uvStride = chromaWidth * 2 + padding;
+        fill(p.u, static_cast<std::size_t>(p.image.uvStride) * chromaHeight);
+    }
+    p.image.y = p.y.data();
+    p.image.u = p.u.data();
+    return p;
+}
+
+std::vector<std::uint8_t> convert(const YuvImage& image, YuvMatrix matrix, YuvRange range,
+                                  YuvKernel kernel, int y0, int y1) {
+    // Output rows are padded too, and the padding must stay untouched.
+    const int stride = image.width * 4 + 12;
+    std::vector<std::uint8_t> out(static_cast<std::size_t>(stride) * image.height, 0xCD);
+    Frame frame;
+    frame.width = image.width;
+    frame.height = image.height;
+    frame.format = PixelFormat::RGBA8;
+    frame.cpuData = out.data();
+    frame.cpuStride = stride;
+    yuvToRgba(image, matrix, range, frame, y0, y1, kernel);
+    return out;
+}
+
+int maxFloatError(const YuvImage& image, YuvMatrix matrix, YuvRange range,
+                  const std::vector<std::uint8_t>& out) {
+    const double kr = matrix == YuvMatrix::BT709 ? 0.2126 : 0.299;
+    const double kb = matrix == YuvMatrix::BT709 ? 0.0722 : 0.114;
+    const double kg = 1.0 - kr - kb;
+    const bool limited = range == YuvRange::Limited;
+    const int stride = image.width * 4 + 12;
+    int worst = 0;
+    for (int y = 0; y < image.height; ++y) {
+        for (int x = 0; x < image.width; ++x) {
+            const int cy = y / 2;
+            int u = 0, v = 0;
+            if (image.layout == YuvLayout::I420) {
+                u = image.u[cy * image.uvStride + x / 2];
+                v = image.v[cy * image.uvStride + x / 2];
+            } else {
+                const std::uint8_t* c = image.u + cy * image.uvStride + (x / 2) * 2;
+                u = image.layout == YuvLayout::NV12 ? c[0] : c[1];
+                v = image.layout == YuvLayout::NV12 ? c[1] : c[0];
+            }
+            const double yy = limited ? (image.y[y * image.yStride + x] - 16) * 255.0 / 219.0
+                                      : image.y[y * image.yStride + x];
+            const double cs = limited ? 255.0 / 224.0 : 1.0;
+            const double pb = (u - 128) * cs, pr = (v - 128) * cs;
+            const double rgb[3] = {yy + 2.0 * (1.0 - kr) * pr,
+                                   yy - 2.0 * kb * (1.0 - kb) / kg * pb -
+                                       2.0 * kr * (1.0 - kr) / kg * pr,
+                                   yy + 2.0 * (1.0 - kb) * pb};
+            const std::uint8_t* px = out.data() + y * stride + x * 4;
+            for (int c = 0; c < 3; ++c) {
+                const int exact = static_cast<int>(std::lround(std::clamp(rgb[c], 0.0, 255.0)));
+                worst = std::max(worst, std::abs(exact - px[c]));
+            }
+            if (px[3] != 255) {
+                worst = 256;
+            }
+        }
+    }
+    return worst;
+}
+
+} // namespace
+
+int main() {
+    const YuvKernel simd[] = {YuvKernel::Auto, YuvKernel::Sse2, YuvKernel::Avx2, YuvKernel::Neon};
+    const YuvLayout layouts[] = {YuvLayout::NV12, YuvLayout::NV21, YuvLayout::I420};
+    const YuvMatrix matrices[] = {YuvMatrix::BT601, YuvMatrix::BT709};
+    const YuvRange ranges[] = {YuvRange::Limited, YuvRange::Full};
+
+    CF_CHECK(yuvKernelAvailable(YuvKernel::Scalar));
+    for (YuvKernel kernel : simd) {
+        if (kernel != YuvKernel::Auto && yuvKernelAvailable(kernel)) {
+            std::printf("testing kernel %d\n", static_cast<int>(kernel));
+        }
+    }
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> sizes(1, 97);
+    std::uniform_int_distribution<int> paddings(0, 33);
+    int worstFloat = 0;
+    for (int run = 0; run < 150; ++run) {
+        // Odd and even widths alike, including ones shorter than a vector.
+        const int width = sizes(rng);
+        const int height = 1 + sizes(rng) / 2;
+        const int padding = run % 3 == 0 ? 0 : paddings(rng);
+        for (YuvLayout layout : layouts) {
+            const Planes planes = randomImage(rng, width, height, layout, padding);
+            for (YuvMatrix matrix : matrices) {
+                for (YuvRange range : ranges) {
+                    const auto reference =
+                        convert(planes.image, matrix, range, YuvKernel::Scalar, 0, height);
+                    worstFloat =
+                        std::max(worstFloat, maxFloatError(planes.image, matrix, range, reference));
+                    for (YuvKernel kernel : simd) {
+                        if (kernel != YuvKernel::Auto && !yuvKernelAvailable(kernel)) {
+                            continue;
+                        }
+                        CF_CHECK(convert(planes.image, matrix, range, kernel, 0, height) ==
+                                 reference);
+                        // A stripe must match the same rows of the whole.
+                        const int y0 = height / 3, y1 = height - height / 4;
+                        const auto stripe = convert(planes.image, matrix, range, kernel, y0, y1);
+                        const std::size_t stride = static_cast<std::size_t>(width) * 4 + 12;
+                        CF_CHECK(std::equal(stripe.begin() + y0 * stride,
+                                            stripe.begin() + y1 * stride,
+                                            reference.begin() + y0 * stride));
+                    }
+                }
+            }
+        }
+    }
+    CF_CHECK(worstFloat <= 3);
+    return cineforge::test::finish("YuvConvertTest");
+}